@@ -0,0 +1,482 @@
+#include "adc_engine.h"
+
+#if defined(__AVR__)
+#include <avr/interrupt.h>
+#include <avr/io.h>
+#define ADC_ENGINE_AVR
+#elif defined(ARDUINO_ARCH_SAM)
+#define ADC_ENGINE_SAM
+#endif
+
+namespace AdcEngine {
+
+// Registered channels
+static uint8_t g_pins[MAX_CHANNELS];
+static uint8_t g_oversample[MAX_CHANNELS]; // Extra bits per slot (4^n samples per result)
+static SampleHook g_hooks[MAX_CHANNELS]; // Receives the slot's samples instead of the buffer (nullptr = buffered)
+static void* g_hook_contexts[MAX_CHANNELS];
+static uint8_t g_count = 0;
+static bool g_running = false;
+
+// Oversampling accumulators - owned by the ISR on AVR, by read() elsewhere
+static uint16_t g_acc[MAX_CHANNELS]; // Sum of up to 64 10-bit samples (fits in 16 bits)
+static uint8_t g_acc_count[MAX_CHANNELS];
+static uint16_t g_latest[MAX_CHANNELS]; // Last decimated result
+
+// Add one raw sample to a slot and return its latest decimated result
+static inline uint16_t accumulate(uint8_t slot, uint16_t sample)
+{
+    uint8_t bits = g_oversample[slot];
+    if (bits == 0) {
+        g_latest[slot] = sample;
+        return sample;
+    }
+
+    g_acc[slot] += sample;
+    if (++g_acc_count[slot] >= (uint8_t)(1 << (2 * bits))) {
+        // Decimate: sum of 4^n samples >> n = 10 + n bit result
+        g_latest[slot] = g_acc[slot] >> bits;
+        g_acc[slot] = 0;
+        g_acc_count[slot] = 0;
+    }
+    return g_latest[slot];
+}
+
+// Blocking conversions accumulated per read() of an oversampled slot where nothing
+// converts in the background: 4x updates every read, 16x every 4th, 64x every 16th
+static constexpr uint8_t BLOCKING_SAMPLES_PER_READ = 4;
+
+// Accumulate blocking conversions of a slot and return its latest result
+static uint16_t accumulateBlocking(uint8_t slot)
+{
+    uint8_t samples = (g_oversample[slot] == 0) ? 1 : BLOCKING_SAMPLES_PER_READ;
+    uint16_t value = 0;
+    for (uint8_t i = 0; i < samples; i++) {
+        value = accumulate(slot, (uint16_t)analogRead(g_pins[slot]));
+    }
+    return value;
+}
+
+// Seed a slot with a single conversion scaled to its resolution
+static void prime(uint8_t slot, uint16_t sample)
+{
+    g_latest[slot] = (uint16_t)(sample << g_oversample[slot]);
+    g_acc[slot] = 0;
+    g_acc_count[slot] = 0;
+}
+
+#if defined(ADC_ENGINE_AVR)
+
+// Double buffer: the ISR fills the back bank and flips g_front after a full round,
+// so readers always see a complete round and never a half-written 16-bit sample
+static volatile uint16_t g_samples[2][MAX_CHANNELS];
+static volatile uint8_t g_front = 0;
+static volatile uint8_t g_current = 0; // Slot being converted
+static uint8_t g_mux[MAX_CHANNELS]; // Hardware ADC channel per slot (bit 3 = MUX5)
+
+static_assert(sizeof(g_pins) + sizeof(g_oversample) + sizeof(g_hooks) + sizeof(g_hook_contexts)
+            + sizeof(g_count) + sizeof(g_running) + sizeof(g_acc) + sizeof(g_acc_count) + sizeof(g_latest)
+            + sizeof(g_samples) + sizeof(g_front) + sizeof(g_current) + sizeof(g_mux)
+        <= STATIC_RAM,
+    "AdcEngine::STATIC_RAM doesn't cover the engine's tables");
+
+// Map an Arduino analog pin (or channel number) to a hardware ADC channel
+// Mirrors the mapping done by analogRead() in the AVR core
+static uint8_t pinToAdcChannel(uint8_t pin)
+{
+#if defined(analogPinToChannel)
+#if defined(__AVR_ATmega32U4__)
+    if (pin >= 18) {
+        pin -= 18; // Allow for channel or pin numbers
+    }
+#endif
+    return analogPinToChannel(pin);
+#elif defined(__AVR_ATmega1280__) || defined(__AVR_ATmega2560__)
+    return (pin >= 54) ? (uint8_t)(pin - 54) : pin;
+#else
+    return (pin >= 14) ? (uint8_t)(pin - 14) : pin;
+#endif
+}
+
+// Point the ADC multiplexer at a hardware channel (AVcc reference, as analogReference(DEFAULT))
+static inline void selectAdcChannel(uint8_t channel)
+{
+#if defined(ADCSRB) && defined(MUX5)
+    ADCSRB = (ADCSRB & ~(1 << MUX5)) | (((channel >> 3) & 0x01) << MUX5);
+#endif
+    ADMUX = (1 << REFS0) | (channel & 0x07);
+}
+
+// Stop the conversion chain and drop any completed-but-unhandled result
+static void stopChain()
+{
+    ADCSRA &= ~(1 << ADIE);
+    while (ADCSRA & (1 << ADSC)) {
+        // Let an in-flight conversion finish
+    }
+    ADCSRA |= (1 << ADIF); // Writing 1 clears the flag
+}
+
+// Restart the conversion chain at the current slot
+static void startChain()
+{
+    ADCSRA |= (1 << ADIE);
+    selectAdcChannel(g_mux[g_current]);
+    ADCSRA |= (1 << ADSC);
+}
+
+} // namespace AdcEngine
+
+ISR(ADC_vect)
+{
+    using namespace AdcEngine;
+
+    uint8_t back = g_front ^ 1;
+    if (g_hooks[g_current] != nullptr) {
+        g_hooks[g_current](g_hook_contexts[g_current], ADC);
+    } else {
+        g_samples[back][g_current] = accumulate(g_current, ADC);
+    }
+
+    if (++g_current >= g_count) {
+        g_current = 0;
+        g_front = back; // Full round complete - publish it
+    }
+
+    // Chain the next conversion
+    selectAdcChannel(g_mux[g_current]);
+    ADCSRA |= (1 << ADSC);
+}
+
+namespace AdcEngine {
+
+void reset()
+{
+    if (g_running) {
+        stopChain();
+    }
+    g_running = false;
+    g_count = 0;
+    g_current = 0;
+}
+
+void start()
+{
+    if (g_running || g_count == 0) {
+        return;
+    }
+
+    // Prime both banks so readers never see an empty sample (hooked slots get theirs from the ISR)
+    for (uint8_t i = 0; i < g_count; i++) {
+        prime(i, (g_hooks[i] == nullptr) ? (uint16_t)analogRead(g_pins[i]) : 0);
+        g_samples[0][i] = g_latest[i];
+        g_samples[1][i] = g_latest[i];
+        g_mux[i] = pinToAdcChannel(g_pins[i]);
+    }
+    ADCSRA |= (1 << ADIF); // analogRead() leaves the flag set
+
+    g_current = 0;
+    g_running = true;
+    startChain();
+}
+
+uint16_t read(uint8_t slot)
+{
+    if (!g_running) {
+        return accumulateBlocking(slot);
+    }
+    return g_samples[g_front][slot];
+}
+
+uint16_t readNow(uint8_t pin)
+{
+    if (!g_running) {
+        return (uint16_t)analogRead(pin);
+    }
+
+    stopChain();
+    uint16_t value = (uint16_t)analogRead(pin);
+    ADCSRA |= (1 << ADIF); // Don't let the ISR pick up this result
+    startChain();
+
+    return value;
+}
+
+bool isBackground()
+{
+    return true;
+}
+
+#elif defined(ADC_ENGINE_SAM)
+
+// Hardware ADC channel per slot
+static uint32_t g_channels[MAX_CHANNELS];
+
+// Oversampled slots are fed through the PDC: it copies every conversion (tagged
+// with its channel) into one of two buffers, and the buffer-full interrupt sums
+// each channel's samples into its slots, so 4^n samples take 4^n conversions
+// rather than 4^n scans. Without oversampled slots there's no interrupt at all.
+static constexpr uint16_t PDC_SAMPLES = 128;
+static constexpr uint8_t HARDWARE_CHANNELS = 16;
+static uint16_t g_pdc_buffers[2][PDC_SAMPLES];
+static uint8_t g_pdc_filled = 0; // Buffer the PDC fills first (the other one is queued)
+static uint32_t g_pdc_sum[MAX_CHANNELS]; // 12-bit samples summed per slot since its last result
+static uint16_t g_pdc_count[MAX_CHANNELS];
+static bool g_pdc_running = false;
+static uint32_t g_saved_prescal = 0; // analogRead()'s ADC clock, restored when the PDC stops
+
+// ADC clock while the PDC runs: MCK / ((PRESCAL + 1) * 2) = 5.25 MHz, about 250k
+// conversions/s, so the interrupt takes a few percent of the CPU
+static constexpr uint32_t PDC_PRESCAL = 7;
+
+// Map an Arduino analog pin (or channel number) to a hardware ADC channel, as analogRead() does
+static uint32_t pinToAdcChannel(uint8_t pin)
+{
+    if (pin < A0) {
+        pin += A0;
+    }
+    return (uint32_t)g_APinDescription[pin].ulADCChannelNumber;
+}
+
+// Stream every conversion into the PDC buffers (only while a slot oversamples)
+static void startPdc()
+{
+    bool oversampled = false;
+    for (uint8_t i = 0; i < g_count; i++) {
+        oversampled = oversampled || g_oversample[i] != 0;
+        g_pdc_sum[i] = 0;
+        g_pdc_count[i] = 0;
+    }
+    if (!oversampled) {
+        return;
+    }
+
+    g_saved_prescal = ADC->ADC_MR & ADC_MR_PRESCAL_Msk;
+    ADC->ADC_MR = (ADC->ADC_MR & ~ADC_MR_PRESCAL_Msk) | ADC_MR_PRESCAL(PDC_PRESCAL);
+    ADC->ADC_EMR |= ADC_EMR_TAG; // Channel number in LCDR bits 12-15
+
+    g_pdc_filled = 0;
+    ADC->ADC_RPR = (uint32_t)g_pdc_buffers[0];
+    ADC->ADC_RCR = PDC_SAMPLES;
+    ADC->ADC_RNPR = (uint32_t)g_pdc_buffers[1];
+    ADC->ADC_RNCR = PDC_SAMPLES;
+    ADC->ADC_PTCR = ADC_PTCR_RXTEN;
+    ADC->ADC_IER = ADC_IER_ENDRX;
+    NVIC_EnableIRQ(ADC_IRQn);
+    g_pdc_running = true;
+}
+
+// Stop the PDC and give analogRead() its untagged results and clock back
+static void stopPdc()
+{
+    if (!g_pdc_running) {
+        return;
+    }
+
+    ADC->ADC_IDR = ADC_IDR_ENDRX;
+    NVIC_DisableIRQ(ADC_IRQn);
+    ADC->ADC_PTCR = ADC_PTCR_RXTDIS;
+    ADC->ADC_EMR &= ~ADC_EMR_TAG;
+    ADC->ADC_MR = (ADC->ADC_MR & ~ADC_MR_PRESCAL_Msk) | g_saved_prescal;
+    g_pdc_running = false;
+}
+
+// Enable our channels and let the ADC free-run over them
+static void startFreeRun()
+{
+    adc_disable_all_channel(ADC);
+    uint32_t converted = 0;
+    for (uint8_t i = 0; i < g_count; i++) {
+        adc_enable_channel(ADC, (adc_channel_num_t)g_channels[i]);
+        converted |= 1u << g_channels[i];
+    }
+    startPdc();
+    ADC->ADC_MR |= ADC_MR_FREERUN_ON;
+    adc_start(ADC);
+
+    // Wait for the first full sequence so every data register holds a sample
+    // (the EOC flags stay set until the channel's CDR is read)
+    while ((ADC->ADC_ISR & converted) != converted) {
+    }
+}
+
+static void stopFreeRun()
+{
+    ADC->ADC_MR &= ~ADC_MR_FREERUN_ON;
+    stopPdc();
+    adc_disable_all_channel(ADC);
+}
+
+} // namespace AdcEngine
+
+// A PDC buffer is full: sum it per channel into the oversampled slots, then
+// queue it again behind the one being filled now
+extern "C" void ADC_Handler()
+{
+    using namespace AdcEngine;
+
+    if ((ADC->ADC_ISR & ADC_ISR_ENDRX) == 0) {
+        return;
+    }
+
+    uint32_t sums[HARDWARE_CHANNELS] = { 0 };
+    uint16_t counts[HARDWARE_CHANNELS] = { 0 };
+    const uint16_t* samples = g_pdc_buffers[g_pdc_filled];
+    for (uint16_t i = 0; i < PDC_SAMPLES; i++) {
+        uint8_t channel = (uint8_t)((samples[i] & ADC_LCDR_CHNB_Msk) >> ADC_LCDR_CHNB_Pos);
+        sums[channel] += samples[i] & ADC_LCDR_LDATA_Msk;
+        counts[channel]++;
+    }
+
+    ADC->ADC_RNPR = (uint32_t)samples;
+    ADC->ADC_RNCR = PDC_SAMPLES; // Also clears ENDRX
+    g_pdc_filled ^= 1;
+
+    for (uint8_t slot = 0; slot < g_count; slot++) {
+        uint8_t bits = g_oversample[slot];
+        uint32_t channel = g_channels[slot];
+        if (bits == 0 || counts[channel] == 0) {
+            continue;
+        }
+
+        // Once 4^n samples (or a few more) are in, decimate: their mean scaled
+        // from 12 bits to 10 + n, as a sum of 4^n 10-bit samples >> n would be
+        g_pdc_sum[slot] += sums[channel];
+        g_pdc_count[slot] = (uint16_t)(g_pdc_count[slot] + counts[channel]);
+        if (g_pdc_count[slot] >= (uint16_t)(1 << (2 * bits))) {
+            g_latest[slot] = (uint16_t)((g_pdc_sum[slot] << bits) / ((uint32_t)g_pdc_count[slot] << 2));
+            g_pdc_sum[slot] = 0;
+            g_pdc_count[slot] = 0;
+        }
+    }
+}
+
+namespace AdcEngine {
+
+void reset()
+{
+    if (g_running) {
+        stopFreeRun();
+    }
+    g_running = false;
+    g_count = 0;
+}
+
+void start()
+{
+    if (g_running || g_count == 0) {
+        return;
+    }
+
+    for (uint8_t i = 0; i < g_count; i++) {
+        g_channels[i] = pinToAdcChannel(g_pins[i]);
+        prime(i, (uint16_t)analogRead(g_pins[i]));
+    }
+
+    startFreeRun();
+    g_running = true;
+}
+
+uint16_t read(uint8_t slot)
+{
+    if (!g_running) {
+        return accumulateBlocking(slot);
+    }
+    if (g_oversample[slot] != 0) {
+        return g_latest[slot]; // Decimated by the PDC interrupt (a 16-bit store)
+    }
+    // 12-bit hardware result scaled to the 10-bit analogRead() default
+    return (uint16_t)((ADC->ADC_CDR[g_channels[slot]] & 0x0FFF) >> 2);
+}
+
+uint16_t readNow(uint8_t pin)
+{
+    if (!g_running) {
+        return (uint16_t)analogRead(pin);
+    }
+
+    // analogRead() converts every enabled channel, so give it the ADC to itself
+    stopFreeRun();
+    uint16_t value = (uint16_t)analogRead(pin);
+    startFreeRun();
+
+    return value;
+}
+
+bool isBackground()
+{
+    return true;
+}
+
+#else
+
+void reset()
+{
+    g_running = false;
+    g_count = 0;
+}
+
+void start()
+{
+    // No background conversions - read() samples synchronously
+    for (uint8_t i = 0; i < g_count; i++) {
+        prime(i, (uint16_t)analogRead(g_pins[i]));
+    }
+}
+
+uint16_t read(uint8_t slot)
+{
+    return accumulateBlocking(slot);
+}
+
+uint16_t readNow(uint8_t pin)
+{
+    return (uint16_t)analogRead(pin);
+}
+
+bool isBackground()
+{
+    return false;
+}
+
+#endif
+
+// Take the next free slot (channels can't be added while the engine runs)
+static uint8_t claimSlot(uint8_t pin, uint8_t oversample_bits, SampleHook hook, void* context)
+{
+    if (g_running || g_count >= MAX_CHANNELS) {
+        return NO_SLOT;
+    }
+
+    g_pins[g_count] = pin;
+    g_oversample[g_count] = oversample_bits;
+    g_hooks[g_count] = hook;
+    g_hook_contexts[g_count] = context;
+    prime(g_count, 0);
+    return g_count++;
+}
+
+uint8_t addChannel(uint8_t pin, uint8_t oversample_bits)
+{
+    for (uint8_t i = 0; i < g_count; i++) {
+        if (g_pins[i] == pin && g_oversample[i] == oversample_bits && g_hooks[i] == nullptr) {
+            return i;
+        }
+    }
+    return claimSlot(pin, oversample_bits, nullptr, nullptr);
+}
+
+uint8_t addHookedChannel(uint8_t pin, SampleHook hook, void* context)
+{
+#if defined(ADC_ENGINE_AVR)
+    return claimSlot(pin, 0, hook, context);
+#else
+    // Samples are taken in read(), not between conversions - nothing to hook into
+    (void)pin;
+    (void)hook;
+    (void)context;
+    return NO_SLOT;
+#endif
+}
+
+} // namespace AdcEngine
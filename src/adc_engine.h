@@ -0,0 +1,75 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+
+// Background ADC engine
+// Converts all registered analog channels round-robin in the background and
+// publishes the latest sample of each, so sensors read a cached value instead
+// of blocking in analogRead() (~112us per read on AVR).
+//
+// - AVR: single conversions chained from the ADC-complete ISR, published into a
+//   double buffer that flips after each full round
+// - Due (SAM3X): hardware free-run mode over the enabled channels; the per-channel
+//   data registers (ADC_CDR) hold the latest sample, and oversampled slots are
+//   accumulated from a PDC stream of every conversion
+// - Other platforms (ESP32, native tests): no background conversions, read() falls
+//   back to blocking analogRead() calls (4 per read for an oversampled slot)
+namespace AdcEngine {
+
+// Maximum number of channels converted in the background
+// AVR boards with fewer analog pins get a slot per pin (a sensor that finds no
+// slot free falls back to blocking reads)
+#if defined(__AVR__) && defined(NUM_ANALOG_INPUTS) && NUM_ANALOG_INPUTS < 16
+constexpr uint8_t MAX_CHANNELS = NUM_ANALOG_INPUTS;
+#else
+constexpr uint8_t MAX_CHANNELS = 16;
+#endif
+
+#if defined(__AVR__)
+// SRAM taken by the engine's slot tables and state (16 bytes per slot), for the
+// build-time SRAM check in main.cpp
+constexpr size_t STATIC_RAM = MAX_CHANNELS * 16 + 4;
+#endif
+
+// Returned by addChannel() when no slot is available
+constexpr uint8_t NO_SLOT = 0xFF;
+
+// Stop background conversions and forget all channels
+void reset();
+
+// Register an analog pin for background conversion
+// With oversample_bits = n, each result is the sum of 4^n conversions shifted right by n
+// (10 + n bits). On AVR and Due the samples are accumulated in the background; elsewhere
+// read() takes 4 blocking samples, so results update every 4^(n-1) scans.
+// Returns its slot (registering the same pin and factor again returns the same slot), or NO_SLOT if full
+uint8_t addChannel(uint8_t pin, uint8_t oversample_bits = 0);
+
+// Called from the conversion-complete interrupt with each raw sample of a hooked slot
+typedef void (*SampleHook)(void* context, uint16_t sample);
+
+// Approximate time of one conversion at the AVR core's 125 kHz ADC clock (13 cycles)
+constexpr uint16_t CONVERSION_US = 104;
+
+// Register an analog pin whose samples go to hook instead of the buffer
+// The hook runs between conversions, so it can e.g. move an external multiplexer on
+// to its next channel without stopping the engine. Slots are converted in turn, so
+// the pin's next conversion starts no earlier than when the hook returns.
+// Returns NO_SLOT if no slot is free or conversions aren't interrupt-driven (AVR only)
+uint8_t addHookedChannel(uint8_t pin, SampleHook hook, void* context);
+
+// Start background conversions over the registered channels
+// Every slot holds a valid sample when this returns
+void start();
+
+// Get the latest sample for a slot (0-1023, or 0-(2^(10+n)-1) when oversampling)
+uint16_t read(uint8_t slot);
+
+// Blocking conversion of any pin, safe while background conversions are running
+// (pauses the engine for the duration of the read)
+uint16_t readNow(uint8_t pin);
+
+// True if samples are converted in the background on this platform
+bool isBackground();
+
+} // namespace AdcEngine
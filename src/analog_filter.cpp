@@ -0,0 +1,75 @@
+#include "analog_filter.h"
+
+namespace Sensor {
+
+AnalogFilter::AnalogFilter(uint8_t filter_type, uint8_t alpha_q8, uint8_t beta_value)
+    : type(filter_type)
+    , alpha(alpha_q8)
+    , beta(beta_value)
+    , primed(false)
+    , stage1(0)
+    , stage2(0)
+{
+    // A zero coefficient would freeze the output - treat it as "no filter"
+    if (alpha == 0) {
+        type = NONE;
+    }
+}
+
+void AnalogFilter::reset()
+{
+    primed = false;
+}
+
+uint16_t AnalogFilter::apply(uint16_t sample)
+{
+    if (type == NONE) {
+        return sample;
+    }
+
+    int32_t input = (int32_t)sample << 8;
+
+    // Seed the state with the first sample so the output doesn't ramp up from zero
+    if (!primed) {
+        stage1 = input;
+        stage2 = (type == ONE_EURO) ? 0 : input;
+        primed = true;
+        return sample;
+    }
+
+    if (type == ONE_EURO) {
+        // Smoothed absolute speed (Q8 counts per scan) against the previous output
+        int32_t speed = input - stage1;
+        if (speed < 0) {
+            speed = -speed;
+        }
+        stage2 = step(stage2, speed, SPEED_ALPHA);
+
+        // Quiet at rest (minimum alpha), follows fast throws (alpha -> 1)
+        stage1 = step(stage1, input, adaptiveAlpha());
+        return (uint16_t)((stage1 + 128) >> 8);
+    }
+
+    stage1 = step(stage1, input, alpha);
+    int32_t output = stage1;
+
+    if (type == EMA2) {
+        stage2 = step(stage2, stage1, alpha);
+        output = stage2;
+    }
+
+    // Round back to the input scale
+    return (uint16_t)((output + 128) >> 8);
+}
+
+uint16_t AnalogFilter::adaptiveAlpha() const
+{
+    // The One-Euro cutoff is min_cutoff + beta * speed; for small coefficients alpha is
+    // proportional to the cutoff, so the same linear law is applied to alpha directly.
+    // stage2 is Q8, beta is in 1/16 alpha steps: (beta * speed_q8) >> 12
+    uint32_t boost = ((uint32_t)beta * (uint32_t)stage2) >> 12;
+    uint32_t adaptive = (uint32_t)alpha + boost;
+    return (adaptive > 256) ? 256 : (uint16_t)adaptive;
+}
+
+} // namespace Sensor
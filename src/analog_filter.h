@@ -0,0 +1,48 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace Sensor {
+
+// Fixed-point smoothing filter for a single analog value
+// All math is integer (Q8 coefficients and state), so it is cheap on AVR.
+class AnalogFilter {
+public:
+    // Filter types (matches protocol ANALOG_FILTER_* constants)
+    static constexpr uint8_t NONE = 0;
+    static constexpr uint8_t EMA = 1; // First-order EMA: y += alpha * (x - y)
+    static constexpr uint8_t EMA2 = 2; // Second-order IIR: two cascaded EMA stages (critically damped)
+    static constexpr uint8_t ONE_EURO = 3; // EMA whose alpha rises with speed (One-Euro filter)
+
+    // One-Euro: smoothing coefficient of the speed estimate (Q8)
+    static constexpr uint8_t SPEED_ALPHA = 64;
+
+private:
+    uint8_t type;
+    uint8_t alpha; // Q8 coefficient (1-255 = 1/256 .. 255/256 of the error per sample); minimum alpha for ONE_EURO
+    uint8_t beta; // ONE_EURO: alpha increase per count/scan of speed, in 1/16 Q8 steps
+    bool primed; // False until the first sample seeds the state
+    int32_t stage1; // Q8 state (value * 256)
+    int32_t stage2; // Q8 state of the second stage (EMA2), or smoothed speed (ONE_EURO)
+
+public:
+    AnalogFilter(uint8_t filter_type = NONE, uint8_t alpha_q8 = 0, uint8_t beta_value = 0);
+
+    // Forget the filter state (next sample seeds it)
+    void reset();
+
+    // Filter one sample and return the filtered value
+    uint16_t apply(uint16_t sample);
+
+private:
+    // One EMA step on a Q8 state (alpha in Q8, up to 256 = follow the input)
+    static int32_t step(int32_t state, int32_t input_q8, uint16_t alpha_q8)
+    {
+        return state + (((input_q8 - state) * (int32_t)alpha_q8) >> 8);
+    }
+
+    // One-Euro coefficient for the current smoothed speed
+    uint16_t adaptiveAlpha() const;
+};
+
+} // namespace Sensor
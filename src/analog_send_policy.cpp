@@ -0,0 +1,95 @@
+#include "analog_send_policy.h"
+
+namespace Sensor {
+
+AnalogSendPolicy::AnalogSendPolicy(uint8_t sensitivity_level)
+    : current_value(0)
+    , last_sent(0)
+    , now_us(0)
+    , last_send_us(0)
+    , min_interval_us(computeMinInterval(sensitivity_level))
+    , keepalive_us(KEEPALIVE_US)
+    , dead_zone(DEAD_ZONE)
+    , hysteresis(0)
+    , last_direction(0)
+{
+}
+
+void AnalogSendPolicy::setSensitivity(uint8_t sensitivity_level)
+{
+    min_interval_us = computeMinInterval(sensitivity_level);
+}
+
+void AnalogSendPolicy::setIntervals(uint16_t min_interval_ms, uint16_t keepalive_ms)
+{
+    if (min_interval_ms != 0) {
+        min_interval_us = (uint32_t)min_interval_ms * 1000;
+    }
+    keepalive_us = (keepalive_ms != 0) ? (uint32_t)keepalive_ms * 1000 : KEEPALIVE_US;
+}
+
+void AnalogSendPolicy::reset(uint32_t timestamp_us)
+{
+    current_value = 0;
+    last_sent = 0;
+    now_us = timestamp_us;
+    last_send_us = timestamp_us;
+    last_direction = 0;
+}
+
+void AnalogSendPolicy::update(uint16_t value, uint32_t timestamp_us)
+{
+    current_value = value;
+    now_us = timestamp_us;
+}
+
+uint16_t AnalogSendPolicy::markSent()
+{
+    // Forced sends without movement keep the previous direction
+    if (current_value != last_sent) {
+        last_direction = (current_value > last_sent) ? 1 : -1;
+    }
+    last_sent = current_value;
+    last_send_us = now_us;
+    return current_value;
+}
+
+uint32_t AnalogSendPolicy::computeMinInterval(uint8_t sensitivity_level)
+{
+    // Sensitivity 0-10 maps to send interval
+    // Higher sensitivity = lower interval = send more frequently
+    // sensitivity 10: 10ms minimum
+    // sensitivity 5:  60ms minimum
+    // sensitivity 0:  110ms minimum
+    return (uint32_t)(11 - sensitivity_level) * SENSITIVITY_STEP_US;
+}
+
+bool AnalogSendPolicy::shouldSend() const
+{
+    // Unsigned difference stays correct across the micros() wrap (~71 minutes)
+    uint32_t elapsed_us = now_us - last_send_us;
+
+    // Simple algorithm:
+    // 1. Force send every keepalive interval (~2 seconds) to ensure we don't go silent
+    if (elapsed_us >= keepalive_us) {
+        return true;
+    }
+
+    // 2. Rate limit: don't send faster than min_interval_us
+    if (elapsed_us < min_interval_us) {
+        return false;
+    }
+
+    // 3. Send if value changed beyond dead zone (filters analog noise/jitter)
+    //    Turning back needs the hysteresis band on top, so a value resting on
+    //    a boundary can't flip-flop between two reported levels
+    bool up = current_value > last_sent;
+    uint16_t delta = up ? (current_value - last_sent) : (last_sent - current_value);
+    uint16_t threshold = dead_zone;
+    if (last_direction != 0 && (up ? 1 : -1) != last_direction) {
+        threshold += hysteresis;
+    }
+    return delta > threshold;
+}
+
+} // namespace Sensor
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace Sensor {
+
+// Send policy for a single analog value
+// Reports based on sensitivity, change threshold, and time-based forcing.
+// Intervals are measured in microseconds (not scans), so reporting rates
+// don't change with the loop rate.
+// Shared by AnalogSensor and every channel of MuxAnalogSensor.
+class AnalogSendPolicy {
+public:
+    // Algorithm constants
+    static constexpr uint32_t KEEPALIVE_US = 2000000; // Default: force send after 2s even if no change
+    static constexpr uint32_t SENSITIVITY_STEP_US = 10000; // Minimum interval per sensitivity step below 10
+    static constexpr uint16_t DEAD_ZONE = 2; // Default: ignore changes up to this (filters analog noise/jitter)
+
+private:
+    uint16_t current_value; // Current value
+    uint16_t last_sent; // Last sent value
+    uint32_t now_us; // Timestamp of the current value
+    uint32_t last_send_us; // Timestamp of the last send (or of the reset)
+    uint32_t min_interval_us; // Minimum time between sends
+    uint32_t keepalive_us; // Force a send after this long without one
+    uint8_t dead_zone; // Changes up to this are ignored (DEAD_ZONE unless calibrated)
+    uint8_t hysteresis; // Extra counts needed to reverse direction (0 = symmetric dead zone)
+    int8_t last_direction; // Direction of the last sent change (+1 up, -1 down, 0 none yet)
+
+public:
+    explicit AnalogSendPolicy(uint8_t sensitivity_level = 0);
+
+    // Set sensitivity level (0-10, where 10 = most sensitive/sends most frequently)
+    void setSensitivity(uint8_t sensitivity_level);
+
+    // Override the intervals in milliseconds (0 = keep the sensitivity / default value)
+    void setIntervals(uint16_t min_interval_ms, uint16_t keepalive_ms);
+
+    // Set the dead zone (0 = default DEAD_ZONE)
+    void setDeadZone(uint8_t zone) { dead_zone = (zone != 0) ? zone : (uint8_t)DEAD_ZONE; }
+
+    // Set the hysteresis band (0 = off)
+    // A change that reverses the last sent direction must beat dead_zone + band
+    void setHysteresis(uint8_t band) { hysteresis = band; }
+
+    // Reset reporting state - intervals count from timestamp_us (micros())
+    void reset(uint32_t timestamp_us);
+
+    // Record this scan's value and when it was sampled (micros())
+    void update(uint16_t value, uint32_t timestamp_us);
+
+    // Check if we should send a value (simple rate limiting + periodic updates)
+    bool shouldSend() const;
+
+    // Mark the current value as sent and return it
+    uint16_t markSent();
+
+    // Get the current value
+    uint16_t getValue() const { return current_value; }
+
+    // Compute minimum send interval from sensitivity (also used by other rate-limited inputs)
+    static uint32_t computeMinInterval(uint8_t sensitivity_level);
+};
+
+} // namespace Sensor
@@ -1,15 +1,21 @@
 #include "analog_sensor.h"
+#include "adc_engine.h"
 
 namespace Sensor {
 
-AnalogSensor::AnalogSensor(uint8_t pin_number, uint8_t sensitivity_level)
+AnalogSensor::AnalogSensor(uint8_t pin_number, uint8_t sensitivity_level, const AnalogOptions& options)
     : pin(pin_number)
     , sensitivity(sensitivity_level)
-    , current_value(0)
-    , last_sent(0)
-    , scans_since_send(0)
-    , min_send_interval(computeMinSendInterval())
+    , oversample(options.oversample)
+    , adc_slot(AdcEngine::NO_SLOT)
+    , median(options.median)
+    , filter(options.filter, options.filter_alpha, options.filter_beta)
+    , policy(sensitivity_level)
+    , calibrating(false)
 {
+    policy.setDeadZone(options.dead_zone);
+    policy.setHysteresis(options.hysteresis);
+    policy.setIntervals(options.min_interval_ms, options.keepalive_ms);
 }
 
 void AnalogSensor::begin()
@@ -18,64 +24,63 @@ void AnalogSensor::begin()
     // Calling pinMode(channel, INPUT) with a channel number (0, 1, etc.) would
     // incorrectly configure the wrong digital pin (e.g., RX/TX on Nano).
 
+    // Register for background conversion
+    attachAdc();
+
     // Reset state
-    current_value = 0;
-    last_sent = 0;
-    scans_since_send = 0;
+    median.reset();
+    filter.reset();
+    policy.reset(micros());
+}
+
+void AnalogSensor::attachAdc()
+{
+    adc_slot = AdcEngine::addChannel(pin, oversample);
 }
 
 void AnalogSensor::scan()
 {
-    // Read raw analog value (0-1023)
-    current_value = (uint16_t)analogRead(pin);
+    // Latest analog value - blocking read only if the engine had no free slot
+    // (scaled to the configured resolution, without the extra precision)
+    uint16_t value = (adc_slot != AdcEngine::NO_SLOT)
+        ? AdcEngine::read(adc_slot)
+        : (uint16_t)(AdcEngine::readNow(pin) << oversample);
+    value = filter.apply(median.apply(value));
+    policy.update(value, micros());
+    if (policy.shouldSend()) {
+        markReady();
+    }
 
-    // Increment scan counter
-    scans_since_send++;
+    if (calibrating) {
+        noise.samples++;
+        noise.min_value = (value < noise.min_value) ? value : noise.min_value;
+        noise.max_value = (value > noise.max_value) ? value : noise.max_value;
+    }
 }
 
 Reading AnalogSensor::getReading()
 {
     // Check if we should send
-    if (!shouldSend()) {
+    if (!policy.shouldSend()) {
         return Reading(); // Not ready to send yet
     }
 
-    // Send the current raw value
-    int16_t value = (int16_t)current_value;
-
-    // Update state
-    last_sent = current_value;
-    scans_since_send = 0;
+    // Send the value after the median, filter and send policy stages
+    int16_t value = (int16_t)policy.markSent();
 
     return Reading(value, InputType::Analog, pin);
 }
 
-uint16_t AnalogSensor::computeMinSendInterval() const
+void AnalogSensor::startNoiseCalibration()
 {
-    // Sensitivity 0-10 maps to send interval
-    // Higher sensitivity = lower interval = send more frequently
-    // sensitivity 10: 1 scan (~10ms minimum)
-    // sensitivity 5:  6 scans (~60ms minimum)
-    // sensitivity 0:  11 scans (~110ms minimum)
-    return (uint16_t)(11 - sensitivity);
+    noise = NoiseStats();
+    calibrating = true;
 }
 
-bool AnalogSensor::shouldSend()
+const NoiseStats& AnalogSensor::stopNoiseCalibration()
 {
-    // Simple algorithm:
-    // 1. Force send every MAX_SEND_INTERVAL scans (~2 seconds) to ensure we don't go silent
-    if (scans_since_send >= MAX_SEND_INTERVAL) {
-        return true;
-    }
-
-    // 2. Rate limit: don't send faster than min_send_interval
-    if (scans_since_send < min_send_interval) {
-        return false;
-    }
-
-    // 3. Send if value changed beyond dead zone (filters analog noise/jitter)
-    uint16_t delta = (current_value > last_sent) ? (current_value - last_sent) : (last_sent - current_value);
-    return delta > DEAD_ZONE;
+    calibrating = false;
+    return noise;
 }
 
 } // namespace Sensor
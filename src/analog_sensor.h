@@ -1,44 +1,104 @@
 #pragma once
 
+#include "analog_filter.h"
+#include "analog_send_policy.h"
+#include "median_filter.h"
 #include "sensor.h"
 #include <Arduino.h>
 
 namespace Sensor {
 
+// Optional per-input analog processing (all zero = plain 10-bit reads, default send policy)
+struct AnalogOptions {
+    uint8_t oversample; // Extra bits from oversampling (0 = plain 10-bit reads)
+    uint8_t filter; // AnalogFilter type
+    uint8_t filter_alpha; // Filter coefficient in Q8
+    uint8_t filter_beta; // One-Euro speed gain
+    uint8_t median; // Median prefilter window (0, 3 or 5)
+    uint8_t dead_zone; // Send policy dead zone (0 = AnalogSendPolicy::DEAD_ZONE)
+    uint8_t hysteresis; // Send policy direction reversal band (0 = off)
+    uint16_t min_interval_ms; // Minimum time between sends (0 = from sensitivity)
+    uint16_t keepalive_ms; // Forced send interval (0 = AnalogSendPolicy::KEEPALIVE_US)
+
+    AnalogOptions()
+        : oversample(0)
+        , filter(AnalogFilter::NONE)
+        , filter_alpha(0)
+        , filter_beta(0)
+        , median(0)
+        , dead_zone(0)
+        , hysteresis(0)
+        , min_interval_ms(0)
+        , keepalive_ms(0)
+    {
+    }
+};
+
+// Noise measured on an input's processed value during calibration
+struct NoiseStats {
+    uint16_t samples; // Scans measured
+    uint16_t min_value;
+    uint16_t max_value;
+
+    NoiseStats()
+        : samples(0)
+        , min_value(0xFFFF)
+        , max_value(0)
+    {
+    }
+
+    // Smallest dead zone that noise alone can't cross (peak-to-peak, at least 1)
+    uint8_t deadZone() const
+    {
+        if (samples == 0) {
+            return 0;
+        }
+        uint16_t spread = max_value - min_value;
+        return (spread == 0) ? 1 : (spread > 255) ? 255 : (uint8_t)spread;
+    }
+};
+
 // Analog sensor implementation
-// Uses EMA (Exponential Moving Average) for smoothing
-// Reports based on sensitivity, change threshold, and time-based forcing
-class AnalogSensor : public ISensor {
+// Samples come from the background ADC engine (see AdcEngine)
+// Optional median-of-3/5 spike rejection (see MedianFilter), then fixed-point
+// EMA / second-order IIR / One-Euro smoothing (see AnalogFilter)
+// Reports based on sensitivity, change threshold, and time-based forcing (see AnalogSendPolicy),
+// timestamped with micros() once per scan
+class AnalogSensor final : public ISensor {
 private:
     uint8_t pin; // Arduino pin number
     uint8_t sensitivity; // Sensitivity level (0-10, where 10 = most sensitive/sends most frequently)
+    uint8_t oversample; // Extra bits from oversampling (0 = plain 10-bit reads)
+    uint8_t adc_slot; // Background ADC engine slot (AdcEngine::NO_SLOT if not registered)
 
     // State
-    uint16_t current_value; // Current raw analog value (0-1023)
-    uint16_t last_sent; // Last sent value
-    uint16_t scans_since_send; // Number of scans since last send
-    uint16_t min_send_interval; // Minimum scans between sends (computed from sensitivity)
+    MedianFilter median; // Spike rejection applied before smoothing
+    AnalogFilter filter; // Smoothing applied before the send policy
+    AnalogSendPolicy policy; // Current analog value (0-1023, wider when oversampling) and reporting state
 
-    // Algorithm constants
-    static constexpr uint16_t MAX_SEND_INTERVAL = 200; // Maximum 200 scans (~2s) - force send even if no change
-    static constexpr uint16_t DEAD_ZONE = 2; // Ignore changes smaller than this (filters analog noise/jitter)
+    // Noise calibration
+    bool calibrating;
+    NoiseStats noise;
 
 public:
-    AnalogSensor(uint8_t pin_number, uint8_t sensitivity_level);
+    AnalogSensor(uint8_t pin_number, uint8_t sensitivity_level, const AnalogOptions& options = AnalogOptions());
 
     // ISensor interface implementation
     void begin() override;
+    void attachAdc() override;
     void scan() override;
     Reading getReading() override;
     InputType getType() const override { return InputType::Analog; }
     uint8_t getPin() const override { return pin; }
 
-private:
-    // Check if we should send a value (simple rate limiting + periodic updates)
-    bool shouldSend();
+    // Start measuring the noise floor (stats accumulate every scan until stopped)
+    void startNoiseCalibration();
+
+    // Stop measuring and return the stats
+    const NoiseStats& stopNoiseCalibration();
 
-    // Compute minimum send interval from sensitivity
-    uint16_t computeMinSendInterval() const;
+    // Change the dead zone (0 = default)
+    void setDeadZone(uint8_t zone) { policy.setDeadZone(zone); }
 };
 
 } // namespace Sensor
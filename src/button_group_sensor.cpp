@@ -0,0 +1,103 @@
+#include "button_group_sensor.h"
+#include <string.h>
+
+// AVR, SAM and ESP32 cores all map a pin to a port input register and bit mask
+#if defined(portInputRegister) && defined(digitalPinToPort) && defined(digitalPinToBitMask)
+#define BUTTON_GROUP_PORT_READ
+#endif
+
+namespace Sensor {
+
+ButtonGroupSensor::ButtonGroupSensor(uint8_t pin_count, const uint8_t* pin_array, uint8_t debounce_scans)
+    : num_pins(pin_count < MAX_PINS ? pin_count : MAX_PINS)
+    , num_ports(0)
+    , next_byte(0)
+{
+    for (uint8_t i = 0; i < num_pins; i++) {
+        pins[i] = pin_array[i];
+    }
+    for (uint8_t b = 0; b < MAX_BYTES; b++) {
+        debouncers[b].setSamples(debounce_scans);
+    }
+    memset(pin_port, 0, sizeof(pin_port));
+    memset(pin_mask, 0, sizeof(pin_mask));
+    memset(pending, 0, sizeof(pending));
+}
+
+void ButtonGroupSensor::begin()
+{
+    num_ports = 0;
+    for (uint8_t i = 0; i < num_pins; i++) {
+        // Buttons connect the pin to GND when pressed (active LOW)
+        pinMode(pins[i], INPUT_PULLUP);
+
+#if defined(BUTTON_GROUP_PORT_READ)
+        // Group pins by port so each register is read once per scan
+        const volatile PortBits* reg = (const volatile PortBits*)portInputRegister(digitalPinToPort(pins[i]));
+        uint8_t port = 0;
+        while (port < num_ports && port_regs[port] != reg) {
+            port++;
+        }
+        if (port == num_ports) {
+            port_regs[num_ports++] = reg;
+        }
+        pin_port[i] = port;
+        pin_mask[i] = (PortBits)digitalPinToBitMask(pins[i]);
+#endif
+    }
+
+    // Reset state
+    for (uint8_t b = 0; b < MAX_BYTES; b++) {
+        debouncers[b].reset();
+    }
+    memset(pending, 0, sizeof(pending));
+    next_byte = 0;
+}
+
+void ButtonGroupSensor::scan()
+{
+    uint8_t samples[MAX_BYTES];
+    memset(samples, 0, sizeof(samples));
+
+#if defined(BUTTON_GROUP_PORT_READ)
+    // One read per port, then pick each pin's bit out of its port's snapshot
+    PortBits levels[MAX_PINS];
+    for (uint8_t port = 0; port < num_ports; port++) {
+        levels[port] = *port_regs[port];
+    }
+    for (uint8_t i = 0; i < num_pins; i++) {
+        if ((levels[pin_port[i]] & pin_mask[i]) == 0) { // Active LOW
+            samples[i / 8] |= (uint8_t)(1 << (i % 8));
+        }
+    }
+#else
+    for (uint8_t i = 0; i < num_pins; i++) {
+        if (digitalRead(pins[i]) == LOW) {
+            samples[i / 8] |= (uint8_t)(1 << (i % 8));
+        }
+    }
+#endif
+
+    for (uint8_t b = 0; b < numBytes(); b++) {
+        pending[b] |= debouncers[b].update(samples[b]);
+        if (pending[b] != 0) {
+            markReady();
+        }
+    }
+}
+
+Reading ButtonGroupSensor::getReading()
+{
+    uint8_t index;
+    if (!takePendingBit(pending, numBytes(), next_byte, index)) {
+        return Reading(); // No events to report
+    }
+
+    // value = 1 for press, 0 for release
+    uint8_t mask = (uint8_t)(1 << (index % 8));
+    int16_t value = (debouncers[index / 8].getState() & mask) ? 1 : 0;
+
+    return Reading(value, InputType::Button, pins[index]);
+}
+
+} // namespace Sensor
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "protocol.h"
+#include "sensor.h"
+#include "vertical_debounce.h"
+#include <Arduino.h>
+
+namespace Sensor {
+
+// Grouped button sensor implementation
+// Replaces a set of ButtonSensors with one sensor: each GPIO port involved is
+// read once per scan (the pins are gathered from the port snapshots), and all
+// pins are debounced together with bit-parallel vertical counters (debounce
+// scans, 3 by default and at most 7).
+// Pins are active LOW with pullups, like ButtonSensor, and each one is reported
+// individually as a Button input on its own pin. Cores without port registers
+// fall back to one digitalRead per pin.
+class ButtonGroupSensor : public ISensor {
+public:
+    // Maximum pins per group (to avoid dynamic allocation)
+    static constexpr uint8_t MAX_PINS = Protocol::MAX_BUTTON_GROUP_PINS;
+    static constexpr uint8_t MAX_BYTES = (MAX_PINS + 7) / 8;
+
+    // Width of a port input register
+#if defined(__AVR__)
+    typedef uint8_t PortBits;
+#else
+    typedef uint32_t PortBits;
+#endif
+
+private:
+    uint8_t num_pins;
+    uint8_t pins[MAX_PINS];
+
+    // Distinct port input registers, and where each pin lives in them
+    uint8_t num_ports;
+    const volatile PortBits* port_regs[MAX_PINS];
+    uint8_t pin_port[MAX_PINS]; // Index into port_regs
+    PortBits pin_mask[MAX_PINS]; // Pin's bit in its port
+
+    // Pin i is bit (i % 8) of byte (i / 8)
+    VerticalDebouncer debouncers[MAX_BYTES];
+    uint8_t pending[MAX_BYTES]; // Bits with an unreported debounced change
+    uint8_t next_byte; // Byte to resume reporting from (round-robin)
+
+public:
+    ButtonGroupSensor(uint8_t pin_count, const uint8_t* pin_array, uint8_t debounce_scans = 0);
+
+    // ISensor interface implementation
+    void begin() override;
+    void scan() override;
+    Reading getReading() override;
+    InputType getType() const override { return InputType::ButtonGroup; }
+    uint8_t getPin() const override { return pins[0]; }
+
+    // Number of port registers read per scan
+    uint8_t getPortCount() const { return num_ports; }
+
+private:
+    uint8_t numBytes() const { return (uint8_t)((num_pins + 7) / 8); }
+};
+
+} // namespace Sensor
@@ -1,20 +1,101 @@
 #include "button_sensor.h"
+#include "pin_change.h"
+
+#if defined(ESP32_PLATFORM)
+#define BUTTON_ISR_ATTR IRAM_ATTR
+#else
+#define BUTTON_ISR_ATTR
+#endif
 
 namespace Sensor {
 
-ButtonSensor::ButtonSensor(uint8_t pin_number, uint8_t debounce_scans)
+// attachInterrupt() takes a plain function, so each slot gets its own trampoline
+static ButtonSensor* volatile g_isr_buttons[ButtonSensor::MAX_INTERRUPT_BUTTONS];
+
+template <uint8_t N>
+static void BUTTON_ISR_ATTR buttonIsr()
+{
+    ButtonSensor* button = g_isr_buttons[N];
+    if (button != nullptr) {
+        button->capture();
+    }
+}
+
+static void (*const BUTTON_ISR_TRAMPOLINES[ButtonSensor::MAX_INTERRUPT_BUTTONS])() = {
+    buttonIsr<0>, buttonIsr<1>, buttonIsr<2>, buttonIsr<3>
+};
+
+// A pin-change vector serves a whole port; capture() ignores buttons whose level didn't change
+static void capturePinChange(void* context)
+{
+    static_cast<ButtonSensor*>(context)->capture();
+}
+
+ButtonSensor::ButtonSensor(uint8_t pin_number, uint8_t debounce_scans, bool eager_debounce, bool interrupt_capture)
     : pin(pin_number)
     , debounce_threshold(debounce_scans)
+    , eager(eager_debounce)
+    , use_interrupt(interrupt_capture)
+    , isr_slot(NO_SLOT)
+    , via_pcint(false)
     , current_state(false)
     , last_reported(false)
     , raw_state(false)
     , debounce_count(0)
     , has_pending_event(false)
+    , isr_state(false)
+    , isr_edge_us(0)
+    , edge_head(0)
+    , edge_tail(0)
+    , lockout_us((uint32_t)debounce_scans * DEBOUNCE_STEP_US)
 {
 }
 
+ButtonSensor::~ButtonSensor()
+{
+    release();
+}
+
+void ButtonSensor::release()
+{
+    if (via_pcint) {
+        PinChange::detach(this);
+        via_pcint = false;
+    }
+
+    if (isr_slot == NO_SLOT) {
+        return;
+    }
+
+    detachInterrupt(digitalPinToInterrupt(pin));
+    g_isr_buttons[isr_slot] = nullptr;
+    isr_slot = NO_SLOT;
+}
+
+bool ButtonSensor::attachCapture()
+{
+    if (digitalPinToInterrupt(pin) != NOT_AN_INTERRUPT) {
+        for (uint8_t slot = 0; slot < MAX_INTERRUPT_BUTTONS; slot++) {
+            if (g_isr_buttons[slot] != nullptr) {
+                continue;
+            }
+
+            isr_slot = slot;
+            g_isr_buttons[slot] = this;
+            attachInterrupt(digitalPinToInterrupt(pin), BUTTON_ISR_TRAMPOLINES[slot], CHANGE);
+            return true;
+        }
+    }
+
+    // No external interrupt (or all trampolines taken): try the port's pin-change interrupt
+    via_pcint = PinChange::attach(pin, capturePinChange, this);
+    return via_pcint;
+}
+
 void ButtonSensor::begin()
 {
+    release();
+
     // Configure pin as input with pullup
     // Button connects pin to GND when pressed (active LOW)
     pinMode(pin, INPUT_PULLUP);
@@ -25,13 +106,78 @@ void ButtonSensor::begin()
     raw_state = false;
     debounce_count = 0;
     has_pending_event = false;
+
+    isr_state = false;
+    isr_edge_us = micros() - lockout_us; // First edge is never locked out
+    edge_head = 0;
+    edge_tail = 0;
+
+    if (use_interrupt) {
+        attachCapture();
+    }
+}
+
+void BUTTON_ISR_ATTR ButtonSensor::capture()
+{
+    bool pressed = (digitalRead(pin) == LOW);
+    if (pressed == isr_state) {
+        return; // Another pin on the port, or a bounce back to the current state
+    }
+
+    // Time-based eager debounce: ignore edges until the lockout since the last one ends
+    uint32_t now = micros();
+    if ((now - isr_edge_us) < lockout_us) {
+        return;
+    }
+
+    uint8_t next_tail = (uint8_t)((edge_tail + 1) % EDGE_QUEUE_SIZE);
+    if (next_tail == edge_head) {
+        return; // Queue full - scan() retries once there is room
+    }
+
+    edge_queue[edge_tail] = pressed;
+    edge_tail = next_tail;
+    isr_state = pressed;
+    isr_edge_us = now;
 }
 
 void ButtonSensor::scan()
 {
+    if (isInterruptDriven()) {
+        // The ISR drops the final edge of a bounce if it lands in the lockout;
+        // re-check the level so the queued state always catches up with the pin
+        noInterrupts();
+        capture();
+        interrupts();
+
+        if (edge_head != edge_tail) {
+            markReady();
+        }
+        return;
+    }
+
     // Read raw state (LOW = pressed due to INPUT_PULLUP)
     bool new_raw = (digitalRead(pin) == LOW);
 
+    if (eager) {
+        // Eager debounce: take the first differing reading as the new state,
+        // then ignore the pin for debounce_threshold scans while contacts bounce
+        if (debounce_count > 0) {
+            debounce_count--;
+        } else if (new_raw != current_state) {
+            current_state = new_raw;
+            debounce_count = debounce_threshold;
+
+            if (current_state != last_reported) {
+                has_pending_event = true;
+                markReady();
+            }
+        }
+
+        raw_state = new_raw;
+        return;
+    }
+
     // Counter-based debounce algorithm:
     // Only change state after seeing consistent readings for debounce_threshold scans
     if (new_raw == current_state) {
@@ -49,6 +195,7 @@ void ButtonSensor::scan()
             // Check if this is a new edge event
             if (current_state != last_reported) {
                 has_pending_event = true;
+                markReady();
             }
         }
     }
@@ -58,6 +205,18 @@ void ButtonSensor::scan()
 
 Reading ButtonSensor::getReading()
 {
+    if (isInterruptDriven()) {
+        // Single producer (ISR) / single consumer: only this side moves edge_head
+        if (edge_head == edge_tail) {
+            return Reading();
+        }
+
+        current_state = edge_queue[edge_head];
+        edge_head = (uint8_t)((edge_head + 1) % EDGE_QUEUE_SIZE);
+        last_reported = current_state;
+        return Reading(current_state ? 1 : 0, InputType::Button, pin);
+    }
+
     if (!has_pending_event) {
         return Reading(); // No event to report
     }
@@ -7,20 +7,52 @@ namespace Sensor {
 
 // Button sensor implementation
 // Uses counter-based debouncing and reports edge events (press/release)
-class ButtonSensor : public ISensor {
+// Eager mode reports the first edge immediately and then ignores the pin for
+// the debounce window, so a press goes out within one scan
+// Interrupt mode captures edges in a pin-change ISR (attachInterrupt, or the shared
+// PinChange dispatch on other AVR pins) and debounces them by time: an edge is
+// taken unless it falls within debounce x DEBOUNCE_STEP_US of the previous one.
+// Edges are queued, so a tap shorter than the scan period is still reported.
+// Pins without any interrupt fall back to polling.
+class ButtonSensor final : public ISensor {
+public:
+    // Buttons that can use attachInterrupt at once (one ISR trampoline each);
+    // AVR buttons beyond these use PinChange while it has handlers free
+    static constexpr uint8_t MAX_INTERRUPT_BUTTONS = 4;
+    static constexpr uint8_t NO_SLOT = 0xFF;
+
+    // Lockout per debounce unit in interrupt mode (nominal scan period)
+    static constexpr uint32_t DEBOUNCE_STEP_US = 10000;
+
+    // Captured edges held between scans
+    static constexpr uint8_t EDGE_QUEUE_SIZE = 4;
+
 private:
     uint8_t pin;               // Arduino pin number
-    uint8_t debounce_threshold; // Number of scans for debounce
+    uint8_t debounce_threshold; // Number of scans for debounce (lockout length in eager mode)
+    bool eager;                // Commit on first edge, then lock out
+    bool use_interrupt;        // Capture edges from a pin-change interrupt when available
+    uint8_t isr_slot;          // Interrupt trampoline slot (NO_SLOT = polled in scan)
+    bool via_pcint;            // Registered with PinChange (AVR pin-change interrupt)
 
     // State
     bool current_state;        // Current debounced state (true = pressed)
     bool last_reported;        // Last reported state
     bool raw_state;            // Raw reading from pin
-    uint8_t debounce_count;    // Counter for debounce
+    uint8_t debounce_count;    // Counter for debounce (lockout scans left in eager mode)
     bool has_pending_event;    // True if there's an event to report
 
+    // Shared with the ISR (interrupt mode)
+    volatile bool isr_state;   // Debounced state as of the last accepted edge
+    volatile uint32_t isr_edge_us; // Timestamp of the last accepted edge
+    volatile bool edge_queue[EDGE_QUEUE_SIZE]; // Accepted edges (true = press), oldest first
+    volatile uint8_t edge_head; // Next edge to report (written by getReading)
+    volatile uint8_t edge_tail; // Next free entry (written by capture)
+    uint32_t lockout_us;       // Minimum time between accepted edges
+
 public:
-    ButtonSensor(uint8_t pin_number, uint8_t debounce_scans);
+    ButtonSensor(uint8_t pin_number, uint8_t debounce_scans, bool eager_debounce = false, bool interrupt_capture = false);
+    ~ButtonSensor() override;
 
     // ISensor interface implementation
     void begin() override;
@@ -28,6 +60,16 @@ public:
     Reading getReading() override;
     InputType getType() const override { return InputType::Button; }
     uint8_t getPin() const override { return pin; }
+
+    // Read the pin and queue an edge if it passes the lockout (called from the ISR)
+    void capture();
+
+    // True if edges are captured by an interrupt
+    bool isInterruptDriven() const { return isr_slot != NO_SLOT || via_pcint; }
+
+private:
+    bool attachCapture();
+    void release();
 };
 
 } // namespace Sensor
@@ -1,5 +1,9 @@
 #include "config_manager.h"
 #include "device_info.h"
+#include <string.h>
+#ifdef __AVR__
+#include <avr/eeprom.h>
+#endif
 
 // Platform-specific EEPROM instance for Arduino Due
 #ifdef EEPROM_USE_DUE_FLASH
@@ -35,22 +39,468 @@ void eeprom_get(int address, T& value)
 #endif
 }
 
-void eeprom_commit()
+// Returns false if the platform failed to write its RAM copy to flash
+bool eeprom_commit()
 {
 #ifdef EEPROM_NEEDS_COMMIT
-    EEPROM.commit();
+    return EEPROM.commit();
+#else
+    return true;
+#endif
+}
+
+// True when a byte can be read or written without waiting for the last write
+bool eeprom_ready()
+{
+#ifdef __AVR__
+    return eeprom_is_ready();
+#else
+    return true;
 #endif
 }
 
+// Writes fields into a packed input (little-endian); fails once out of space
+class Packer {
+public:
+    Packer(uint8_t* buffer, size_t size)
+        : buffer(buffer)
+        , size(size)
+        , pos(0)
+        , ok(true)
+    {
+    }
+
+    void field(uint8_t& value)
+    {
+        if (pos + 1 > size) {
+            ok = false;
+            return;
+        }
+        buffer[pos++] = value;
+    }
+
+    void field(uint16_t& value)
+    {
+        uint8_t low = (uint8_t)(value & 0xFF);
+        uint8_t high = (uint8_t)(value >> 8);
+        field(low);
+        field(high);
+    }
+
+    // Element count of a variable-length field (fails over max)
+    void count(uint8_t& value, uint8_t max)
+    {
+        if (value > max) {
+            ok = false;
+            value = 0; // Keep the array loops that follow in bounds
+        }
+        field(value);
+    }
+
+    uint8_t* buffer;
+    size_t size;
+    size_t pos;
+    bool ok;
+};
+
+// Reads fields back out of a packed input; fails on truncated or invalid data
+class Unpacker {
+public:
+    Unpacker(const uint8_t* buffer, size_t size)
+        : buffer(buffer)
+        , size(size)
+        , pos(0)
+        , ok(true)
+    {
+    }
+
+    void field(uint8_t& value)
+    {
+        if (pos + 1 > size) {
+            ok = false;
+            value = 0;
+            return;
+        }
+        value = buffer[pos++];
+    }
+
+    void field(uint16_t& value)
+    {
+        uint8_t low;
+        uint8_t high;
+        field(low);
+        field(high);
+        value = (uint16_t)(low | (high << 8));
+    }
+
+    void count(uint8_t& value, uint8_t max)
+    {
+        field(value);
+        if (value > max) {
+            ok = false;
+            value = 0; // Keep the array loops that follow in bounds
+        }
+    }
+
+    const uint8_t* buffer;
+    size_t size;
+    size_t pos;
+    bool ok;
+};
+
+// Packed layout of one input, shared by packing and unpacking
+// Returns false for an unknown input type
+template <typename Io>
+bool transferInput(Io& io, ConfigManager::InputConfig& input)
+{
+    io.field(input.input_type);
+
+    switch (input.input_type) {
+    case Protocol::INPUT_TYPE_ANALOG:
+        io.field(input.analog.pin);
+        io.field(input.analog.sensitivity);
+        io.field(input.analog.oversample);
+        io.field(input.analog.filter);
+        io.field(input.analog.filter_alpha);
+        io.field(input.analog.filter_beta);
+        io.field(input.analog.median);
+        io.field(input.analog.dead_zone);
+        io.field(input.analog.hysteresis);
+        io.field(input.analog.min_interval_ms);
+        io.field(input.analog.keepalive_ms);
+        io.ok = io.ok && input.analog.oversample <= Protocol::MAX_OVERSAMPLE_BITS;
+        break;
+
+    case Protocol::INPUT_TYPE_BUTTON:
+        io.field(input.button.pin);
+        io.field(input.button.debounce);
+        io.field(input.button.flags);
+        break;
+
+    case Protocol::INPUT_TYPE_MATRIX: {
+        io.count(input.matrix.num_row_pins, ConfigManager::MAX_MATRIX_PINS);
+        io.count(input.matrix.num_col_pins, ConfigManager::MAX_MATRIX_PINS);
+        uint8_t total_pins = (uint8_t)(input.matrix.num_row_pins + input.matrix.num_col_pins);
+        if (total_pins > ConfigManager::MAX_MATRIX_PINS) {
+            io.ok = false;
+            return true; // Invalid matrix config
+        }
+        for (uint8_t p = 0; p < total_pins; p++) {
+            io.field(input.matrix.pins[p]);
+        }
+        io.field(input.matrix.flags);
+        break;
+    }
+
+    case Protocol::INPUT_TYPE_SHIFT_REGISTER:
+        io.field(input.shift_register.latch_pin);
+        io.count(input.shift_register.num_registers, Protocol::MAX_SHIFT_REGISTERS);
+        break;
+
+    case Protocol::INPUT_TYPE_I2C_EXPANDER:
+        io.field(input.expander.chip);
+        io.field(input.expander.address);
+        io.field(input.expander.int_pin);
+        break;
+
+    case Protocol::INPUT_TYPE_ANALOG_MUX:
+        io.field(input.analog_mux.adc_pin);
+        io.field(input.analog_mux.sensitivity);
+        io.count(input.analog_mux.num_channels, Protocol::MAX_MUX_CHANNELS);
+        io.field(input.analog_mux.settle_us);
+        for (uint8_t p = 0; p < Protocol::MUX_SELECT_PINS; p++) {
+            io.field(input.analog_mux.select_pins[p]);
+        }
+        break;
+
+    case Protocol::INPUT_TYPE_ANALOG_NOTCH:
+        io.field(input.notch.pin);
+        io.field(input.notch.hysteresis);
+        io.count(input.notch.num_thresholds, Protocol::MAX_NOTCH_THRESHOLDS);
+        for (uint8_t t = 0; t < input.notch.num_thresholds; t++) {
+            io.field(input.notch.thresholds[t]);
+        }
+        break;
+
+    case Protocol::INPUT_TYPE_RESISTOR_LADDER:
+        io.field(input.ladder.pin);
+        io.field(input.ladder.debounce);
+        io.count(input.ladder.num_buttons, Protocol::MAX_LADDER_BUTTONS);
+        for (uint8_t t = 0; t < input.ladder.num_buttons; t++) {
+            io.field(input.ladder.thresholds[t]);
+        }
+        break;
+
+    case Protocol::INPUT_TYPE_ENCODER:
+        io.field(input.encoder.pin_a);
+        io.field(input.encoder.pin_b);
+        io.field(input.encoder.steps_per_detent);
+        io.field(input.encoder.sensitivity);
+        break;
+
+    case Protocol::INPUT_TYPE_BUTTON_GROUP:
+        io.count(input.button_group.num_pins, Protocol::MAX_BUTTON_GROUP_PINS);
+        for (uint8_t p = 0; p < input.button_group.num_pins; p++) {
+            io.field(input.button_group.pins[p]);
+        }
+        io.field(input.button_group.debounce);
+        break;
+
+    default:
+        return false; // Unknown input type
+    }
+
+    return true;
+}
+
+// Reverse the bytes in [first, last)
+void reverseBytes(uint8_t* first, uint8_t* last)
+{
+    while (first < last) {
+        last--;
+        uint8_t b = *first;
+        *first = *last;
+        *last = b;
+        first++;
+    }
+}
+
+// Pack an input into buffer; returns its size (0 if it doesn't fit or isn't valid)
+size_t packInput(const ConfigManager::InputConfig& input, uint8_t* buffer, size_t size)
+{
+    ConfigManager::InputConfig copy = input;
+    Packer packer(buffer, size);
+    if (!transferInput(packer, copy) || !packer.ok) {
+        return 0;
+    }
+    return packer.pos;
+}
+
+// Unpack the input at the start of buffer; returns its size (0 if invalid)
+size_t unpackInput(const uint8_t* buffer, size_t size, ConfigManager::InputConfig& input)
+{
+    Unpacker unpacker(buffer, size);
+    if (!transferInput(unpacker, input) || !unpacker.ok) {
+        return 0;
+    }
+    return unpacker.pos;
+}
+
 } // anonymous namespace
 
 namespace ConfigManager {
 
+// Last generation number handed out to a ConfigImage
+static uint32_t g_last_generation = 0;
+
+void ConfigImage::touch()
+{
+    generation = ++g_last_generation;
+}
+
+size_t ConfigImage::offsetOf(uint8_t index) const
+{
+    size_t offset = 0;
+    for (uint8_t i = 0; i < index; i++) {
+        offset = next(offset);
+    }
+    return offset;
+}
+
+bool ConfigImage::append(const InputConfig& input)
+{
+    if (num_inputs >= MAX_INPUTS) {
+        return false;
+    }
+
+    size_t size = packInput(input, bytes + used, IMAGE_SIZE - used);
+    if (size == 0) {
+        return false;
+    }
+
+    used = (uint16_t)(used + size);
+    num_inputs++;
+    touch();
+    return true;
+}
+
+bool ConfigImage::replace(uint8_t index, const InputConfig& input)
+{
+    if (index >= num_inputs) {
+        return false;
+    }
+
+    // Pack into scratch space first so a failure leaves the image untouched
+    // (packed inputs have no padding, so never outgrow the struct)
+    uint8_t packed[sizeof(InputConfig)];
+    size_t new_size = packInput(input, packed, sizeof(packed));
+    if (new_size == 0) {
+        return false;
+    }
+
+    InputConfig old;
+    size_t offset = offsetOf(index);
+    size_t old_size = read(offset, old) - offset;
+    if (used - old_size + new_size > IMAGE_SIZE) {
+        return false;
+    }
+
+    // Move the inputs that follow, then drop the new one in
+    memmove(bytes + offset + new_size, bytes + offset + old_size, used - offset - old_size);
+    memcpy(bytes + offset, packed, new_size);
+    used = (uint16_t)(used - old_size + new_size);
+    touch();
+    return true;
+}
+
+void ConfigImage::moveEarlier(uint8_t from, uint8_t to)
+{
+    if (from >= num_inputs || to >= from) {
+        return;
+    }
+
+    // Rotate [to, from] so the moved input comes first: reverse both parts, then the whole
+    size_t start = offsetOf(to);
+    size_t middle = offsetOf(from);
+    size_t end = next(middle);
+    reverseBytes(bytes + start, bytes + middle);
+    reverseBytes(bytes + middle, bytes + end);
+    reverseBytes(bytes + start, bytes + end);
+    touch();
+}
+
+bool ConfigImage::get(uint8_t index, InputConfig& input) const
+{
+    if (index >= num_inputs) {
+        return false;
+    }
+
+    return read(offsetOf(index), input) != 0;
+}
+
+size_t ConfigImage::read(size_t offset, InputConfig& input) const
+{
+    if (offset >= used) {
+        return 0;
+    }
+
+    size_t size = unpackInput(bytes + offset, used - offset, input);
+    return size == 0 ? 0 : offset + size;
+}
+
+size_t ConfigImage::next(size_t offset) const
+{
+    InputConfig input;
+    return read(offset, input);
+}
+
+uint8_t* ConfigImage::restoreBuffer(uint16_t length)
+{
+    clear();
+    if (length > IMAGE_SIZE) {
+        return nullptr;
+    }
+
+    used = length;
+    return bytes;
+}
+
+bool ConfigImage::finishRestore(uint8_t count)
+{
+    // Every input must decode and together they must fill the image exactly
+    size_t offset = 0;
+    InputConfig input;
+    for (uint8_t i = 0; i < count; i++) {
+        offset = read(offset, input);
+        if (offset == 0) {
+            clear();
+            return false;
+        }
+    }
+
+    if (count > MAX_INPUTS || offset != used) {
+        clear();
+        return false;
+    }
+
+    num_inputs = count;
+    touch();
+    return true;
+}
+
 // Global state
 ConfigState g_config_state;
 uint32_t g_current_config_id = 0;
-static InputConfig g_current_inputs[MAX_INPUTS];
-static uint8_t g_current_num_inputs = 0;
+
+// Current configuration and the one before it; a new configuration is received
+// over the previous one, and becomes current by swapping the two
+static ConfigImage g_images[2];
+static uint8_t g_current_image = 0;
+
+// The previous configuration's ID, and its image's generation when it stopped
+// being current (see revertConfiguration())
+static uint32_t g_previous_config_id = 0;
+static uint32_t g_previous_generation = 0;
+
+static ConfigImage& currentInputs()
+{
+    return g_images[g_current_image];
+}
+
+static ConfigImage& previousInputs()
+{
+    return g_images[1 - g_current_image];
+}
+
+// Background store of a configuration (see updateStore())
+static bool g_store_active = false;
+static bool g_store_cancelled = false; // Report Failed on the next updateStore()
+static const ConfigImage* g_store_image = nullptr; // Image being stored
+static uint8_t g_store_header[EEPROM_INPUTS_ADDR];
+static uint16_t g_store_position = 0; // Next byte to check, in write order
+static uint16_t g_store_end = 0; // Bytes to store (header + packed inputs)
+static bool g_store_invalidated = false; // Stored magic number no longer valid
+
+static_assert(sizeof(g_config_state) + sizeof(g_current_config_id) + sizeof(g_last_generation) + sizeof(g_images)
+            + sizeof(g_current_image) + sizeof(g_previous_config_id) + sizeof(g_previous_generation) + sizeof(g_store_active) + sizeof(g_store_cancelled) + sizeof(g_store_image)
+            + sizeof(g_store_header) + sizeof(g_store_position) + sizeof(g_store_end) + sizeof(g_store_invalidated)
+        <= STATIC_RAM,
+    "ConfigManager::STATIC_RAM doesn't cover the configuration state");
+
+// EEPROM address of the byte at a position in write order: everything after
+// the magic number first, the magic number last
+static uint16_t storeAddress(uint16_t position)
+{
+    uint16_t address = (uint16_t)(position + sizeof(EEPROM_MAGIC));
+    return address < g_store_end ? address : (uint16_t)(address - g_store_end);
+}
+
+// Byte the store puts at an address
+static uint8_t storeByte(uint16_t address)
+{
+    if (address < EEPROM_INPUTS_ADDR) {
+        return g_store_header[address];
+    }
+    return g_store_image->getData()[address - EEPROM_INPUTS_ADDR];
+}
+
+// Buffer to receive a new configuration into; a store still streaming from it
+// (a configuration superseded before it was stored) can't finish
+static ConfigImage& receiveBuffer()
+{
+    if (g_store_active && g_store_image == &previousInputs()) {
+        g_store_active = false;
+        g_store_cancelled = true;
+    }
+    return previousInputs();
+}
+
+// The packed inputs have to fit the EEPROM behind the header
+#if defined(EEPROM_SIZE)
+static_assert(EEPROM_INPUTS_ADDR + IMAGE_SIZE <= EEPROM_SIZE, "Config image doesn't fit in EEPROM");
+#elif defined(E2END)
+static_assert(EEPROM_INPUTS_ADDR + IMAGE_SIZE <= E2END + 1, "Config image doesn't fit in EEPROM");
+#endif
 
 void init()
 {
@@ -65,7 +515,7 @@ void init()
     } else {
         // No valid configuration in EEPROM
         g_current_config_id = 0;
-        g_current_num_inputs = 0;
+        currentInputs().clear();
     }
 }
 
@@ -81,7 +531,7 @@ bool handleConfigure(const Protocol::Configure& cfg, bool& complete, bool& error
             error = true;
             return true; // Invalid total_parts
         }
-        g_config_state.start(cfg.config_id, cfg.total_parts);
+        g_config_state.start(cfg.config_id, cfg.total_parts, receiveBuffer());
     } else {
         // Check if this is for the same configuration
         if (g_config_state.getConfigId() != cfg.config_id) {
@@ -91,7 +541,7 @@ bool handleConfigure(const Protocol::Configure& cfg, bool& complete, bool& error
                 error = true;
                 return true;
             }
-            g_config_state.start(cfg.config_id, cfg.total_parts);
+            g_config_state.start(cfg.config_id, cfg.total_parts, receiveBuffer());
         }
     }
 
@@ -104,20 +554,14 @@ bool handleConfigure(const Protocol::Configure& cfg, bool& complete, bool& error
 
     // Check if configuration is complete
     if (g_config_state.isComplete()) {
-        // Store to EEPROM
-        storeToEEPROM(
-            g_config_state.getConfigId(),
-            g_config_state.getInputs(),
-            g_config_state.getNumInputs());
-
-        // Update current configuration
+        // The received inputs become the current configuration
+        g_config_state.sortInputs();
+        g_previous_config_id = g_current_config_id;
+        g_previous_generation = currentInputs().getGeneration();
+        g_current_image = (uint8_t)(1 - g_current_image);
         g_current_config_id = g_config_state.getConfigId();
-        g_current_num_inputs = g_config_state.getNumInputs();
-        for (uint8_t i = 0; i < g_current_num_inputs; i++) {
-            g_current_inputs[i] = g_config_state.getInputs()[i];
-        }
 
-        // Reset state
+        // Reset state (storing is up to the caller, once the sensors run it)
         g_config_state.reset();
 
         complete = true;
@@ -136,57 +580,33 @@ bool checkTimeout()
     return false;
 }
 
-void storeToEEPROM(uint32_t config_id, const InputConfig* inputs, uint8_t num_inputs)
-{
-    int addr = 0;
-
-    // Write magic number
-    eeprom_put(EEPROM_MAGIC_ADDR, EEPROM_MAGIC);
-
-    // Write EEPROM format version (for compatibility checking)
-    eeprom_put(EEPROM_VERSION_ADDR, EEPROM_FORMAT_VERSION);
-
-    // Write config_id
-    eeprom_put(EEPROM_CONFIG_ID_ADDR, config_id);
-
-    // Write number of inputs
-    eeprom_put(EEPROM_NUM_INPUTS_ADDR, num_inputs);
-
-    // Write input configurations (variable size based on type)
-    addr = EEPROM_INPUTS_ADDR;
-    for (uint8_t i = 0; i < num_inputs; i++) {
-        // Write input type
-        eeprom_put(addr, inputs[i].input_type);
-        addr += sizeof(uint8_t);
-
-        switch (inputs[i].input_type) {
-        case Protocol::INPUT_TYPE_ANALOG:
-            eeprom_put(addr, inputs[i].analog.pin);
-            addr += sizeof(uint8_t);
-            eeprom_put(addr, inputs[i].analog.sensitivity);
-            addr += sizeof(uint8_t);
-            break;
-
-        case Protocol::INPUT_TYPE_BUTTON:
-            eeprom_put(addr, inputs[i].button.pin);
-            addr += sizeof(uint8_t);
-            eeprom_put(addr, inputs[i].button.debounce);
-            addr += sizeof(uint8_t);
-            break;
-
-        case Protocol::INPUT_TYPE_MATRIX: {
-            eeprom_put(addr, inputs[i].matrix.num_row_pins);
-            addr += sizeof(uint8_t);
-            eeprom_put(addr, inputs[i].matrix.num_col_pins);
-            addr += sizeof(uint8_t);
-            uint8_t total_pins = inputs[i].matrix.num_row_pins + inputs[i].matrix.num_col_pins;
-            for (uint8_t p = 0; p < total_pins; p++) {
-                eeprom_put(addr, inputs[i].matrix.pins[p]);
-                addr += sizeof(uint8_t);
-            }
-            break;
-        }
-        }
+// Header bytes in front of the packed inputs, as eeprom_put() lays the fields out
+static void buildHeader(uint8_t (&header)[EEPROM_INPUTS_ADDR], uint32_t config_id, const ConfigImage& inputs)
+{
+    uint8_t version = EEPROM_FORMAT_VERSION;
+    uint8_t num_inputs = inputs.getNumInputs();
+    uint16_t size = inputs.getSize();
+    memcpy(header + EEPROM_MAGIC_ADDR, &EEPROM_MAGIC, sizeof(EEPROM_MAGIC));
+    memcpy(header + EEPROM_VERSION_ADDR, &version, sizeof(version));
+    memcpy(header + EEPROM_CONFIG_ID_ADDR, &config_id, sizeof(config_id));
+    memcpy(header + EEPROM_NUM_INPUTS_ADDR, &num_inputs, sizeof(num_inputs));
+    memcpy(header + EEPROM_IMAGE_SIZE_ADDR, &size, sizeof(size));
+}
+
+void storeToEEPROM(uint32_t config_id, const ConfigImage& inputs)
+{
+    // Write the header: magic number, format version (for compatibility
+    // checking), config_id, number of inputs and packed length
+    uint8_t header[EEPROM_INPUTS_ADDR];
+    buildHeader(header, config_id, inputs);
+    for (uint8_t i = 0; i < EEPROM_INPUTS_ADDR; i++) {
+        eeprom_put(i, header[i]);
+    }
+
+    // Write the packed input configurations as they are in RAM
+    const uint8_t* data = inputs.getData();
+    for (uint16_t i = 0; i < inputs.getSize(); i++) {
+        eeprom_put(EEPROM_INPUTS_ADDR + i, data[i]);
     }
 
     // Commit changes for platforms that require it
@@ -218,56 +638,27 @@ bool loadFromEEPROM()
     eeprom_get(EEPROM_CONFIG_ID_ADDR, g_current_config_id);
 
     // Read number of inputs
-    eeprom_get(EEPROM_NUM_INPUTS_ADDR, g_current_num_inputs);
+    uint8_t num_inputs;
+    eeprom_get(EEPROM_NUM_INPUTS_ADDR, num_inputs);
 
     // Validate number of inputs
-    if (g_current_num_inputs == 0 || g_current_num_inputs > MAX_INPUTS) {
+    if (num_inputs == 0 || num_inputs > MAX_INPUTS) {
+        currentInputs().clear();
         return false;
     }
 
-    // Read input configurations (variable size based on type)
-    int addr = EEPROM_INPUTS_ADDR;
-    for (uint8_t i = 0; i < g_current_num_inputs; i++) {
-        eeprom_get(addr, g_current_inputs[i].input_type);
-        addr += sizeof(uint8_t);
-
-        switch (g_current_inputs[i].input_type) {
-        case Protocol::INPUT_TYPE_ANALOG:
-            eeprom_get(addr, g_current_inputs[i].analog.pin);
-            addr += sizeof(uint8_t);
-            eeprom_get(addr, g_current_inputs[i].analog.sensitivity);
-            addr += sizeof(uint8_t);
-            break;
-
-        case Protocol::INPUT_TYPE_BUTTON:
-            eeprom_get(addr, g_current_inputs[i].button.pin);
-            addr += sizeof(uint8_t);
-            eeprom_get(addr, g_current_inputs[i].button.debounce);
-            addr += sizeof(uint8_t);
-            break;
-
-        case Protocol::INPUT_TYPE_MATRIX: {
-            eeprom_get(addr, g_current_inputs[i].matrix.num_row_pins);
-            addr += sizeof(uint8_t);
-            eeprom_get(addr, g_current_inputs[i].matrix.num_col_pins);
-            addr += sizeof(uint8_t);
-            uint8_t total_pins = g_current_inputs[i].matrix.num_row_pins + g_current_inputs[i].matrix.num_col_pins;
-            if (total_pins > MAX_MATRIX_PINS) {
-                return false; // Invalid matrix config
-            }
-            for (uint8_t p = 0; p < total_pins; p++) {
-                eeprom_get(addr, g_current_inputs[i].matrix.pins[p]);
-                addr += sizeof(uint8_t);
-            }
-            break;
-        }
-
-        default:
-            return false; // Unknown input type
-        }
+    // Read the packed input configurations back and check they decode
+    uint16_t size;
+    eeprom_get(EEPROM_IMAGE_SIZE_ADDR, size);
+    uint8_t* data = currentInputs().restoreBuffer(size);
+    if (data == nullptr) {
+        return false; // Longer than this build's image
+    }
+    for (uint16_t i = 0; i < size; i++) {
+        eeprom_get(EEPROM_INPUTS_ADDR + i, data[i]);
     }
 
-    return true;
+    return currentInputs().finishRestore(num_inputs);
 }
 
 uint32_t getCurrentConfigId()
@@ -275,10 +666,155 @@ uint32_t getCurrentConfigId()
     return g_current_config_id;
 }
 
-const InputConfig* getCurrentConfig(uint8_t& num_inputs)
+const ConfigImage& getCurrentConfig()
+{
+    return currentInputs();
+}
+
+bool revertConfiguration()
 {
-    num_inputs = g_current_num_inputs;
-    return g_current_inputs;
+    // A configuration received since has overwritten the previous image
+    if (previousInputs().getGeneration() != g_previous_generation) {
+        return false;
+    }
+
+    g_current_image = (uint8_t)(1 - g_current_image);
+    g_current_config_id = g_previous_config_id;
+    g_previous_generation = 0;
+    return true;
+}
+
+const ConfigImage& getPreviousConfig()
+{
+    return previousInputs();
+}
+
+InputChange compareInputs(const ConfigImage& a, size_t a_offset, const ConfigImage& b, size_t b_offset)
+{
+    InputConfig a_input;
+    InputConfig b_input;
+    size_t a_end = a.read(a_offset, a_input);
+    size_t b_end = b.read(b_offset, b_input);
+    if (a_end == 0 || b_end == 0) {
+        return InputChange::Different;
+    }
+
+    // The packed bytes are the whole input, so they compare exactly
+    size_t size = a_end - a_offset;
+    if (size == b_end - b_offset && memcmp(a.getData() + a_offset, b.getData() + b_offset, size) == 0) {
+        return InputChange::Same;
+    }
+
+    if (a_input.input_type != Protocol::INPUT_TYPE_ANALOG || b_input.input_type != Protocol::INPUT_TYPE_ANALOG) {
+        return InputChange::Different;
+    }
+
+    // Same analog input apart from the dead zone? (b's packed bytes are compared
+    // in place, so only one input is packed on the stack)
+    uint8_t a_packed[sizeof(InputConfig)];
+    a_input.analog.dead_zone = b_input.analog.dead_zone;
+    size = packInput(a_input, a_packed, sizeof(a_packed));
+    if (size != b_end - b_offset || memcmp(a_packed, b.getData() + b_offset, size) != 0) {
+        return InputChange::Different;
+    }
+    return InputChange::Retune;
+}
+
+bool setAnalogDeadZone(uint8_t index, uint8_t dead_zone)
+{
+    InputConfig input;
+    if (!currentInputs().get(index, input) || input.input_type != Protocol::INPUT_TYPE_ANALOG) {
+        return false;
+    }
+
+    input.analog.dead_zone = dead_zone;
+    if (!currentInputs().replace(index, input)) {
+        return false;
+    }
+
+    // A store of this image in progress may have written the old value already
+    if (g_store_active && g_store_image == &currentInputs()) {
+        storeCurrentConfig();
+    }
+    return true;
+}
+
+void storeCurrentConfig()
+{
+    if (currentInputs().getNumInputs() == 0) {
+        return; // Nothing configured
+    }
+
+    g_store_image = &currentInputs();
+    buildHeader(g_store_header, g_current_config_id, *g_store_image);
+    g_store_position = 0;
+    g_store_end = (uint16_t)(EEPROM_INPUTS_ADDR + g_store_image->getSize());
+    g_store_active = true;
+    g_store_cancelled = false;
+
+    uint32_t magic;
+    eeprom_get(EEPROM_MAGIC_ADDR, magic);
+    g_store_invalidated = magic != EEPROM_MAGIC;
+}
+
+StoreStatus updateStore()
+{
+    if (!g_store_active) {
+        if (g_store_cancelled) {
+            g_store_cancelled = false;
+            return StoreStatus::Failed;
+        }
+        return StoreStatus::Idle;
+    }
+
+    uint16_t writes = 0;
+    while (g_store_position < g_store_end) {
+        // Reading right after a write would wait for it on AVR
+        if (writes == STORE_WRITES_PER_TICK || !eeprom_ready()) {
+            return StoreStatus::Writing;
+        }
+
+        uint16_t address = storeAddress(g_store_position);
+        uint8_t wanted = storeByte(address);
+        uint8_t stored;
+        eeprom_get(address, stored);
+        if (stored == wanted) {
+            g_store_position++;
+            continue;
+        }
+
+        // Something changes: invalidate the old configuration before touching it
+        if (!g_store_invalidated) {
+            eeprom_put(EEPROM_MAGIC_ADDR, (uint8_t)~g_store_header[EEPROM_MAGIC_ADDR]);
+            g_store_invalidated = true;
+        } else {
+            eeprom_put(address, wanted);
+            g_store_position++;
+        }
+        writes++;
+    }
+
+    if (!eeprom_ready()) {
+        return StoreStatus::Writing;
+    }
+
+    // Read everything back (on ESP32 reads come from the RAM copy, so a failed
+    // commit is a failed store too)
+    g_store_active = false;
+    bool intact = eeprom_commit();
+    for (uint16_t address = 0; intact && address < g_store_end; address++) {
+        uint8_t stored;
+        eeprom_get(address, stored);
+        intact = stored == storeByte(address);
+    }
+
+    if (!intact) {
+        // Don't leave a bad copy to be loaded on the next boot
+        eeprom_put(EEPROM_MAGIC_ADDR, (uint8_t)~g_store_header[EEPROM_MAGIC_ADDR]);
+        eeprom_commit();
+        return StoreStatus::Failed;
+    }
+    return StoreStatus::Stored;
 }
 
 } // namespace ConfigManager
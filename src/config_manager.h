@@ -9,7 +9,7 @@
 #include <EEPROM.h>
 #define EEPROM_NEEDS_BEGIN
 #define EEPROM_NEEDS_COMMIT
-#define EEPROM_SIZE 512
+#define EEPROM_SIZE 2048
 #elif defined(EEPROM_EMULATION) || defined(ARDUINO_SAM_DUE)
 #include <DueFlashStorage.h>
 #define EEPROM_USE_DUE_FLASH
@@ -20,7 +20,26 @@
 namespace ConfigManager {
 
 // Maximum number of inputs that can be configured
-constexpr uint8_t MAX_INPUTS = 8;
+// AVR boards with 2-2.5KB of SRAM (Uno, Nano, Leonardo, Micro, Pro Micro) only
+// have room for the sensors of 16 (see SensorManager::ARENA_SIZE)
+#if defined(__AVR__) && RAMEND < 0x1000
+constexpr uint8_t MAX_INPUTS = 16;
+#else
+constexpr uint8_t MAX_INPUTS = 64;
+#endif
+
+// Bytes for one packed configuration (see ConfigImage)
+// AVR keeps two of these (current + being received): 224 bytes holds 16 fully
+// optioned analog inputs, 256 bytes 64 buttons (-DCONFIG_IMAGE_SIZE=<bytes> overrides)
+#if defined(CONFIG_IMAGE_SIZE)
+constexpr size_t IMAGE_SIZE = CONFIG_IMAGE_SIZE;
+#elif defined(__AVR__) && RAMEND < 0x1000
+constexpr size_t IMAGE_SIZE = 224;
+#elif defined(__AVR__)
+constexpr size_t IMAGE_SIZE = 256;
+#else
+constexpr size_t IMAGE_SIZE = 1024;
+#endif
 
 // Timeout for configuration in milliseconds (5 seconds)
 constexpr unsigned long CONFIG_TIMEOUT_MS = 5000;
@@ -30,7 +49,8 @@ constexpr int EEPROM_MAGIC_ADDR = 0; // 4 bytes - magic number to validate EEPRO
 constexpr int EEPROM_VERSION_ADDR = 4; // 1 byte - device version that created this config
 constexpr int EEPROM_CONFIG_ID_ADDR = 5; // 4 bytes - config_id
 constexpr int EEPROM_NUM_INPUTS_ADDR = 9; // 1 byte - number of inputs
-constexpr int EEPROM_INPUTS_ADDR = 10; // Start of input configurations
+constexpr int EEPROM_IMAGE_SIZE_ADDR = 10; // 2 bytes - length of the packed inputs
+constexpr int EEPROM_INPUTS_ADDR = 12; // Start of input configurations (ConfigImage bytes)
 
 // Magic number to validate EEPROM data
 constexpr uint32_t EEPROM_MAGIC = 0xC0FF1234;
@@ -39,6 +59,7 @@ constexpr uint32_t EEPROM_MAGIC = 0xC0FF1234;
 constexpr uint8_t MAX_MATRIX_PINS = Protocol::MAX_MATRIX_PINS;
 
 // Single input configuration - union-based to match protocol
+// Used to build and read one input at a time; configurations are kept packed in a ConfigImage
 struct InputConfig {
     uint8_t input_type;
 
@@ -47,12 +68,22 @@ struct InputConfig {
         struct {
             uint8_t pin;
             uint8_t sensitivity;
+            uint8_t oversample; // Extra bits from oversampling (0 = off)
+            uint8_t filter; // Protocol::ANALOG_FILTER_*
+            uint8_t filter_alpha; // Filter coefficient in Q8
+            uint8_t filter_beta; // ONE_EURO speed gain
+            uint8_t median; // Median prefilter window (0, 3 or 5)
+            uint8_t dead_zone; // Send dead zone (0 = default, set by noise calibration)
+            uint8_t hysteresis; // Direction reversal band (0 = off)
+            uint16_t min_interval_ms; // Minimum time between sends (0 = from sensitivity)
+            uint16_t keepalive_ms; // Forced send interval (0 = default)
         } analog;
 
         // INPUT_TYPE_BUTTON
         struct {
             uint8_t pin;
             uint8_t debounce;
+            uint8_t flags; // Protocol::BUTTON_FLAG_* bits
         } button;
 
         // INPUT_TYPE_MATRIX
@@ -60,7 +91,61 @@ struct InputConfig {
             uint8_t num_row_pins;
             uint8_t num_col_pins;
             uint8_t pins[MAX_MATRIX_PINS]; // row_pins followed by col_pins
+            uint8_t flags; // Protocol::MATRIX_FLAG_* bits
         } matrix;
+
+        // INPUT_TYPE_SHIFT_REGISTER
+        struct {
+            uint8_t latch_pin;
+            uint8_t num_registers;
+        } shift_register;
+
+        // INPUT_TYPE_I2C_EXPANDER
+        struct {
+            uint8_t chip;
+            uint8_t address;
+            uint8_t int_pin;
+        } expander;
+
+        // INPUT_TYPE_ANALOG_MUX
+        struct {
+            uint8_t adc_pin;
+            uint8_t sensitivity;
+            uint8_t num_channels;
+            uint8_t settle_us;
+            uint8_t select_pins[Protocol::MUX_SELECT_PINS];
+        } analog_mux;
+
+        // INPUT_TYPE_ANALOG_NOTCH
+        struct {
+            uint8_t pin;
+            uint8_t hysteresis;
+            uint8_t num_thresholds;
+            uint16_t thresholds[Protocol::MAX_NOTCH_THRESHOLDS];
+        } notch;
+
+        // INPUT_TYPE_RESISTOR_LADDER
+        struct {
+            uint8_t pin;
+            uint8_t debounce;
+            uint8_t num_buttons;
+            uint16_t thresholds[Protocol::MAX_LADDER_BUTTONS];
+        } ladder;
+
+        // INPUT_TYPE_ENCODER
+        struct {
+            uint8_t pin_a;
+            uint8_t pin_b;
+            uint8_t steps_per_detent;
+            uint8_t sensitivity;
+        } encoder;
+
+        // INPUT_TYPE_BUTTON_GROUP
+        struct {
+            uint8_t num_pins;
+            uint8_t pins[Protocol::MAX_BUTTON_GROUP_PINS];
+            uint8_t debounce;
+        } button_group;
     };
 
     InputConfig()
@@ -68,6 +153,99 @@ struct InputConfig {
     {
         analog.pin = 0;
         analog.sensitivity = 0;
+        analog.oversample = 0;
+        analog.filter = Protocol::ANALOG_FILTER_NONE;
+        analog.filter_alpha = 0;
+        analog.filter_beta = 0;
+        analog.median = Protocol::ANALOG_MEDIAN_OFF;
+        analog.dead_zone = 0;
+        analog.hysteresis = 0;
+        analog.min_interval_ms = 0;
+        analog.keepalive_ms = 0;
+        button.flags = 0;
+        matrix.flags = 0;
+    }
+};
+
+// Packed configuration: inputs stored back to back in their EEPROM layout
+// ([input_type] [fields...], variable length per type), so RAM goes to what
+// is configured rather than to MAX_INPUTS worst-case InputConfig unions
+class ConfigImage {
+private:
+    uint8_t bytes[IMAGE_SIZE];
+    uint16_t used; // Bytes in use
+    uint8_t num_inputs;
+    uint32_t generation; // Changes with every modification (see getGeneration())
+
+    // Byte offset of an input (walks the inputs before it)
+    size_t offsetOf(uint8_t index) const;
+
+    // Take a new generation number
+    void touch();
+
+public:
+    ConfigImage()
+        : used(0)
+        , num_inputs(0)
+    {
+        touch();
+    }
+
+    // Remove all inputs
+    void clear()
+    {
+        used = 0;
+        num_inputs = 0;
+        touch();
+    }
+
+    // Append an input
+    // Returns false if it doesn't fit or isn't valid (unknown type, counts over the limits)
+    bool append(const InputConfig& input);
+
+    // Replace an input (the ones after it move if its size changes)
+    bool replace(uint8_t index, const InputConfig& input);
+
+    // Move an input to an earlier index (the ones in between shift up by one)
+    void moveEarlier(uint8_t from, uint8_t to);
+
+    // Decode an input by index (walks the inputs before it)
+    bool get(uint8_t index, InputConfig& input) const;
+
+    // Decode the input starting at a byte offset
+    // Returns the offset of the next input (0 if there is no valid input at offset)
+    // Iterate with: offset = 0; for each of getNumInputs(): offset = read(offset, input)
+    size_t read(size_t offset, InputConfig& input) const;
+
+    // Offset of the input after the one at offset, without keeping the decoded input
+    size_t next(size_t offset) const;
+
+    // Restore packed bytes read back from storage: fill restoreBuffer(length)
+    // (nullptr if too long), then finishRestore() checks they hold num_inputs inputs
+    uint8_t* restoreBuffer(uint16_t length);
+    bool finishRestore(uint8_t count);
+
+    // Number of inputs
+    uint8_t getNumInputs() const
+    {
+        return num_inputs;
+    }
+
+    // Packed bytes and their length
+    const uint8_t* getData() const
+    {
+        return bytes;
+    }
+
+    uint16_t getSize() const
+    {
+        return used;
+    }
+
+    // Identifies the contents: unique across images and modifications (a copy keeps it)
+    uint32_t getGeneration() const
+    {
+        return generation;
     }
 };
 
@@ -76,86 +254,159 @@ class ConfigState {
 private:
     uint32_t config_id;
     uint8_t total_parts;
-    uint8_t received_parts;
-    bool parts_received[MAX_INPUTS]; // Track which parts we've received
-    InputConfig inputs[MAX_INPUTS];
+    uint8_t part_numbers[MAX_INPUTS]; // part_number of each received input, in arrival order
+    ConfigImage* inputs; // Received inputs, in arrival order (storage owned by ConfigManager)
     unsigned long start_time; // When we started receiving this configuration
     bool active; // Is there an active configuration being received?
 
+    // Copy the type-specific fields of a Configure message
+    static bool toInputConfig(const Protocol::Configure& cfg, InputConfig& input)
+    {
+        input.input_type = cfg.input_type;
+
+        switch (cfg.input_type) {
+        case Protocol::INPUT_TYPE_ANALOG:
+            input.analog.pin = cfg.analog.pin;
+            input.analog.sensitivity = cfg.analog.sensitivity;
+            input.analog.oversample = cfg.analog.oversample;
+            input.analog.filter = cfg.analog.filter;
+            input.analog.filter_alpha = cfg.analog.filter_alpha;
+            input.analog.filter_beta = cfg.analog.filter_beta;
+            input.analog.median = cfg.analog.median;
+            input.analog.dead_zone = cfg.analog.dead_zone;
+            input.analog.hysteresis = cfg.analog.hysteresis;
+            input.analog.min_interval_ms = cfg.analog.min_interval_ms;
+            input.analog.keepalive_ms = cfg.analog.keepalive_ms;
+            break;
+
+        case Protocol::INPUT_TYPE_BUTTON:
+            input.button.pin = cfg.button.pin;
+            input.button.debounce = cfg.button.debounce;
+            input.button.flags = cfg.button.flags;
+            break;
+
+        case Protocol::INPUT_TYPE_MATRIX:
+            input.matrix.num_row_pins = cfg.matrix.num_row_pins;
+            input.matrix.num_col_pins = cfg.matrix.num_col_pins;
+            for (uint8_t i = 0; i < cfg.matrix.num_row_pins + cfg.matrix.num_col_pins; i++) {
+                input.matrix.pins[i] = cfg.matrix.pins[i];
+            }
+            input.matrix.flags = cfg.matrix.flags;
+            break;
+
+        case Protocol::INPUT_TYPE_SHIFT_REGISTER:
+            input.shift_register.latch_pin = cfg.shift_register.latch_pin;
+            input.shift_register.num_registers = cfg.shift_register.num_registers;
+            break;
+
+        case Protocol::INPUT_TYPE_I2C_EXPANDER:
+            input.expander.chip = cfg.expander.chip;
+            input.expander.address = cfg.expander.address;
+            input.expander.int_pin = cfg.expander.int_pin;
+            break;
+
+        case Protocol::INPUT_TYPE_ANALOG_MUX:
+            input.analog_mux.adc_pin = cfg.analog_mux.adc_pin;
+            input.analog_mux.sensitivity = cfg.analog_mux.sensitivity;
+            input.analog_mux.num_channels = cfg.analog_mux.num_channels;
+            input.analog_mux.settle_us = cfg.analog_mux.settle_us;
+            for (uint8_t i = 0; i < Protocol::MUX_SELECT_PINS; i++) {
+                input.analog_mux.select_pins[i] = cfg.analog_mux.select_pins[i];
+            }
+            break;
+
+        case Protocol::INPUT_TYPE_ANALOG_NOTCH:
+            input.notch.pin = cfg.notch.pin;
+            input.notch.hysteresis = cfg.notch.hysteresis;
+            input.notch.num_thresholds = cfg.notch.num_thresholds;
+            for (uint8_t i = 0; i < cfg.notch.num_thresholds; i++) {
+                input.notch.thresholds[i] = cfg.notch.thresholds[i];
+            }
+            break;
+
+        case Protocol::INPUT_TYPE_RESISTOR_LADDER:
+            input.ladder.pin = cfg.ladder.pin;
+            input.ladder.debounce = cfg.ladder.debounce;
+            input.ladder.num_buttons = cfg.ladder.num_buttons;
+            for (uint8_t i = 0; i < cfg.ladder.num_buttons; i++) {
+                input.ladder.thresholds[i] = cfg.ladder.thresholds[i];
+            }
+            break;
+
+        case Protocol::INPUT_TYPE_ENCODER:
+            input.encoder.pin_a = cfg.encoder.pin_a;
+            input.encoder.pin_b = cfg.encoder.pin_b;
+            input.encoder.steps_per_detent = cfg.encoder.steps_per_detent;
+            input.encoder.sensitivity = cfg.encoder.sensitivity;
+            break;
+
+        case Protocol::INPUT_TYPE_BUTTON_GROUP:
+            input.button_group.num_pins = cfg.button_group.num_pins;
+            for (uint8_t i = 0; i < cfg.button_group.num_pins; i++) {
+                input.button_group.pins[i] = cfg.button_group.pins[i];
+            }
+            input.button_group.debounce = cfg.button_group.debounce;
+            break;
+
+        default:
+            return false; // Unknown input type
+        }
+
+        return true;
+    }
+
 public:
     ConfigState()
         : config_id(0)
         , total_parts(0)
-        , received_parts(0)
+        , inputs(nullptr)
         , start_time(0)
         , active(false)
     {
-        for (uint8_t i = 0; i < MAX_INPUTS; i++) {
-            parts_received[i] = false;
-        }
     }
 
-    // Start a new configuration
-    void start(uint32_t cfg_id, uint8_t total)
+    // Start a new configuration, received into buffer
+    void start(uint32_t cfg_id, uint8_t total, ConfigImage& buffer)
     {
         config_id = cfg_id;
         total_parts = total;
-        received_parts = 0;
         start_time = millis();
         active = true;
-
-        for (uint8_t i = 0; i < MAX_INPUTS; i++) {
-            parts_received[i] = false;
-            inputs[i] = InputConfig();
-        }
+        inputs = &buffer;
+        inputs->clear();
     }
 
     // Add a configuration part from a Configure message
+    // Fails for an unknown input type or when the packed inputs run out of space
     bool addPart(const Protocol::Configure& cfg)
     {
         if (!active || cfg.part_number >= total_parts || cfg.part_number >= MAX_INPUTS) {
             return false;
         }
 
-        // Store the input configuration based on type
-        inputs[cfg.part_number].input_type = cfg.input_type;
-
-        switch (cfg.input_type) {
-        case Protocol::INPUT_TYPE_ANALOG:
-            inputs[cfg.part_number].analog.pin = cfg.analog.pin;
-            inputs[cfg.part_number].analog.sensitivity = cfg.analog.sensitivity;
-            break;
-
-        case Protocol::INPUT_TYPE_BUTTON:
-            inputs[cfg.part_number].button.pin = cfg.button.pin;
-            inputs[cfg.part_number].button.debounce = cfg.button.debounce;
-            break;
+        InputConfig input;
+        if (!toInputConfig(cfg, input)) {
+            return false;
+        }
 
-        case Protocol::INPUT_TYPE_MATRIX:
-            inputs[cfg.part_number].matrix.num_row_pins = cfg.matrix.num_row_pins;
-            inputs[cfg.part_number].matrix.num_col_pins = cfg.matrix.num_col_pins;
-            for (uint8_t i = 0; i < cfg.matrix.num_row_pins + cfg.matrix.num_col_pins; i++) {
-                inputs[cfg.part_number].matrix.pins[i] = cfg.matrix.pins[i];
+        // A resent part replaces the earlier copy
+        for (uint8_t i = 0; i < inputs->getNumInputs(); i++) {
+            if (part_numbers[i] == cfg.part_number) {
+                return inputs->replace(i, input);
             }
-            break;
-
-        default:
-            return false; // Unknown input type
         }
 
-        // Mark this part as received
-        if (!parts_received[cfg.part_number]) {
-            parts_received[cfg.part_number] = true;
-            received_parts++;
+        if (!inputs->append(input)) {
+            return false;
         }
-
+        part_numbers[inputs->getNumInputs() - 1] = cfg.part_number;
         return true;
     }
 
     // Check if configuration is complete
     bool isComplete() const
     {
-        return active && received_parts == total_parts;
+        return active && inputs->getNumInputs() == total_parts;
     }
 
     // Check if configuration has timed out
@@ -170,10 +421,24 @@ public:
         return config_id;
     }
 
-    // Get the inputs
-    const InputConfig* getInputs() const
+    // Put the received inputs in part order, in place
+    void sortInputs()
     {
-        return inputs;
+        for (uint8_t part = 0; part < inputs->getNumInputs(); part++) {
+            uint8_t i = part;
+            while (part_numbers[i] != part) {
+                i++;
+            }
+            if (i == part) {
+                continue; // Already in place (the usual case)
+            }
+
+            inputs->moveEarlier(i, part);
+            for (; i > part; i--) {
+                part_numbers[i] = part_numbers[i - 1];
+            }
+            part_numbers[part] = part;
+        }
     }
 
     // Get the number of inputs
@@ -182,13 +447,13 @@ public:
         return total_parts;
     }
 
-    // Reset the state
+    // Reset the state (the buffer is left as it is - it may have become the current configuration)
     void reset()
     {
         active = false;
         config_id = 0;
         total_parts = 0;
-        received_parts = 0;
+        inputs = nullptr;
     }
 
     // Check if there's an active configuration
@@ -202,12 +467,18 @@ public:
 extern ConfigState g_config_state;
 extern uint32_t g_current_config_id;
 
+// SRAM taken by the configuration manager: both images, the receive state, the
+// store header and the scalars around them (for the build-time SRAM check in main.cpp)
+constexpr size_t STATIC_RAM = 2 * sizeof(ConfigImage) + sizeof(ConfigState) + EEPROM_INPUTS_ADDR
+    + 6 * sizeof(uint32_t) + sizeof(void*);
+
 // Initialize configuration manager
 void init();
 
 // Handle a Configure message
 // Returns true if configuration is complete or error occurred
-// Sets complete=true if configuration is complete
+// Sets complete=true if configuration is complete (it is current from then on,
+// but only in RAM until storeCurrentConfig())
 // Sets error=true if configuration failed
 bool handleConfigure(const Protocol::Configure& cfg, bool& complete, bool& error);
 
@@ -215,8 +486,8 @@ bool handleConfigure(const Protocol::Configure& cfg, bool& complete, bool& error
 // Returns true if timeout occurred
 bool checkTimeout();
 
-// Store configuration to EEPROM
-void storeToEEPROM(uint32_t config_id, const InputConfig* inputs, uint8_t num_inputs);
+// Store configuration to EEPROM (blocking - the loop uses storeCurrentConfig())
+void storeToEEPROM(uint32_t config_id, const ConfigImage& inputs);
 
 // Load configuration from EEPROM
 // Returns true if valid configuration was loaded
@@ -226,6 +497,57 @@ bool loadFromEEPROM();
 uint32_t getCurrentConfigId();
 
 // Get current configuration
-const InputConfig* getCurrentConfig(uint8_t& num_inputs);
+const ConfigImage& getCurrentConfig();
+
+// Get the configuration that was current before the last one completed
+// (what the sensors were built from; valid until the next configuration starts)
+const ConfigImage& getPreviousConfig();
+
+// Make the previous configuration current again, with its ID (after the last one
+// to complete couldn't be applied)
+// Returns false if a configuration received since has overwritten it
+bool revertConfiguration();
+
+// How an input differs from another
+enum class InputChange : uint8_t {
+    Same, // Identical
+    Retune, // Analog inputs that differ only in dead_zone (a running sensor can take it over)
+    Different // Anything else - the sensor has to be rebuilt
+};
+
+// Compare the input at a_offset in a with the one at b_offset in b
+InputChange compareInputs(const ConfigImage& a, size_t a_offset, const ConfigImage& b, size_t b_offset);
+
+// Change the dead zone of an analog input in the current configuration (not persisted)
+// Returns false if the input doesn't exist or isn't analog
+bool setAnalogDeadZone(uint8_t index, uint8_t dead_zone);
+
+// Bytes written per updateStore() call: an AVR EEPROM byte takes ~3.3ms and a
+// Due flash byte a page write, so one per tick; ESP32 writes go to a RAM copy
+// that is committed to flash at the end
+#if defined(EEPROM_NEEDS_COMMIT)
+constexpr uint16_t STORE_WRITES_PER_TICK = 64;
+#else
+constexpr uint16_t STORE_WRITES_PER_TICK = 1;
+#endif
+
+// Progress of a background store
+enum class StoreStatus : uint8_t {
+    Idle, // Nothing being stored
+    Writing, // Still streaming to EEPROM
+    Stored, // Written and read back intact (reported once)
+    Failed // Read back differently, or not committed to flash (reported once)
+};
+
+// Persist the current configuration (e.g. after calibration changed it) in the
+// background: starts (or restarts) streaming it to EEPROM through updateStore()
+// A configuration completing meanwhile doesn't stop it, but one starting to be
+// received over the image being stored does (reported as Failed)
+void storeCurrentConfig();
+
+// Write the next bytes of a started store; call once per loop tick
+// Bytes that already hold the right value aren't rewritten, the magic number
+// is written last (a reset mid-way loads nothing), then everything is read back
+StoreStatus updateStore();
 
 } // namespace ConfigManager
@@ -9,4 +9,19 @@ constexpr uint8_t DEVICE_VERSION_PATCH = 1;
 
 // EEPROM format version - increment when EEPROM layout changes
 // Version 2: Added button and matrix input types with union-based storage
-constexpr uint8_t EEPROM_FORMAT_VERSION = 2;
+// Version 3: Added matrix flags byte (diode-less ghost suppression)
+// Version 4: Added analog oversample byte
+// Version 5: Added analog filter type and coefficient
+// Version 6: Added analog filter beta (One-Euro)
+// Version 7: Added analog median prefilter window
+// Version 8: Added analog dead zone (noise calibration)
+// Version 9: Added analog hysteresis band
+// Version 10: Added analog min/keepalive send intervals (ms)
+// Version 11: Added analog notch input type
+// Version 12: Added resistor ladder input type
+// Version 13: Added quadrature encoder input type
+// Version 14: Added button flags (eager debounce)
+// Version 15: Added button group input type
+// Version 16: Up to 64 inputs, packed input length stored after the input count
+// Version 17: Added button group debounce
+constexpr uint8_t EEPROM_FORMAT_VERSION = 17;
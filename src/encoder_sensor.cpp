@@ -0,0 +1,170 @@
+#include "encoder_sensor.h"
+#include "analog_send_policy.h"
+#include "pin_change.h"
+
+#if defined(ESP32_PLATFORM)
+#define ENCODER_ISR_ATTR IRAM_ATTR
+#else
+#define ENCODER_ISR_ATTR
+#endif
+
+namespace Sensor {
+
+// Transition table indexed by (previous AB << 2) | current AB
+// +1 = A leads B (clockwise on most encoders), -1 = B leads A, 0 = no change or invalid (both pins changed)
+static const int8_t QUADRATURE_TABLE[16] = {
+    0, -1, 1, 0,
+    1, 0, 0, -1,
+    -1, 0, 0, 1,
+    0, 1, -1, 0
+};
+
+// attachInterrupt() takes a plain function, so each slot gets its own trampoline
+static EncoderSensor* volatile g_isr_encoders[EncoderSensor::MAX_INTERRUPT_ENCODERS];
+
+template <uint8_t N>
+static void ENCODER_ISR_ATTR encoderIsr()
+{
+    EncoderSensor* encoder = g_isr_encoders[N];
+    if (encoder != nullptr) {
+        encoder->decode();
+    }
+}
+
+static void (*const ISR_TRAMPOLINES[EncoderSensor::MAX_INTERRUPT_ENCODERS])() = {
+    encoderIsr<0>, encoderIsr<1>, encoderIsr<2>, encoderIsr<3>
+};
+
+// A pin-change vector serves a whole port; a change on another pin decodes as 0
+static void decodePinChange(void* context)
+{
+    static_cast<EncoderSensor*>(context)->decode();
+}
+
+EncoderSensor::EncoderSensor(uint8_t pin_a_number, uint8_t pin_b_number, uint8_t detent_steps, uint8_t sensitivity_level)
+    : pin_a(pin_a_number)
+    , pin_b(pin_b_number)
+    , steps_per_detent(detent_steps == 0 ? 1 : detent_steps)
+    , min_interval_us(AnalogSendPolicy::computeMinInterval(sensitivity_level))
+    , isr_slot(NO_SLOT)
+    , via_pcint(false)
+    , ab_state(0)
+    , steps(0)
+    , pending(0)
+    , now_us(0)
+    , last_send_us(0)
+{
+}
+
+EncoderSensor::~EncoderSensor()
+{
+    release();
+}
+
+void EncoderSensor::release()
+{
+    if (via_pcint) {
+        PinChange::detach(this);
+        via_pcint = false;
+    }
+
+    if (isr_slot == NO_SLOT) {
+        return;
+    }
+
+    detachInterrupt(digitalPinToInterrupt(pin_a));
+    detachInterrupt(digitalPinToInterrupt(pin_b));
+    g_isr_encoders[isr_slot] = nullptr;
+    isr_slot = NO_SLOT;
+}
+
+void EncoderSensor::begin()
+{
+    release();
+
+    // Encoder contacts switch to GND
+    pinMode(pin_a, INPUT_PULLUP);
+    pinMode(pin_b, INPUT_PULLUP);
+
+    // Reset state
+    ab_state = (uint8_t)((digitalRead(pin_a) ? 2 : 0) | (digitalRead(pin_b) ? 1 : 0));
+    steps = 0;
+    pending = 0;
+    now_us = micros();
+    last_send_us = now_us;
+
+    if (!attachDecode()) {
+        // Fall back to the port's pin-change interrupt (AVR); one pin alone isn't enough
+        via_pcint = PinChange::attach(pin_a, decodePinChange, this) && PinChange::attach(pin_b, decodePinChange, this);
+        if (!via_pcint) {
+            PinChange::detach(this); // Polled
+        }
+    }
+}
+
+bool EncoderSensor::attachDecode()
+{
+    // Decode from external interrupts when both pins have one and a trampoline is free
+    if (digitalPinToInterrupt(pin_a) == NOT_AN_INTERRUPT || digitalPinToInterrupt(pin_b) == NOT_AN_INTERRUPT) {
+        return false;
+    }
+    for (uint8_t slot = 0; slot < MAX_INTERRUPT_ENCODERS; slot++) {
+        if (g_isr_encoders[slot] == nullptr) {
+            isr_slot = slot;
+            g_isr_encoders[slot] = this;
+            attachInterrupt(digitalPinToInterrupt(pin_a), ISR_TRAMPOLINES[slot], CHANGE);
+            attachInterrupt(digitalPinToInterrupt(pin_b), ISR_TRAMPOLINES[slot], CHANGE);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ENCODER_ISR_ATTR EncoderSensor::decode()
+{
+    uint8_t current = (uint8_t)((digitalRead(pin_a) ? 2 : 0) | (digitalRead(pin_b) ? 1 : 0));
+    steps = (int16_t)(steps + QUADRATURE_TABLE[(ab_state << 2) | current]);
+    ab_state = current;
+}
+
+void EncoderSensor::scan()
+{
+    if (!isInterruptDriven()) {
+        decode();
+    }
+
+    // Take the ISR's count atomically (16-bit access isn't atomic on AVR)
+    noInterrupts();
+    int16_t collected = steps;
+    steps = 0;
+    interrupts();
+
+    pending += collected;
+    now_us = micros();
+
+    bool whole_detent = pending >= steps_per_detent || pending <= -(int32_t)steps_per_detent;
+    if (whole_detent && (now_us - last_send_us) >= min_interval_us) {
+        markReady();
+    }
+}
+
+Reading EncoderSensor::getReading()
+{
+    // Whole detents only - a partial detent waits for the rest of its transitions
+    int32_t detents = pending / steps_per_detent;
+    if (detents == 0 || (now_us - last_send_us) < min_interval_us) {
+        return Reading();
+    }
+
+    if (detents > INT16_MAX) {
+        detents = INT16_MAX;
+    } else if (detents < INT16_MIN) {
+        detents = INT16_MIN;
+    }
+
+    pending -= detents * steps_per_detent;
+    last_send_us = now_us;
+    return Reading((int16_t)detents, InputType::Encoder, pin_a);
+}
+
+} // namespace Sensor
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "sensor.h"
+#include <Arduino.h>
+
+namespace Sensor {
+
+// Quadrature rotary encoder sensor implementation
+// Decodes A/B transitions with a state-table decoder from CHANGE interrupts on
+// both pins (invalid transitions from bounce count as 0), so steps between scans
+// aren't missed. On AVR, pins without an external interrupt (or beyond the
+// trampolines) use the shared PinChange dispatch; only when that is unavailable
+// too does decoding fall back to once per scan. Steps accumulate atomically and
+// are reported as a signed detent delta (InputValue) no faster than the
+// sensitivity's send interval.
+class EncoderSensor : public ISensor {
+public:
+    // Encoders that can use attachInterrupt at once (one ISR trampoline each)
+    static constexpr uint8_t MAX_INTERRUPT_ENCODERS = 4;
+    static constexpr uint8_t NO_SLOT = 0xFF;
+
+private:
+    uint8_t pin_a; // Encoder A pin (also the reported pin)
+    uint8_t pin_b; // Encoder B pin
+    uint8_t steps_per_detent; // Transitions per reported step (1, 2 or 4 for most encoders)
+    uint32_t min_interval_us; // Minimum time between reports
+    uint8_t isr_slot; // Interrupt trampoline slot (NO_SLOT = not attached)
+    bool via_pcint; // Both pins registered with PinChange (AVR pin-change interrupt)
+
+    // Shared with the ISR
+    volatile uint8_t ab_state; // Last A/B levels (bit 1 = A, bit 0 = B)
+    volatile int16_t steps; // Transitions decoded since the last scan
+
+    // Reporting state
+    int32_t pending; // Transitions collected but not yet reported
+    uint32_t now_us; // Timestamp of the last scan
+    uint32_t last_send_us; // Timestamp of the last report
+
+public:
+    EncoderSensor(uint8_t pin_a_number, uint8_t pin_b_number, uint8_t detent_steps, uint8_t sensitivity_level);
+    ~EncoderSensor() override;
+
+    // ISensor interface implementation
+    void begin() override;
+    void scan() override;
+    Reading getReading() override;
+    InputType getType() const override { return InputType::Encoder; }
+    uint8_t getPin() const override { return pin_a; }
+
+    // Read both pins and accumulate the transition (called from the ISR)
+    void decode();
+
+    // True if decoding runs from interrupts
+    bool isInterruptDriven() const { return isr_slot != NO_SLOT || via_pcint; }
+
+private:
+    bool attachDecode();
+    void release();
+};
+
+} // namespace Sensor
@@ -0,0 +1,135 @@
+#include "i2c_expander_sensor.h"
+
+namespace Sensor {
+
+I2CExpanderSensor::I2CExpanderSensor(uint8_t chip_type, uint8_t i2c_address, uint8_t int_pin_number, uint16_t input_id_base)
+    : chip(chip_type)
+    , address(i2c_address)
+    , int_pin(int_pin_number)
+    , id_base(input_id_base)
+    , next_port(0)
+    , last_read_us(0)
+{
+    pending[0] = 0;
+    pending[1] = 0;
+}
+
+void I2CExpanderSensor::begin()
+{
+    Wire.begin();
+    Wire.setClock(I2C_CLOCK_HZ);
+
+    // INT is open-drain on both chips
+    if (int_pin != Protocol::EXPANDER_NO_INT_PIN) {
+        pinMode(int_pin, INPUT_PULLUP);
+    }
+
+    if (chip == Protocol::EXPANDER_CHIP_MCP23017) {
+        // IOCON first: with SEQOP set, pair writes and reads toggle between A and B
+        Wire.beginTransmission(address);
+        Wire.write(MCP_IOCON);
+        Wire.write(MCP_IOCON_VALUE);
+        Wire.endTransmission();
+
+        writeRegisterPair(MCP_IODIRA, 0xFF, 0xFF); // All inputs
+        writeRegisterPair(MCP_GPPUA, 0xFF, 0xFF); // Internal pullups
+        writeRegisterPair(MCP_GPINTENA, 0xFF, 0xFF); // Interrupt on change
+
+        // Leave the register pointer on GPIOA so reads need no address write
+        Wire.beginTransmission(address);
+        Wire.write(MCP_GPIOA);
+        Wire.endTransmission();
+    } else {
+        // PCF8575 quasi-bidirectional pins: writing 1 makes them weak-pullup inputs
+        Wire.beginTransmission(address);
+        Wire.write((uint8_t)0xFF);
+        Wire.write((uint8_t)0xFF);
+        Wire.endTransmission();
+    }
+
+    // Reset state
+    debouncers[0].reset();
+    debouncers[1].reset();
+    pending[0] = 0;
+    pending[1] = 0;
+    next_port = 0;
+    last_read_us = micros() - SAFETY_POLL_US; // Read on the first scan
+}
+
+bool I2CExpanderSensor::shouldRead() const
+{
+    // No INT line wired: plain polling
+    if (int_pin == Protocol::EXPANDER_NO_INT_PIN) {
+        return true;
+    }
+
+    // Debounce needs consecutive samples even after INT has been cleared
+    if (debouncers[0].isSettling() || debouncers[1].isSettling()) {
+        return true;
+    }
+
+    // Slow safety poll covers edges lost on a shared INT line
+    if (micros() - last_read_us >= SAFETY_POLL_US) {
+        return true;
+    }
+
+    // INT is active LOW and stays asserted until the port is read
+    return digitalRead(int_pin) == LOW;
+}
+
+void I2CExpanderSensor::scan()
+{
+    if (!shouldRead()) {
+        return;
+    }
+
+    uint8_t port_a;
+    uint8_t port_b;
+    if (!readPorts(port_a, port_b)) {
+        return; // Device didn't answer - keep the last debounced state
+    }
+    last_read_us = micros();
+
+    // Inputs are active LOW (switch to GND against pullups)
+    pending[0] |= debouncers[0].update((uint8_t)~port_a);
+    pending[1] |= debouncers[1].update((uint8_t)~port_b);
+    if ((pending[0] | pending[1]) != 0) {
+        markReady();
+    }
+}
+
+bool I2CExpanderSensor::readPorts(uint8_t& port_a, uint8_t& port_b)
+{
+    if (Wire.requestFrom(address, (uint8_t)2) < 2) {
+        return false;
+    }
+
+    port_a = (uint8_t)Wire.read();
+    port_b = (uint8_t)Wire.read();
+    return true;
+}
+
+void I2CExpanderSensor::writeRegisterPair(uint8_t reg, uint8_t value_a, uint8_t value_b)
+{
+    Wire.beginTransmission(address);
+    Wire.write(reg);
+    Wire.write(value_a);
+    Wire.write(value_b);
+    Wire.endTransmission();
+}
+
+Reading I2CExpanderSensor::getReading()
+{
+    uint8_t index;
+    if (!takePendingBit(pending, 2, next_port, index)) {
+        return Reading(); // No events to report
+    }
+
+    // value = 1 for press, 0 for release
+    uint8_t mask = (uint8_t)(1 << (index % 8));
+    int16_t value = (debouncers[index / 8].getState() & mask) ? 1 : 0;
+
+    return Reading(value, InputType::I2CExpander, (uint16_t)(id_base + index));
+}
+
+} // namespace Sensor
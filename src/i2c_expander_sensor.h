@@ -0,0 +1,73 @@
+#pragma once
+
+#include "protocol.h"
+#include "sensor.h"
+#include "vertical_debounce.h"
+#include <Arduino.h>
+#include <Wire.h>
+
+namespace Sensor {
+
+// I2C GPIO expander sensor implementation (MCP23017 / PCF8575, 16 inputs)
+// The bus is only touched when the expander's INT line is asserted, while a
+// debounce is in progress, or on a slow safety poll - an idle panel costs one
+// digitalRead per scan. Each read is a single 2-byte transaction: the MCP23017
+// runs in byte mode so its register pointer toggles between GPIOA and GPIOB and
+// never needs rewriting; the PCF8575 has no registers at all.
+// Inputs are active LOW and reported with extended input IDs: id_base + index,
+// where index 0-7 = port A (P00-P07) and 8-15 = port B (P10-P17).
+class I2CExpanderSensor : public ISensor {
+public:
+    // Number of inputs per expander
+    static constexpr uint8_t NUM_INPUTS = 16;
+
+    // Read anyway when INT has been idle this long, in case an edge was missed
+    static constexpr uint32_t SAFETY_POLL_US = 500000;
+
+    // I2C bus speed (both chips support fast mode)
+    static constexpr uint32_t I2C_CLOCK_HZ = 400000;
+
+    // MCP23017 registers (IOCON.BANK = 0, A/B registers interleaved)
+    static constexpr uint8_t MCP_IODIRA = 0x00;
+    static constexpr uint8_t MCP_GPINTENA = 0x04;
+    static constexpr uint8_t MCP_IOCON = 0x0A;
+    static constexpr uint8_t MCP_GPPUA = 0x0C;
+    static constexpr uint8_t MCP_GPIOA = 0x12;
+
+    // IOCON: MIRROR (one INT for both ports) | SEQOP (byte mode) | ODR (open-drain, shareable INT)
+    static constexpr uint8_t MCP_IOCON_VALUE = 0x64;
+
+private:
+    uint8_t chip; // Protocol::EXPANDER_CHIP_*
+    uint8_t address; // 7-bit I2C address
+    uint8_t int_pin; // INT line, or Protocol::EXPANDER_NO_INT_PIN
+    uint16_t id_base; // Extended input ID of input 0
+
+    // State (byte 0 = port A, byte 1 = port B)
+    VerticalDebouncer debouncers[2];
+    uint8_t pending[2]; // Bits with an unreported debounced change
+    uint8_t next_port; // Port to resume reporting from
+    uint32_t last_read_us; // micros() of the last bus read
+
+public:
+    I2CExpanderSensor(uint8_t chip_type, uint8_t i2c_address, uint8_t int_pin_number, uint16_t input_id_base);
+
+    // ISensor interface implementation
+    void begin() override;
+    void scan() override;
+    Reading getReading() override;
+    InputType getType() const override { return InputType::I2CExpander; }
+    uint8_t getPin() const override { return address; }
+
+private:
+    // Check if the bus needs to be read this scan
+    bool shouldRead() const;
+
+    // Read both ports in one transaction (returns false if the device didn't answer)
+    bool readPorts(uint8_t& port_a, uint8_t& port_b);
+
+    // Write an MCP23017 A/B register pair
+    void writeRegisterPair(uint8_t reg, uint8_t value_a, uint8_t value_b);
+};
+
+} // namespace Sensor
@@ -1,3 +1,4 @@
+#include "adc_engine.h"
 #include "config_manager.h"
 #include "message_handler.h"
 #include "output_manager.h"
@@ -6,7 +7,20 @@
 #include <PacketSerial.h>
 
 // Global packet serial instance
-PacketSerial_<COBS> g_packet_serial;
+MessageHandler::PacketSerialPort g_packet_serial;
+
+#if defined(__AVR__) && defined(RAMSTART) && defined(RAMEND)
+// Build-time SRAM check: the large globals are counted from their types; the
+// small ones (interrupt and pin-change tables, heartbeat and message state, the
+// core's timer counters) get OTHER_GLOBALS_RAM, and the stack gets STACK_RESERVE
+// for its deepest path (a reconfiguration comparing inputs, under an interrupt)
+constexpr size_t OTHER_GLOBALS_RAM = 128;
+constexpr size_t STACK_RESERVE = 320;
+static_assert(ConfigManager::STATIC_RAM + SensorManager::STATIC_RAM + AdcEngine::STATIC_RAM + sizeof(Serial)
+            + sizeof(g_packet_serial) + OTHER_GLOBALS_RAM + STACK_RESERVE
+        <= RAMEND - RAMSTART + 1,
+    "Globals and stack don't fit in SRAM - lower MAX_INPUTS, CONFIG_IMAGE_SIZE or SENSOR_ARENA_SIZE");
+#endif
 
 // Forward declaration for packet callback
 void onPacketReceived(const uint8_t* buffer, size_t size);
@@ -24,9 +38,7 @@ void setup()
     MessageHandler::init(&g_packet_serial);
 
     // Apply loaded configuration to sensors
-    uint8_t num_inputs = 0;
-    const ConfigManager::InputConfig* inputs = ConfigManager::getCurrentConfig(num_inputs);
-    SensorManager::applyConfiguration(inputs, num_inputs);
+    SensorManager::applyConfiguration(ConfigManager::getCurrentConfig());
 }
 
 void loop()
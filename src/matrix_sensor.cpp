@@ -4,12 +4,15 @@
 namespace Sensor {
 
 MatrixSensor::MatrixSensor(uint8_t rows, uint8_t cols,
-                           const uint8_t* row_pin_array, const uint8_t* col_pin_array)
+                           const uint8_t* row_pin_array, const uint8_t* col_pin_array,
+                           bool diodes, bool eager)
     : num_rows(rows < MAX_ROWS ? rows : MAX_ROWS)
     , num_cols(cols < MAX_COLS ? cols : MAX_COLS)
     , queue_head(0)
     , queue_tail(0)
     , debounce_threshold(DEFAULT_DEBOUNCE)
+    , has_diodes(diodes)
+    , eager_debounce(eager)
 {
     // Copy pin arrays
     for (uint8_t i = 0; i < num_rows; i++) {
@@ -48,6 +51,9 @@ void MatrixSensor::begin()
 
 void MatrixSensor::scan()
 {
+    // Raw bitmap of this scan (bit c of raw_rows[r] = key (r, c) reads pressed)
+    uint8_t raw_rows[MAX_ROWS];
+
     // Scan each row
     for (uint8_t row = 0; row < num_rows; row++) {
         // Activate current row (drive LOW)
@@ -57,21 +63,82 @@ void MatrixSensor::scan()
         delayMicroseconds(10);
 
         // Read all columns
+        raw_rows[row] = 0;
         for (uint8_t col = 0; col < num_cols; col++) {
             // Button is pressed if column reads LOW (pulled down by row)
-            bool raw_pressed = (digitalRead(col_pins[col]) == LOW);
-            scanButton(row, col, raw_pressed);
+            if (digitalRead(col_pins[col]) == LOW) {
+                raw_rows[row] |= (uint8_t)(1 << col);
+            }
         }
 
         // Deactivate row (drive HIGH)
         digitalWrite(row_pins[row], HIGH);
     }
+
+    // Without diodes, keys on a rectangle corner can't be told apart from phantoms
+    uint8_t ghost_rows[MAX_ROWS];
+    if (has_diodes) {
+        memset(ghost_rows, 0, sizeof(ghost_rows));
+    } else {
+        computeGhostMask(raw_rows, num_rows, ghost_rows);
+    }
+
+    // Debounce each button
+    for (uint8_t row = 0; row < num_rows; row++) {
+        for (uint8_t col = 0; col < num_cols; col++) {
+            uint8_t bit = (uint8_t)(1 << col);
+            bool raw_pressed = (raw_rows[row] & bit) != 0;
+
+            // Ambiguous keys hold their debounced state so phantoms never go out
+            if (ghost_rows[row] & bit) {
+                raw_pressed = current_state[buttonIndex(row, col)];
+            }
+
+            scanButton(row, col, raw_pressed);
+        }
+    }
+}
+
+void MatrixSensor::computeGhostMask(const uint8_t* raw_rows, uint8_t rows, uint8_t* ghost_rows)
+{
+    for (uint8_t r = 0; r < rows; r++) {
+        ghost_rows[r] = 0;
+    }
+
+    // Two rows sharing two or more pressed columns form a rectangle: in a
+    // diode-less matrix any three corners light up the fourth, so all four
+    // corners are ambiguous. Current paths through more keys show up the
+    // same way, as every connected row reads the same column set.
+    for (uint8_t r = 0; r < rows; r++) {
+        for (uint8_t other = r + 1; other < rows; other++) {
+            uint8_t shared = raw_rows[r] & raw_rows[other];
+            if (shared & (uint8_t)(shared - 1)) { // At least two bits set
+                ghost_rows[r] |= shared;
+                ghost_rows[other] |= shared;
+            }
+        }
+    }
 }
 
 void MatrixSensor::scanButton(uint8_t row, uint8_t col, bool raw_pressed)
 {
     uint8_t idx = buttonIndex(row, col);
 
+    if (eager_debounce) {
+        // Eager debounce: first differing reading wins, then the key is locked out
+        if (debounce_count[idx] > 0) {
+            debounce_count[idx]--;
+        } else if (raw_pressed != current_state[idx]) {
+            current_state[idx] = raw_pressed;
+            debounce_count[idx] = debounce_threshold;
+
+            if (current_state[idx] != last_reported[idx]) {
+                enqueueEvent(idx, current_state[idx]);
+            }
+        }
+        return;
+    }
+
     // Counter-based debounce algorithm
     if (raw_pressed == current_state[idx]) {
         // Reading matches current state, reset counter
@@ -108,6 +175,7 @@ void MatrixSensor::enqueueEvent(uint8_t button_index, bool pressed)
     event_queue[queue_tail].button_index = button_index;
     event_queue[queue_tail].pressed = pressed;
     queue_tail = next_tail;
+    markReady();
 }
 
 Reading MatrixSensor::getReading()
@@ -6,9 +6,11 @@
 namespace Sensor {
 
 // Matrix sensor implementation
-// Uses row/column scanning with per-button debouncing
+// Uses row/column scanning with per-button debouncing (counter or eager)
 // Reports edge events for each button with virtual pin scheme
-class MatrixSensor : public ISensor {
+// Diode-less matrices get on-device ghost suppression: keys that form a
+// rectangle in the raw bitmap are ambiguous and hold their previous state
+class MatrixSensor final : public ISensor {
 public:
     // Maximum matrix size (to avoid dynamic allocation)
     static constexpr uint8_t MAX_ROWS = 8;
@@ -33,7 +35,7 @@ private:
     // Per-button state
     bool current_state[MAX_BUTTONS];    // Debounced state (true = pressed)
     bool last_reported[MAX_BUTTONS];    // Last reported state
-    uint8_t debounce_count[MAX_BUTTONS]; // Debounce counter per button
+    uint8_t debounce_count[MAX_BUTTONS]; // Debounce counter per button (lockout scans left in eager mode)
 
     // Event queue for NKRO support
     struct PendingEvent {
@@ -47,9 +49,16 @@ private:
     // Debounce threshold
     uint8_t debounce_threshold;
 
+    // True if every switch has a series diode (no ghosting possible)
+    bool has_diodes;
+
+    // True to report each key's first edge and lock it out for debounce_threshold scans
+    bool eager_debounce;
+
 public:
     MatrixSensor(uint8_t rows, uint8_t cols,
-                 const uint8_t* row_pin_array, const uint8_t* col_pin_array);
+                 const uint8_t* row_pin_array, const uint8_t* col_pin_array,
+                 bool diodes = true, bool eager = false);
 
     // ISensor interface implementation
     void begin() override;
@@ -58,6 +67,10 @@ public:
     InputType getType() const override { return InputType::Matrix; }
     uint8_t getPin() const override { return VIRTUAL_PIN_BASE; } // Base pin identifier
 
+    // Compute ambiguous (possibly phantom) keys from a raw row bitmap
+    // raw_rows[r] bit c = key (r, c) reads pressed; ghost_rows receives the mask
+    static void computeGhostMask(const uint8_t* raw_rows, uint8_t rows, uint8_t* ghost_rows);
+
 private:
     // Scan a single button and handle debouncing
     void scanButton(uint8_t row, uint8_t col, bool raw_pressed);
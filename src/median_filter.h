@@ -0,0 +1,91 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace Sensor {
+
+// Median-of-3/5 spike rejection for a single analog value
+// Keeps the last N samples and returns their median, computed with a fixed
+// compare-exchange network (no data-dependent branches, constant time).
+// A single-sample spike never reaches the output; a real step is delayed by (N - 1) / 2 samples.
+class MedianFilter {
+public:
+    static constexpr uint8_t MAX_WINDOW = 5;
+
+private:
+    uint8_t window; // 0 (off), 3 or 5
+    uint8_t next; // Ring buffer write index
+    bool primed; // False until the first sample fills the history
+    uint16_t history[MAX_WINDOW];
+
+public:
+    explicit MedianFilter(uint8_t window_size = 0)
+        : window((window_size == 3 || window_size == 5) ? window_size : 0)
+        , next(0)
+        , primed(false)
+    {
+    }
+
+    void reset()
+    {
+        primed = false;
+    }
+
+    // Window size (0 = off)
+    uint8_t getWindow() const { return window; }
+
+    // Add a sample and return the median of the window
+    uint16_t apply(uint16_t sample)
+    {
+        if (window == 0) {
+            return sample;
+        }
+
+        // Seed the whole window so start-up doesn't look like a spike
+        if (!primed) {
+            for (uint8_t i = 0; i < window; i++) {
+                history[i] = sample;
+            }
+            next = 0;
+            primed = true;
+        }
+
+        history[next] = sample;
+        next = (next + 1 < window) ? (uint8_t)(next + 1) : 0;
+
+        uint16_t v0 = history[0];
+        uint16_t v1 = history[1];
+        uint16_t v2 = history[2];
+
+        if (window == 3) {
+            sort2(v0, v1);
+            sort2(v1, v2);
+            sort2(v0, v1);
+            return v1;
+        }
+
+        // Median-of-5 network (7 compare-exchanges)
+        uint16_t v3 = history[3];
+        uint16_t v4 = history[4];
+        sort2(v0, v1);
+        sort2(v3, v4);
+        sort2(v0, v3);
+        sort2(v1, v4);
+        sort2(v1, v2);
+        sort2(v2, v3);
+        sort2(v1, v2);
+        return v2;
+    }
+
+private:
+    // Branch-free compare-exchange: afterwards a <= b
+    static inline void sort2(uint16_t& a, uint16_t& b)
+    {
+        uint16_t mask = (uint16_t)-(uint16_t)(b < a); // All ones if swap needed
+        uint16_t diff = (uint16_t)((a ^ b) & mask);
+        a ^= diff;
+        b ^= diff;
+    }
+};
+
+} // namespace Sensor
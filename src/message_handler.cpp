@@ -7,10 +7,70 @@
 namespace MessageHandler {
 
 // Global packet serial instance
-static PacketSerial_<COBS>* g_packet_serial = nullptr;
+static PacketSerialPort* g_packet_serial = nullptr;
 
-// Heartbeat manager
-static Heartbeat::HeartbeatManager* g_heartbeat_manager = nullptr;
+// Heartbeat manager (static - nothing is allocated at runtime)
+static Heartbeat::HeartbeatManager g_heartbeat_manager(HEARTBEAT_INTERVAL_MS, sendHeartbeat);
+
+// A completed configuration is swapped in at the next tick boundary, and stored
+// to EEPROM in the background once the sensors running it have been scanned
+static bool g_apply_pending = false;
+static bool g_store_pending = false;
+static bool g_reply_pending = false; // Answer the host when the store finishes
+static uint32_t g_reply_config_id = 0; // Configuration being stored
+
+// Switch the sensors to the current configuration, keeping unchanged ones
+static void applyPendingConfiguration()
+{
+    g_apply_pending = false;
+    g_store_pending = SensorManager::updateConfiguration(
+        ConfigManager::getCurrentConfig(), ConfigManager::getPreviousConfig());
+
+    if (!g_store_pending) {
+        // Rejected before anything was torn down: the sensors keep running the
+        // previous configuration, which becomes current again (not stored, so the
+        // next boot loads the last configuration that ran)
+        uint32_t rejected_id = ConfigManager::getCurrentConfigId();
+        ConfigManager::revertConfiguration();
+        sendConfigurationError(rejected_id);
+    }
+}
+
+// Start storing the configuration the sensors now run
+static void startStore()
+{
+    g_store_pending = false;
+
+    // A store still in progress is abandoned: its configuration was superseded
+    // before it was persisted
+    if (g_reply_pending) {
+        g_reply_pending = false;
+        sendConfigurationError(g_reply_config_id);
+    }
+
+    ConfigManager::storeCurrentConfig();
+    g_reply_pending = true;
+    g_reply_config_id = ConfigManager::getCurrentConfigId();
+}
+
+// Write the next bytes of a background store, answering the host once it's done
+static void updateStore()
+{
+    ConfigManager::StoreStatus status = ConfigManager::updateStore();
+    if (!g_reply_pending
+        || (status != ConfigManager::StoreStatus::Stored && status != ConfigManager::StoreStatus::Failed)) {
+        return;
+    }
+
+    g_reply_pending = false;
+    if (status == ConfigManager::StoreStatus::Failed) {
+        sendConfigurationError(g_reply_config_id); // Running, but not persisted
+        return;
+    }
+
+    sendConfigurationStored(g_reply_config_id);
+    sendInputResolutions();
+}
 
 // Template implementation - sends any protocol message and notifies heartbeat
 template <typename T>
@@ -26,19 +86,14 @@ void sendMessage(const T& message)
     if (encoded_size > 0) {
         g_packet_serial->send(buffer, encoded_size);
 
-        // Notify heartbeat manager if initialized
-        if (g_heartbeat_manager) {
-            g_heartbeat_manager->notifyMessageSent(millis());
-        }
+        // Notify heartbeat manager
+        g_heartbeat_manager.notifyMessageSent(millis());
     }
 }
 
-void init(PacketSerial_<COBS>* serial)
+void init(PacketSerialPort* serial)
 {
     g_packet_serial = serial;
-
-    // Initialize heartbeat manager with 2 second interval and callback
-    g_heartbeat_manager = new Heartbeat::HeartbeatManager(HEARTBEAT_INTERVAL_MS, sendHeartbeat);
 }
 
 void onPacketReceived(const uint8_t* buffer, size_t size)
@@ -57,33 +112,53 @@ void onPacketReceived(const uint8_t* buffer, size_t size)
         handleConfigure(msg.configure);
     } else if (msg.isSetOutput()) {
         handleSetOutput(msg.set_output);
+    } else if (msg.isCalibrateNoise()) {
+        handleCalibrateNoise(msg.calibrate_noise);
     }
 }
 
 void update()
 {
     // Update heartbeat manager (automatically sends heartbeat if needed)
-    g_heartbeat_manager->update(millis());
+    g_heartbeat_manager.update(millis());
 
     // Check for configuration timeout
     if (ConfigManager::checkTimeout()) {
         sendConfigurationError(ConfigManager::g_config_state.getConfigId());
     }
 
+    // Swap in a completed configuration between two scans
+    if (g_apply_pending) {
+        applyPendingConfiguration();
+    }
+
     // Scan all sensors
     SensorManager::scan();
 
+    if (SensorManager::noiseCalibrationComplete()) {
+        finishNoiseCalibration();
+    }
+
     // Check for sensor readings and send them
     Sensor::Reading reading;
     while (SensorManager::getNextReading(reading)) {
         sendInputValue(reading);
     }
+
+    // Persist a new configuration after its first tick, not in front of it
+    if (g_store_pending) {
+        startStore();
+    }
+    updateStore();
 }
 
 void handleIdentityRequest(uint32_t request_id)
 {
     uint32_t config_id = ConfigManager::getCurrentConfigId();
     sendIdentityResponse(request_id, config_id);
+
+    // A host that skips configuring (matching config_id) still needs the resolutions
+    sendInputResolutions();
 }
 
 void handleConfigure(const Protocol::Configure& cfg)
@@ -94,12 +169,8 @@ void handleConfigure(const Protocol::Configure& cfg)
     ConfigManager::handleConfigure(cfg, complete, error);
 
     if (complete) {
-        // Apply configuration to sensors
-        uint8_t num_inputs = 0;
-        const ConfigManager::InputConfig* inputs = ConfigManager::getCurrentConfig(num_inputs);
-        SensorManager::applyConfiguration(inputs, num_inputs);
-
-        sendConfigurationStored(cfg.config_id);
+        // Applied to the sensors by the next update(), then stored
+        g_apply_pending = true;
     } else if (error) {
         sendConfigurationError(cfg.config_id);
     }
@@ -110,6 +181,11 @@ void handleSetOutput(const Protocol::SetOutput& cmd)
     OutputManager::setOutput(cmd.pin, cmd.value);
 }
 
+void handleCalibrateNoise(const Protocol::CalibrateNoise& cmd)
+{
+    SensorManager::startNoiseCalibration(cmd.scans);
+}
+
 void sendIdentityResponse(uint32_t request_id, uint32_t config_id)
 {
     Protocol::IdentityResponse response;
@@ -140,13 +216,89 @@ void sendConfigurationError(uint32_t config_id)
 
 void sendInputValue(const Sensor::Reading& reading)
 {
+    // Inputs that don't fit a pin number use the extended message
+    if (reading.pin >= Protocol::EXTENDED_ID_BASE) {
+        Protocol::InputValueExtended input_value;
+        input_value.input_id = reading.pin;
+        input_value.value = reading.value;
+
+        sendMessage(input_value);
+        return;
+    }
+
     Protocol::InputValue input_value;
-    input_value.pin = reading.pin;
+    input_value.pin = (uint8_t)reading.pin;
     input_value.value = reading.value;
 
     sendMessage(input_value);
 }
 
+void sendInputResolutions()
+{
+    const ConfigManager::ConfigImage& inputs = ConfigManager::getCurrentConfig();
+    ConfigManager::InputConfig input;
+    size_t offset = 0;
+
+    // Only oversampled analog inputs differ from the 10-bit default
+    for (uint8_t i = 0; i < inputs.getNumInputs(); i++) {
+        offset = inputs.read(offset, input);
+        if (input.input_type != Protocol::INPUT_TYPE_ANALOG || input.analog.oversample == 0) {
+            continue;
+        }
+
+        Protocol::InputResolution resolution;
+        resolution.pin = input.analog.pin;
+        resolution.bits = (uint8_t)(Protocol::ANALOG_BASE_BITS + input.analog.oversample);
+        sendMessage(resolution);
+    }
+}
+
+void finishNoiseCalibration()
+{
+    const ConfigManager::ConfigImage& inputs = ConfigManager::getCurrentConfig();
+    ConfigManager::InputConfig input;
+    size_t offset = 0;
+    bool changed = false;
+
+    for (uint8_t i = 0; i < inputs.getNumInputs(); i++) {
+        // Changing a dead zone keeps the input's size, so offset stays valid
+        offset = inputs.read(offset, input);
+        if (input.input_type != Protocol::INPUT_TYPE_ANALOG) {
+            continue;
+        }
+
+        Sensor::AnalogSensor* sensor = SensorManager::findAnalogSensor(input.analog.pin);
+        if (sensor == nullptr) {
+            continue;
+        }
+
+        const Sensor::NoiseStats& noise = sensor->stopNoiseCalibration();
+        uint8_t dead_zone = noise.deadZone();
+
+        // Apply immediately and keep it with the configuration
+        if (dead_zone != 0 && dead_zone != input.analog.dead_zone) {
+            sensor->setDeadZone(dead_zone);
+            ConfigManager::setAnalogDeadZone(i, dead_zone);
+            input.analog.dead_zone = dead_zone;
+            changed = true;
+        }
+
+        Protocol::NoiseStats stats;
+        stats.pin = input.analog.pin;
+        stats.samples = noise.samples;
+        stats.min_value = noise.min_value;
+        stats.max_value = noise.max_value;
+        stats.dead_zone = input.analog.dead_zone;
+        sendMessage(stats);
+    }
+
+    // Persist only if something moved (saves EEPROM wear on repeat calibrations)
+    if (changed) {
+        SensorManager::adoptConfiguration(inputs);
+        ConfigManager::storeCurrentConfig();
+    }
+}
+
 void sendHeartbeat()
 {
     Protocol::Heartbeat heartbeat;
@@ -8,11 +8,16 @@
 
 namespace MessageHandler {
 
+// COBS packet interface to the host, with a receive buffer sized for the
+// largest incoming message plus its COBS overhead byte (the library's default
+// is 256 bytes, an eighth of a small AVR's SRAM)
+typedef PacketSerial_<COBS, 0, Protocol::MAX_PAYLOAD_SIZE + 1> PacketSerialPort;
+
 // Heartbeat interval in milliseconds
 constexpr unsigned long HEARTBEAT_INTERVAL_MS = 2000;
 
 // Initialize message handler
-void init(PacketSerial_<COBS>* serial);
+void init(PacketSerialPort* serial);
 
 // Main packet received callback
 void onPacketReceived(const uint8_t* buffer, size_t size);
@@ -24,6 +29,7 @@ void update();
 void handleIdentityRequest(uint32_t request_id);
 void handleConfigure(const Protocol::Configure& cfg);
 void handleSetOutput(const Protocol::SetOutput& cmd);
+void handleCalibrateNoise(const Protocol::CalibrateNoise& cmd);
 
 // Internal helper - sends a message and notifies heartbeat manager
 // Template function to handle any protocol message type
@@ -35,6 +41,8 @@ void sendIdentityResponse(uint32_t request_id, uint32_t config_id);
 void sendConfigurationStored(uint32_t config_id);
 void sendConfigurationError(uint32_t config_id);
 void sendInputValue(const Sensor::Reading& reading);
+void sendInputResolutions();
+void finishNoiseCalibration();
 void sendHeartbeat();
 
 } // namespace MessageHandler
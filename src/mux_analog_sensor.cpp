@@ -0,0 +1,177 @@
+#include "mux_analog_sensor.h"
+#include "adc_engine.h"
+
+namespace Sensor {
+
+static void captureSample(void* context, uint16_t sample)
+{
+    static_cast<MuxAnalogSensor*>(context)->capture(sample);
+}
+
+MuxAnalogSensor::MuxAnalogSensor(uint8_t adc_pin_number, uint8_t sensitivity_level, uint8_t channel_count,
+                                 uint8_t settle_time_us, const uint8_t* select_pin_array, uint16_t input_id_base)
+    : adc_pin(adc_pin_number)
+    , num_channels(channel_count == 0 ? 1 : (channel_count < MAX_CHANNELS ? channel_count : MAX_CHANNELS))
+    , num_select_pins(0)
+    , settle_us(settle_time_us)
+    , id_base(input_id_base)
+    , adc_slot(AdcEngine::NO_SLOT)
+    , sampled_channels(0)
+    , next_reading_channel(0)
+    , selected_channel(0)
+    , switch_time(0)
+    , fresh_channels(0)
+{
+    // Only as many select lines as needed to address num_channels
+    while (num_select_pins < SELECT_PINS && (1 << num_select_pins) < num_channels) {
+        num_select_pins++;
+    }
+
+    for (uint8_t i = 0; i < SELECT_PINS; i++) {
+        select_pins[i] = select_pin_array[i];
+    }
+
+    for (uint8_t ch = 0; ch < num_channels; ch++) {
+        channels[ch].setSensitivity(sensitivity_level);
+    }
+}
+
+void MuxAnalogSensor::begin()
+{
+    // Select lines start at channel 0
+    for (uint8_t i = 0; i < num_select_pins; i++) {
+        pinMode(select_pins[i], OUTPUT);
+        digitalWrite(select_pins[i], LOW);
+    }
+    selected_channel = 0;
+    switch_time = micros();
+
+    // Reset state
+    for (uint8_t ch = 0; ch < num_channels; ch++) {
+        channels[ch].reset(switch_time);
+    }
+    sampled_channels = 0;
+    fresh_channels = 0;
+    next_reading_channel = 0;
+
+    // Register for background conversion
+    attachAdc();
+}
+
+void MuxAnalogSensor::attachAdc()
+{
+    adc_slot = AdcEngine::addHookedChannel(adc_pin, captureSample, this);
+}
+
+void MuxAnalogSensor::capture(uint16_t sample)
+{
+    // The conversion started about one conversion time ago and sampled the pin right
+    // away; a switch less than settle_us before that may still show the previous channel
+    if (settle_us > 0 && (micros() - switch_time) < (unsigned long)settle_us + AdcEngine::CONVERSION_US) {
+        return; // Throwaway - the next conversion of this pin is settled
+    }
+
+    uint8_t channel = selected_channel;
+    samples[channel] = sample;
+    fresh_channels |= (uint16_t)(1 << channel);
+
+    // Pipeline: switch to the next channel while the other slots convert
+    uint8_t next = (uint8_t)(channel + 1);
+    selectChannel(next < num_channels ? next : 0);
+}
+
+void MuxAnalogSensor::selectChannel(uint8_t channel)
+{
+    uint8_t changed = selected_channel ^ channel;
+    if (changed == 0) {
+        return; // Already there - nothing to settle
+    }
+
+    for (uint8_t i = 0; i < num_select_pins; i++) {
+        if (changed & (1 << i)) {
+            digitalWrite(select_pins[i], (channel & (1 << i)) ? HIGH : LOW);
+        }
+    }
+
+    selected_channel = channel;
+    switch_time = micros();
+}
+
+void MuxAnalogSensor::scan()
+{
+    // One timestamp for the whole round keeps the channels' intervals in step
+    uint32_t now_us = micros();
+
+    if (adc_slot == AdcEngine::NO_SLOT) {
+        scanBlocking(now_us);
+        return;
+    }
+
+    // Take the samples the ISR stored since the last scan
+    uint16_t values[MAX_CHANNELS];
+    noInterrupts();
+    uint16_t fresh = fresh_channels;
+    fresh_channels = 0;
+    for (uint8_t ch = 0; ch < num_channels; ch++) {
+        values[ch] = samples[ch];
+    }
+    interrupts();
+    sampled_channels |= fresh;
+
+    for (uint8_t ch = 0; ch < num_channels; ch++) {
+        if ((sampled_channels & (1 << ch)) == 0) {
+            continue; // Not converted yet - nothing to report
+        }
+
+        // A channel not converted since the last scan keeps its value (keepalive still runs)
+        channels[ch].update((fresh & (1 << ch)) ? values[ch] : channels[ch].getValue(), now_us);
+        if (channels[ch].shouldSend()) {
+            markReady();
+        }
+    }
+}
+
+void MuxAnalogSensor::scanBlocking(uint32_t now_us)
+{
+    for (uint8_t n = 0; n < num_channels; n++) {
+        // The select lines were moved to this channel after the previous sample
+        // (the first channel's after the last one of the previous scan, so it
+        // settled during the rest of the loop)
+        uint8_t channel = selected_channel;
+
+        // Only wait out what processing the previous sample didn't cover
+        unsigned long elapsed = micros() - switch_time;
+        if (elapsed < settle_us) {
+            delayMicroseconds((unsigned int)(settle_us - elapsed));
+        }
+
+        uint16_t value = AdcEngine::readNow(adc_pin);
+
+        // Pipeline: switch to the next channel before processing this sample
+        uint8_t next = (uint8_t)(channel + 1);
+        selectChannel(next < num_channels ? next : 0);
+
+        channels[channel].update(value, now_us);
+        if (channels[channel].shouldSend()) {
+            markReady();
+        }
+    }
+}
+
+Reading MuxAnalogSensor::getReading()
+{
+    // Round-robin over channels so a busy channel can't starve the others
+    for (uint8_t n = 0; n < num_channels; n++) {
+        uint8_t channel = (uint8_t)((next_reading_channel + n) % num_channels);
+
+        if (channels[channel].shouldSend()) {
+            next_reading_channel = (uint8_t)((channel + 1) % num_channels);
+            int16_t value = (int16_t)channels[channel].markSent();
+            return Reading(value, InputType::MuxAnalog, (uint16_t)(id_base + channel));
+        }
+    }
+
+    return Reading(); // Not ready to send yet
+}
+
+} // namespace Sensor
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "analog_send_policy.h"
+#include "protocol.h"
+#include "sensor.h"
+#include <Arduino.h>
+
+namespace Sensor {
+
+// Analog multiplexer sensor implementation (CD74HC4067, up to 16 channels on one ADC pin)
+// Pipelined with channel switching: as soon as a channel's sample is taken the
+// select lines move on to the next channel, so the mux settles while other work
+// runs.
+// On AVR the ADC pin is a hooked AdcEngine slot: the conversion-complete interrupt
+// hands each sample to capture(), which stores it and switches the select lines,
+// and scan() takes the channels sampled since the last scan; a sample converted
+// less than settle_us after its switch is thrown away. Elsewhere every channel is
+// converted in scan() with blocking reads, each after the previous sample has
+// been processed and only waiting out what's left of settle_us.
+// Each channel has its own AnalogSendPolicy and is reported with an extended
+// input ID: id_base + channel.
+class MuxAnalogSensor : public ISensor {
+public:
+    static constexpr uint8_t MAX_CHANNELS = Protocol::MAX_MUX_CHANNELS;
+    static constexpr uint8_t SELECT_PINS = Protocol::MUX_SELECT_PINS;
+
+private:
+    uint8_t adc_pin; // Analog pin wired to the mux SIG output
+    uint8_t num_channels; // Channels in use
+    uint8_t num_select_pins; // Select lines needed for num_channels
+    uint8_t settle_us; // Minimum settle time before a sample is trusted
+    uint8_t select_pins[SELECT_PINS]; // S0-S3
+    uint16_t id_base; // Extended input ID of channel 0
+
+    uint8_t adc_slot; // Hooked AdcEngine slot (NO_SLOT = blocking reads in scan)
+
+    // State
+    AnalogSendPolicy channels[MAX_CHANNELS]; // Per-channel value and reporting state
+    uint16_t sampled_channels; // Channels with at least one sample (bit per channel)
+    uint8_t next_reading_channel; // Channel to resume reporting from
+
+    // Shared with the ADC interrupt (hooked slot)
+    volatile uint8_t selected_channel; // Channel the select lines currently point at
+    volatile unsigned long switch_time; // micros() of the last select line change
+    volatile uint16_t samples[MAX_CHANNELS]; // Latest sample per channel
+    volatile uint16_t fresh_channels; // Channels sampled since the last scan (bit per channel)
+
+public:
+    MuxAnalogSensor(uint8_t adc_pin_number, uint8_t sensitivity_level, uint8_t channel_count,
+                    uint8_t settle_time_us, const uint8_t* select_pin_array, uint16_t input_id_base);
+
+    // ISensor interface implementation
+    void begin() override;
+    void scan() override;
+    Reading getReading() override;
+    InputType getType() const override { return InputType::MuxAnalog; }
+    uint8_t getPin() const override { return adc_pin; }
+    void attachAdc() override;
+
+    // Store a sample of the selected channel and switch to the next (called from the ADC interrupt)
+    void capture(uint16_t sample);
+
+private:
+    // Blocking scan over every channel (no hooked slot)
+    void scanBlocking(uint32_t now_us);
+
+    // Point the select lines at a channel (only changed lines are written)
+    void selectChannel(uint8_t channel);
+};
+
+} // namespace Sensor
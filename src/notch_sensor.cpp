@@ -0,0 +1,85 @@
+#include "notch_sensor.h"
+#include "adc_engine.h"
+
+namespace Sensor {
+
+NotchSensor::NotchSensor(uint8_t pin_number, uint8_t hysteresis_counts, uint8_t threshold_count, const uint16_t* threshold_values)
+    : pin(pin_number)
+    , hysteresis(hysteresis_counts)
+    , num_thresholds(threshold_count < MAX_THRESHOLDS ? threshold_count : MAX_THRESHOLDS)
+    , adc_slot(AdcEngine::NO_SLOT)
+    , notch(0)
+    , has_pending_event(false)
+    , primed(false)
+{
+    for (uint8_t i = 0; i < num_thresholds; i++) {
+        thresholds[i] = threshold_values[i];
+    }
+}
+
+void NotchSensor::begin()
+{
+    // Register for background conversion (see AnalogSensor::begin for why there's no pinMode)
+    attachAdc();
+
+    // Reset state
+    notch = 0;
+    has_pending_event = false;
+    primed = false;
+}
+
+void NotchSensor::attachAdc()
+{
+    adc_slot = AdcEngine::addChannel(pin);
+}
+
+uint8_t NotchSensor::quantize(uint16_t value, uint8_t current) const
+{
+    // Step up while the value is clearly past the upper threshold of the notch
+    while (current < num_thresholds && value >= thresholds[current] + hysteresis) {
+        current++;
+    }
+
+    // Step down while the value is clearly below the lower threshold of the notch
+    while (current > 0 && value + hysteresis < thresholds[current - 1]) {
+        current--;
+    }
+
+    return current;
+}
+
+void NotchSensor::scan()
+{
+    uint16_t value = (adc_slot != AdcEngine::NO_SLOT) ? AdcEngine::read(adc_slot) : AdcEngine::readNow(pin);
+
+    if (!primed) {
+        // First sample: place the lever without hysteresis and report where it is
+        notch = 0;
+        while (notch < num_thresholds && value >= thresholds[notch]) {
+            notch++;
+        }
+        primed = true;
+        has_pending_event = true;
+        markReady();
+        return;
+    }
+
+    uint8_t next = quantize(value, notch);
+    if (next != notch) {
+        notch = next;
+        has_pending_event = true;
+        markReady();
+    }
+}
+
+Reading NotchSensor::getReading()
+{
+    if (!has_pending_event) {
+        return Reading();
+    }
+
+    has_pending_event = false;
+    return Reading((int16_t)notch, InputType::AnalogNotch, pin);
+}
+
+} // namespace Sensor
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "protocol.h"
+#include "sensor.h"
+#include <Arduino.h>
+
+namespace Sensor {
+
+// Lever notch sensor implementation
+// Quantises an analog input to a notch index using a table of ascending thresholds
+// (notch k covers thresholds[k-1]..thresholds[k]) and reports only index changes.
+// Leaving a notch needs the value to pass its threshold by the hysteresis band,
+// so a lever resting on a boundary doesn't flicker between notches.
+class NotchSensor : public ISensor {
+public:
+    static constexpr uint8_t MAX_THRESHOLDS = Protocol::MAX_NOTCH_THRESHOLDS;
+
+private:
+    uint8_t pin; // Arduino pin number
+    uint8_t hysteresis; // Counts past a threshold needed to change notch
+    uint8_t num_thresholds; // Number of thresholds (notches = num_thresholds + 1)
+    uint16_t thresholds[MAX_THRESHOLDS]; // Ascending raw 10-bit values
+    uint8_t adc_slot; // Background ADC engine slot (AdcEngine::NO_SLOT if not registered)
+
+    // State
+    uint8_t notch; // Current notch index
+    bool has_pending_event; // True if the notch changed since the last report
+    bool primed; // False until the first scan places the lever
+
+public:
+    NotchSensor(uint8_t pin_number, uint8_t hysteresis_counts, uint8_t threshold_count, const uint16_t* threshold_values);
+
+    // ISensor interface implementation
+    void begin() override;
+    void attachAdc() override;
+    void scan() override;
+    Reading getReading() override;
+    InputType getType() const override { return InputType::AnalogNotch; }
+    uint8_t getPin() const override { return pin; }
+
+    // Notch for a value given the current one (pure - exposed for testing)
+    uint8_t quantize(uint16_t value, uint8_t current) const;
+};
+
+} // namespace Sensor
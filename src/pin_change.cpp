@@ -0,0 +1,110 @@
+#include "pin_change.h"
+
+#if defined(__AVR__) && !defined(PIN_CHANGE_DISABLE)
+#include <Arduino.h>
+#if defined(PCICR) && defined(digitalPinToPCICR)
+#define PIN_CHANGE_AVAILABLE
+#endif
+#endif
+
+namespace PinChange {
+
+#if defined(PIN_CHANGE_AVAILABLE)
+
+struct Registration {
+    uint8_t pin;
+    uint8_t port; // PCICR bit of the pin
+    Handler handler; // nullptr = free
+    void* context;
+};
+
+static Registration g_handlers[MAX_HANDLERS];
+
+static void dispatch(uint8_t port)
+{
+    for (uint8_t i = 0; i < MAX_HANDLERS; i++) {
+        if (g_handlers[i].handler != nullptr && g_handlers[i].port == port) {
+            g_handlers[i].handler(g_handlers[i].context);
+        }
+    }
+}
+
+ISR(PCINT0_vect) { dispatch(0); }
+#if defined(PCINT1_vect)
+ISR(PCINT1_vect) { dispatch(1); }
+#endif
+#if defined(PCINT2_vect)
+ISR(PCINT2_vect) { dispatch(2); }
+#endif
+
+bool attach(uint8_t pin, Handler handler, void* context)
+{
+    if (digitalPinToPCICR(pin) == nullptr) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < MAX_HANDLERS; i++) {
+        if (g_handlers[i].handler != nullptr) {
+            continue;
+        }
+
+        uint8_t port = digitalPinToPCICRbit(pin);
+        noInterrupts();
+        g_handlers[i].pin = pin;
+        g_handlers[i].port = port;
+        g_handlers[i].handler = handler;
+        g_handlers[i].context = context;
+        interrupts();
+
+        *digitalPinToPCMSK(pin) |= (uint8_t)(1 << digitalPinToPCMSKbit(pin));
+        PCIFR = (uint8_t)(1 << port); // Drop a change latched before now
+        *digitalPinToPCICR(pin) |= (uint8_t)(1 << port);
+        return true;
+    }
+    return false;
+}
+
+void detach(void* context)
+{
+    for (uint8_t i = 0; i < MAX_HANDLERS; i++) {
+        if (g_handlers[i].handler == nullptr || g_handlers[i].context != context) {
+            continue;
+        }
+
+        uint8_t pin = g_handlers[i].pin;
+        noInterrupts();
+        g_handlers[i].handler = nullptr;
+        interrupts();
+
+        // The pin (and its port) stay enabled while another handler uses them
+        bool pin_used = false;
+        for (uint8_t j = 0; j < MAX_HANDLERS; j++) {
+            pin_used = pin_used || (g_handlers[j].handler != nullptr && g_handlers[j].pin == pin);
+        }
+        if (!pin_used) {
+            *digitalPinToPCMSK(pin) &= (uint8_t)~(1 << digitalPinToPCMSKbit(pin));
+        }
+        if (*digitalPinToPCMSK(pin) == 0) {
+            *digitalPinToPCICR(pin) &= (uint8_t)~(1 << digitalPinToPCICRbit(pin));
+        }
+    }
+}
+
+#else
+
+bool attach(uint8_t pin, Handler handler, void* context)
+{
+    (void)pin;
+    (void)handler;
+    (void)context;
+    return false;
+}
+
+void detach(void* context)
+{
+    (void)context;
+}
+
+#endif
+
+} // namespace PinChange
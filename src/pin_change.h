@@ -0,0 +1,26 @@
+#pragma once
+
+#include <stdint.h>
+
+// Shared AVR pin-change interrupt (PCINT) dispatch
+// A PCINT vector serves a whole port, so the vectors are defined once, here, and
+// call every handler registered on a pin of that port; handlers check their own
+// pin. Ports are only enabled while a handler uses them. Build with
+// -DPIN_CHANGE_DISABLE to leave the vectors to other code (e.g. SoftwareSerial):
+// attach() then fails and pins without an external interrupt are polled.
+// Other platforms have no PCINT, so attach() always fails there.
+namespace PinChange {
+
+// Handlers registered at once (an encoder takes two)
+constexpr uint8_t MAX_HANDLERS = 8;
+
+typedef void (*Handler)(void* context);
+
+// Call handler(context) from the interrupt when pin changes
+// Returns false if the pin has no pin-change interrupt or all handlers are taken
+bool attach(uint8_t pin, Handler handler, void* context);
+
+// Remove every handler registered for context
+void detach(void* context);
+
+} // namespace PinChange
@@ -122,6 +122,35 @@ bool IdentityResponse::decode(const uint8_t* buffer, size_t length)
 
 // Configure implementation
 
+size_t Configure::analogOptionCount() const
+{
+    if (analog.keepalive_ms != 0) {
+        return 11; // ... + hysteresis + min_interval_ms (u16) + keepalive_ms (u16)
+    }
+    if (analog.min_interval_ms != 0) {
+        return 9; // ... + hysteresis + min_interval_ms (u16)
+    }
+    if (analog.hysteresis != 0) {
+        return 7; // oversample + filter + filter_alpha + filter_beta + median + dead_zone + hysteresis
+    }
+    if (analog.dead_zone != 0) {
+        return 6; // oversample + filter + filter_alpha + filter_beta + median + dead_zone
+    }
+    if (analog.median != ANALOG_MEDIAN_OFF) {
+        return 5; // oversample + filter + filter_alpha + filter_beta + median
+    }
+    if (analog.filter_beta != 0) {
+        return 4; // oversample + filter + filter_alpha + filter_beta
+    }
+    if (analog.filter != ANALOG_FILTER_NONE) {
+        return 3; // oversample + filter + filter_alpha
+    }
+    if (analog.oversample != 0) {
+        return 1; // oversample
+    }
+    return 0;
+}
+
 size_t Configure::encode(uint8_t* buffer, size_t buffer_size) const
 {
     // Common header: 1 type + 4 config_id + 1 total_parts + 1 part_number + 1 input_type = 8 bytes
@@ -131,13 +160,52 @@ size_t Configure::encode(uint8_t* buffer, size_t buffer_size) const
     size_t payload_size = 0;
     switch (input_type) {
     case INPUT_TYPE_ANALOG:
-        payload_size = 2; // pin + sensitivity
+        payload_size = 2 + analogOptionCount(); // pin + sensitivity + optional trailing fields
         break;
     case INPUT_TYPE_BUTTON:
         payload_size = 2; // pin + debounce
+        if (button.flags != 0) {
+            payload_size += 1; // flags (omitted when all options are default)
+        }
         break;
     case INPUT_TYPE_MATRIX:
         payload_size = 2 + matrix.num_row_pins + matrix.num_col_pins; // counts + pins
+        if (matrix.flags != 0) {
+            payload_size += 1; // flags (omitted when all options are default)
+        }
+        break;
+    case INPUT_TYPE_SHIFT_REGISTER:
+        payload_size = 2; // latch_pin + num_registers
+        break;
+    case INPUT_TYPE_I2C_EXPANDER:
+        payload_size = 3; // chip + address + int_pin
+        break;
+    case INPUT_TYPE_ANALOG_MUX:
+        payload_size = 4 + MUX_SELECT_PINS; // adc_pin + sensitivity + num_channels + settle_us + select pins
+        break;
+    case INPUT_TYPE_ANALOG_NOTCH:
+        if (notch.num_thresholds > MAX_NOTCH_THRESHOLDS) {
+            return 0; // Table too large
+        }
+        payload_size = 3 + 2 * notch.num_thresholds; // pin + hysteresis + num_thresholds + thresholds
+        break;
+    case INPUT_TYPE_RESISTOR_LADDER:
+        if (ladder.num_buttons > MAX_LADDER_BUTTONS) {
+            return 0; // Table too large
+        }
+        payload_size = 3 + 2 * ladder.num_buttons; // pin + debounce + num_buttons + thresholds
+        break;
+    case INPUT_TYPE_ENCODER:
+        payload_size = 4; // pin_a + pin_b + steps_per_detent + sensitivity
+        break;
+    case INPUT_TYPE_BUTTON_GROUP:
+        if (button_group.num_pins > MAX_BUTTON_GROUP_PINS) {
+            return 0; // Too many pins
+        }
+        payload_size = 1 + button_group.num_pins; // num_pins + pins
+        if (button_group.debounce != 0) {
+            payload_size += 1; // debounce (omitted when default)
+        }
         break;
     default:
         return 0; // Unknown input type
@@ -170,14 +238,27 @@ size_t Configure::encode(uint8_t* buffer, size_t buffer_size) const
 
     // Type-specific payload
     switch (input_type) {
-    case INPUT_TYPE_ANALOG:
+    case INPUT_TYPE_ANALOG: {
         buffer[offset++] = analog.pin;
         buffer[offset++] = analog.sensitivity;
+        const uint8_t options[] = {
+            analog.oversample, analog.filter, analog.filter_alpha, analog.filter_beta, analog.median,
+            analog.dead_zone, analog.hysteresis,
+            (uint8_t)(analog.min_interval_ms & 0xFF), (uint8_t)(analog.min_interval_ms >> 8),
+            (uint8_t)(analog.keepalive_ms & 0xFF), (uint8_t)(analog.keepalive_ms >> 8)
+        };
+        for (size_t i = 0; i < analogOptionCount(); i++) {
+            buffer[offset++] = options[i];
+        }
         break;
+    }
 
     case INPUT_TYPE_BUTTON:
         buffer[offset++] = button.pin;
         buffer[offset++] = button.debounce;
+        if (button.flags != 0) {
+            buffer[offset++] = button.flags;
+        }
         break;
 
     case INPUT_TYPE_MATRIX:
@@ -186,6 +267,69 @@ size_t Configure::encode(uint8_t* buffer, size_t buffer_size) const
         for (uint8_t i = 0; i < matrix.num_row_pins + matrix.num_col_pins; i++) {
             buffer[offset++] = matrix.pins[i];
         }
+        if (matrix.flags != 0) {
+            buffer[offset++] = matrix.flags;
+        }
+        break;
+
+    case INPUT_TYPE_SHIFT_REGISTER:
+        buffer[offset++] = shift_register.latch_pin;
+        buffer[offset++] = shift_register.num_registers;
+        break;
+
+    case INPUT_TYPE_I2C_EXPANDER:
+        buffer[offset++] = expander.chip;
+        buffer[offset++] = expander.address;
+        buffer[offset++] = expander.int_pin;
+        break;
+
+    case INPUT_TYPE_ANALOG_MUX:
+        buffer[offset++] = analog_mux.adc_pin;
+        buffer[offset++] = analog_mux.sensitivity;
+        buffer[offset++] = analog_mux.num_channels;
+        buffer[offset++] = analog_mux.settle_us;
+        for (uint8_t i = 0; i < MUX_SELECT_PINS; i++) {
+            buffer[offset++] = analog_mux.select_pins[i];
+        }
+        break;
+
+    case INPUT_TYPE_ANALOG_NOTCH:
+        buffer[offset++] = notch.pin;
+        buffer[offset++] = notch.hysteresis;
+        buffer[offset++] = notch.num_thresholds;
+        for (uint8_t i = 0; i < notch.num_thresholds; i++) {
+            // threshold (u16) - little endian
+            buffer[offset++] = (notch.thresholds[i] >> 0) & 0xFF;
+            buffer[offset++] = (notch.thresholds[i] >> 8) & 0xFF;
+        }
+        break;
+
+    case INPUT_TYPE_RESISTOR_LADDER:
+        buffer[offset++] = ladder.pin;
+        buffer[offset++] = ladder.debounce;
+        buffer[offset++] = ladder.num_buttons;
+        for (uint8_t i = 0; i < ladder.num_buttons; i++) {
+            // threshold (u16) - little endian
+            buffer[offset++] = (ladder.thresholds[i] >> 0) & 0xFF;
+            buffer[offset++] = (ladder.thresholds[i] >> 8) & 0xFF;
+        }
+        break;
+
+    case INPUT_TYPE_ENCODER:
+        buffer[offset++] = encoder.pin_a;
+        buffer[offset++] = encoder.pin_b;
+        buffer[offset++] = encoder.steps_per_detent;
+        buffer[offset++] = encoder.sensitivity;
+        break;
+
+    case INPUT_TYPE_BUTTON_GROUP:
+        buffer[offset++] = button_group.num_pins;
+        for (uint8_t i = 0; i < button_group.num_pins; i++) {
+            buffer[offset++] = button_group.pins[i];
+        }
+        if (button_group.debounce != 0) {
+            buffer[offset++] = button_group.debounce;
+        }
         break;
     }
 
@@ -228,6 +372,38 @@ bool Configure::decode(const uint8_t* buffer, size_t length)
         }
         analog.pin = buffer[offset++];
         analog.sensitivity = buffer[offset++];
+        analog.oversample = (length > offset) ? buffer[offset++] : 0;
+        analog.filter = (length > offset) ? buffer[offset++] : ANALOG_FILTER_NONE;
+        analog.filter_alpha = (length > offset) ? buffer[offset++] : 0;
+        analog.filter_beta = (length > offset) ? buffer[offset++] : 0;
+        analog.median = (length > offset) ? buffer[offset++] : ANALOG_MEDIAN_OFF;
+        analog.dead_zone = (length > offset) ? buffer[offset++] : 0;
+        analog.hysteresis = (length > offset) ? buffer[offset++] : 0;
+        analog.min_interval_ms = 0;
+        analog.keepalive_ms = 0;
+        if (length > offset) {
+            if (length < offset + 2) {
+                return false; // Truncated min_interval_ms
+            }
+            analog.min_interval_ms = (uint16_t)(((uint16_t)buffer[offset + 0] << 0) | ((uint16_t)buffer[offset + 1] << 8));
+            offset += 2;
+        }
+        if (length > offset) {
+            if (length < offset + 2) {
+                return false; // Truncated keepalive_ms
+            }
+            analog.keepalive_ms = (uint16_t)(((uint16_t)buffer[offset + 0] << 0) | ((uint16_t)buffer[offset + 1] << 8));
+            offset += 2;
+        }
+        if (analog.oversample > MAX_OVERSAMPLE_BITS) {
+            return false; // Invalid oversampling factor
+        }
+        if (analog.filter > ANALOG_FILTER_ONE_EURO || (analog.filter != ANALOG_FILTER_NONE && analog.filter_alpha == 0)) {
+            return false; // Unknown filter or zero coefficient
+        }
+        if (analog.median != ANALOG_MEDIAN_OFF && analog.median != ANALOG_MEDIAN_3 && analog.median != ANALOG_MEDIAN_5) {
+            return false; // Unsupported median window
+        }
         break;
 
     case INPUT_TYPE_BUTTON:
@@ -236,6 +412,9 @@ bool Configure::decode(const uint8_t* buffer, size_t length)
         }
         button.pin = buffer[offset++];
         button.debounce = buffer[offset++];
+
+        // Optional flags byte (older hosts omit it)
+        button.flags = (length > offset) ? buffer[offset++] : 0;
         break;
 
     case INPUT_TYPE_MATRIX: {
@@ -255,9 +434,132 @@ bool Configure::decode(const uint8_t* buffer, size_t length)
         for (uint8_t i = 0; i < total_pins; i++) {
             matrix.pins[i] = buffer[offset++];
         }
+
+        // Optional flags byte (older hosts omit it)
+        matrix.flags = (length > offset) ? buffer[offset++] : 0;
         break;
     }
 
+    case INPUT_TYPE_SHIFT_REGISTER:
+        if (length < HEADER_SIZE + 2) {
+            return false; // Not enough data for shift register payload
+        }
+        shift_register.latch_pin = buffer[offset++];
+        shift_register.num_registers = buffer[offset++];
+        if (shift_register.num_registers == 0 || shift_register.num_registers > MAX_SHIFT_REGISTERS) {
+            return false; // Invalid chain length
+        }
+        break;
+
+    case INPUT_TYPE_I2C_EXPANDER:
+        if (length < HEADER_SIZE + 3) {
+            return false; // Not enough data for expander payload
+        }
+        expander.chip = buffer[offset++];
+        expander.address = buffer[offset++];
+        expander.int_pin = buffer[offset++];
+        if (expander.chip > EXPANDER_CHIP_PCF8575 || expander.address > 0x7F) {
+            return false; // Unknown chip or invalid 7-bit address
+        }
+        break;
+
+    case INPUT_TYPE_ANALOG_MUX:
+        if (length < HEADER_SIZE + 4 + MUX_SELECT_PINS) {
+            return false; // Not enough data for mux payload
+        }
+        analog_mux.adc_pin = buffer[offset++];
+        analog_mux.sensitivity = buffer[offset++];
+        analog_mux.num_channels = buffer[offset++];
+        analog_mux.settle_us = buffer[offset++];
+        for (uint8_t i = 0; i < MUX_SELECT_PINS; i++) {
+            analog_mux.select_pins[i] = buffer[offset++];
+        }
+        if (analog_mux.num_channels == 0 || analog_mux.num_channels > MAX_MUX_CHANNELS) {
+            return false; // Invalid channel count
+        }
+        break;
+
+    case INPUT_TYPE_ANALOG_NOTCH:
+        if (length < HEADER_SIZE + 3) {
+            return false; // Not enough data for notch payload
+        }
+        notch.pin = buffer[offset++];
+        notch.hysteresis = buffer[offset++];
+        notch.num_thresholds = buffer[offset++];
+        if (notch.num_thresholds == 0 || notch.num_thresholds > MAX_NOTCH_THRESHOLDS) {
+            return false; // Invalid table size
+        }
+        if (length < HEADER_SIZE + 3 + 2 * (size_t)notch.num_thresholds) {
+            return false; // Not enough data for thresholds
+        }
+        for (uint8_t i = 0; i < notch.num_thresholds; i++) {
+            // threshold (u16) - little endian
+            notch.thresholds[i] = (uint16_t)(((uint16_t)buffer[offset + 0] << 0) | ((uint16_t)buffer[offset + 1] << 8));
+            offset += 2;
+            if (i > 0 && notch.thresholds[i] <= notch.thresholds[i - 1]) {
+                return false; // Thresholds must be strictly ascending
+            }
+        }
+        break;
+
+    case INPUT_TYPE_RESISTOR_LADDER:
+        if (length < HEADER_SIZE + 3) {
+            return false; // Not enough data for ladder payload
+        }
+        ladder.pin = buffer[offset++];
+        ladder.debounce = buffer[offset++];
+        ladder.num_buttons = buffer[offset++];
+        if (ladder.num_buttons == 0 || ladder.num_buttons > MAX_LADDER_BUTTONS) {
+            return false; // Invalid button count
+        }
+        if (length < HEADER_SIZE + 3 + 2 * (size_t)ladder.num_buttons) {
+            return false; // Not enough data for thresholds
+        }
+        for (uint8_t i = 0; i < ladder.num_buttons; i++) {
+            // threshold (u16) - little endian
+            ladder.thresholds[i] = (uint16_t)(((uint16_t)buffer[offset + 0] << 0) | ((uint16_t)buffer[offset + 1] << 8));
+            offset += 2;
+            if (i > 0 && ladder.thresholds[i] <= ladder.thresholds[i - 1]) {
+                return false; // Thresholds must be strictly ascending
+            }
+        }
+        break;
+
+    case INPUT_TYPE_ENCODER:
+        if (length < HEADER_SIZE + 4) {
+            return false; // Not enough data for encoder payload
+        }
+        encoder.pin_a = buffer[offset++];
+        encoder.pin_b = buffer[offset++];
+        encoder.steps_per_detent = buffer[offset++];
+        encoder.sensitivity = buffer[offset++];
+        if (encoder.pin_a == encoder.pin_b || encoder.sensitivity > 10) {
+            return false; // Needs two distinct pins; sensitivity is 0-10
+        }
+        break;
+
+    case INPUT_TYPE_BUTTON_GROUP:
+        if (length < HEADER_SIZE + 1) {
+            return false; // Not enough data for button group header
+        }
+        button_group.num_pins = buffer[offset++];
+        if (button_group.num_pins == 0 || button_group.num_pins > MAX_BUTTON_GROUP_PINS) {
+            return false; // Invalid pin count
+        }
+        if (length < HEADER_SIZE + 1 + (size_t)button_group.num_pins) {
+            return false; // Not enough data for pins
+        }
+        for (uint8_t i = 0; i < button_group.num_pins; i++) {
+            button_group.pins[i] = buffer[offset++];
+        }
+
+        // Optional debounce byte (older hosts omit it)
+        button_group.debounce = (length > offset) ? buffer[offset++] : 0;
+        if (button_group.debounce > MAX_BUTTON_GROUP_DEBOUNCE) {
+            return false; // Longer than the vertical counters can count
+        }
+        break;
+
     default:
         return false; // Unknown input type
     }
@@ -401,6 +703,201 @@ bool InputValue::decode(const uint8_t* buffer, size_t length)
     return true;
 }
 
+// InputValueExtended implementation
+
+size_t InputValueExtended::encode(uint8_t* buffer, size_t buffer_size) const
+{
+    constexpr size_t REQUIRED_SIZE = 5; // 1 type + 2 input_id + 2 value
+
+    if (buffer_size < REQUIRED_SIZE) {
+        return 0; // Buffer too small
+    }
+
+    size_t offset = 0;
+
+    // Message type (u8)
+    buffer[offset++] = MESSAGE_TYPE_INPUT_VALUE_EXTENDED;
+
+    // input_id (u16) - little endian
+    buffer[offset++] = (input_id >> 0) & 0xFF;
+    buffer[offset++] = (input_id >> 8) & 0xFF;
+
+    // value (i16) - little endian
+    buffer[offset++] = (value >> 0) & 0xFF;
+    buffer[offset++] = (value >> 8) & 0xFF;
+
+    return offset;
+}
+
+bool InputValueExtended::decode(const uint8_t* buffer, size_t length)
+{
+    constexpr size_t REQUIRED_SIZE = 5;
+
+    if (length < REQUIRED_SIZE) {
+        return false; // Not enough data
+    }
+
+    if (buffer[0] != MESSAGE_TYPE_INPUT_VALUE_EXTENDED) {
+        return false; // Wrong message type
+    }
+
+    size_t offset = 1;
+
+    // input_id (u16) - little endian
+    input_id = (uint16_t)(((uint16_t)buffer[offset + 0] << 0) | ((uint16_t)buffer[offset + 1] << 8));
+    offset += 2;
+
+    // value (i16) - little endian
+    value = (int16_t)(((uint16_t)buffer[offset + 0] << 0) | ((uint16_t)buffer[offset + 1] << 8));
+
+    return true;
+}
+
+// InputResolution implementation
+
+size_t InputResolution::encode(uint8_t* buffer, size_t buffer_size) const
+{
+    constexpr size_t REQUIRED_SIZE = 3; // 1 type + 1 pin + 1 bits
+
+    if (buffer_size < REQUIRED_SIZE) {
+        return 0; // Buffer too small
+    }
+
+    size_t offset = 0;
+
+    // Message type (u8)
+    buffer[offset++] = MESSAGE_TYPE_INPUT_RESOLUTION;
+
+    // pin (u8)
+    buffer[offset++] = pin;
+
+    // bits (u8)
+    buffer[offset++] = bits;
+
+    return offset;
+}
+
+bool InputResolution::decode(const uint8_t* buffer, size_t length)
+{
+    constexpr size_t REQUIRED_SIZE = 3;
+
+    if (length < REQUIRED_SIZE) {
+        return false; // Not enough data
+    }
+
+    if (buffer[0] != MESSAGE_TYPE_INPUT_RESOLUTION) {
+        return false; // Wrong message type
+    }
+
+    pin = buffer[1];
+    bits = buffer[2];
+
+    return true;
+}
+
+// CalibrateNoise implementation
+
+size_t CalibrateNoise::encode(uint8_t* buffer, size_t buffer_size) const
+{
+    constexpr size_t REQUIRED_SIZE = 3; // 1 type + 2 scans
+
+    if (buffer_size < REQUIRED_SIZE) {
+        return 0; // Buffer too small
+    }
+
+    size_t offset = 0;
+
+    // Message type (u8)
+    buffer[offset++] = MESSAGE_TYPE_CALIBRATE_NOISE;
+
+    // scans (u16) - little endian
+    buffer[offset++] = (scans >> 0) & 0xFF;
+    buffer[offset++] = (scans >> 8) & 0xFF;
+
+    return offset;
+}
+
+bool CalibrateNoise::decode(const uint8_t* buffer, size_t length)
+{
+    constexpr size_t REQUIRED_SIZE = 3;
+
+    if (length < REQUIRED_SIZE) {
+        return false; // Not enough data
+    }
+
+    if (buffer[0] != MESSAGE_TYPE_CALIBRATE_NOISE) {
+        return false; // Wrong message type
+    }
+
+    // scans (u16) - little endian
+    scans = (uint16_t)(((uint16_t)buffer[1] << 0) | ((uint16_t)buffer[2] << 8));
+
+    return scans > 0; // An empty window can't measure anything
+}
+
+// NoiseStats implementation
+
+size_t NoiseStats::encode(uint8_t* buffer, size_t buffer_size) const
+{
+    constexpr size_t REQUIRED_SIZE = 9; // 1 type + 1 pin + 2 samples + 2 min + 2 max + 1 dead_zone
+
+    if (buffer_size < REQUIRED_SIZE) {
+        return 0; // Buffer too small
+    }
+
+    size_t offset = 0;
+
+    // Message type (u8)
+    buffer[offset++] = MESSAGE_TYPE_NOISE_STATS;
+
+    // pin (u8)
+    buffer[offset++] = pin;
+
+    // samples, min_value, max_value (u16) - little endian
+    buffer[offset++] = (samples >> 0) & 0xFF;
+    buffer[offset++] = (samples >> 8) & 0xFF;
+    buffer[offset++] = (min_value >> 0) & 0xFF;
+    buffer[offset++] = (min_value >> 8) & 0xFF;
+    buffer[offset++] = (max_value >> 0) & 0xFF;
+    buffer[offset++] = (max_value >> 8) & 0xFF;
+
+    // dead_zone (u8)
+    buffer[offset++] = dead_zone;
+
+    return offset;
+}
+
+bool NoiseStats::decode(const uint8_t* buffer, size_t length)
+{
+    constexpr size_t REQUIRED_SIZE = 9;
+
+    if (length < REQUIRED_SIZE) {
+        return false; // Not enough data
+    }
+
+    if (buffer[0] != MESSAGE_TYPE_NOISE_STATS) {
+        return false; // Wrong message type
+    }
+
+    size_t offset = 1;
+
+    // pin (u8)
+    pin = buffer[offset++];
+
+    // samples, min_value, max_value (u16) - little endian
+    samples = (uint16_t)(((uint16_t)buffer[offset + 0] << 0) | ((uint16_t)buffer[offset + 1] << 8));
+    offset += 2;
+    min_value = (uint16_t)(((uint16_t)buffer[offset + 0] << 0) | ((uint16_t)buffer[offset + 1] << 8));
+    offset += 2;
+    max_value = (uint16_t)(((uint16_t)buffer[offset + 0] << 0) | ((uint16_t)buffer[offset + 1] << 8));
+    offset += 2;
+
+    // dead_zone (u8)
+    dead_zone = buffer[offset++];
+
+    return true;
+}
+
 // Heartbeat implementation
 
 size_t Heartbeat::encode(uint8_t* buffer, size_t buffer_size) const
@@ -513,6 +1010,18 @@ bool Message::decode(const uint8_t* buffer, size_t length)
     case MESSAGE_TYPE_SET_OUTPUT:
         return set_output.decode(buffer, length);
 
+    case MESSAGE_TYPE_INPUT_VALUE_EXTENDED:
+        return input_value_extended.decode(buffer, length);
+
+    case MESSAGE_TYPE_INPUT_RESOLUTION:
+        return input_resolution.decode(buffer, length);
+
+    case MESSAGE_TYPE_CALIBRATE_NOISE:
+        return calibrate_noise.decode(buffer, length);
+
+    case MESSAGE_TYPE_NOISE_STATS:
+        return noise_stats.decode(buffer, length);
+
     default:
         return false; // Unknown message type
     }
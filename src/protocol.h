@@ -14,16 +14,85 @@ constexpr uint8_t MESSAGE_TYPE_CONFIGURATION_ERROR = 4;
 constexpr uint8_t MESSAGE_TYPE_INPUT_VALUE = 5;
 constexpr uint8_t MESSAGE_TYPE_HEARTBEAT = 6;
 constexpr uint8_t MESSAGE_TYPE_SET_OUTPUT = 7;
+constexpr uint8_t MESSAGE_TYPE_INPUT_VALUE_EXTENDED = 8;
+constexpr uint8_t MESSAGE_TYPE_INPUT_RESOLUTION = 9;
+constexpr uint8_t MESSAGE_TYPE_CALIBRATE_NOISE = 10;
+constexpr uint8_t MESSAGE_TYPE_NOISE_STATS = 11;
 
 // Input Type constants for Configure message
 constexpr uint8_t INPUT_TYPE_ANALOG = 0;
 constexpr uint8_t INPUT_TYPE_BUTTON = 1;
 constexpr uint8_t INPUT_TYPE_MATRIX = 2;
+constexpr uint8_t INPUT_TYPE_SHIFT_REGISTER = 3;
+constexpr uint8_t INPUT_TYPE_I2C_EXPANDER = 4;
+constexpr uint8_t INPUT_TYPE_ANALOG_MUX = 5;
+constexpr uint8_t INPUT_TYPE_ANALOG_NOTCH = 6;
+constexpr uint8_t INPUT_TYPE_RESISTOR_LADDER = 7;
+constexpr uint8_t INPUT_TYPE_ENCODER = 8;
+constexpr uint8_t INPUT_TYPE_BUTTON_GROUP = 9;
+
+// Analog oversampling: 4^n samples are decimated to 10 + n bits (n = 0 disables oversampling)
+constexpr uint8_t ANALOG_BASE_BITS = 10;
+constexpr uint8_t MAX_OVERSAMPLE_BITS = 3; // 64x -> 13 bits
+
+// Analog smoothing filters (fixed-point, coefficient alpha in Q8)
+constexpr uint8_t ANALOG_FILTER_NONE = 0;
+constexpr uint8_t ANALOG_FILTER_EMA = 1; // First-order exponential moving average
+constexpr uint8_t ANALOG_FILTER_EMA2 = 2; // Second-order IIR (two cascaded EMA stages)
+constexpr uint8_t ANALOG_FILTER_ONE_EURO = 3; // Speed-adaptive EMA (alpha = filter_alpha at rest, rises with speed)
+
+// Analog median prefilter window (spike rejection before smoothing)
+constexpr uint8_t ANALOG_MEDIAN_OFF = 0;
+constexpr uint8_t ANALOG_MEDIAN_3 = 3;
+constexpr uint8_t ANALOG_MEDIAN_5 = 5;
+
+// Button option flags (optional trailing byte of the button payload)
+constexpr uint8_t BUTTON_FLAG_EAGER_DEBOUNCE = 0x01; // Report the first edge, then lock out for debounce scans
+constexpr uint8_t BUTTON_FLAG_INTERRUPT = 0x02; // Capture edges in a pin-change interrupt (lockout = debounce x 10ms)
 
 // Maximum number of pins for matrix configuration (row_pins + col_pins)
 constexpr uint8_t MAX_MATRIX_PINS = 16;
 
-// Maximum payload size
+// Matrix option flags (optional trailing byte of the matrix payload)
+constexpr uint8_t MATRIX_FLAG_NO_DIODES = 0x01; // Diode-less matrix: suppress ghost keys on-device
+constexpr uint8_t MATRIX_FLAG_EAGER_DEBOUNCE = 0x02; // Same as BUTTON_FLAG_EAGER_DEBOUNCE, for every key
+
+// Maximum number of daisy-chained 74HC165 registers (8 inputs each, 256 inputs total)
+constexpr uint8_t MAX_SHIFT_REGISTERS = 32;
+
+// I2C GPIO expander chips (16 inputs each)
+constexpr uint8_t EXPANDER_CHIP_MCP23017 = 0;
+constexpr uint8_t EXPANDER_CHIP_PCF8575 = 1;
+
+// Expander int_pin value meaning "no INT line wired" (poll every scan)
+constexpr uint8_t EXPANDER_NO_INT_PIN = 0xFF;
+
+// Analog multiplexer (CD74HC4067) limits
+constexpr uint8_t MAX_MUX_CHANNELS = 16;
+constexpr uint8_t MUX_SELECT_PINS = 4; // S0-S3
+
+// Lever notch table: up to 11 ascending thresholds (12 notches) per input
+constexpr uint8_t MAX_NOTCH_THRESHOLDS = 11;
+
+// Resistor ladder: up to 8 buttons on one analog pin
+constexpr uint8_t MAX_LADDER_BUTTONS = 8;
+
+// Button group: up to 16 direct-wired buttons read port-wide
+constexpr uint8_t MAX_BUTTON_GROUP_PINS = 16;
+constexpr uint8_t DEFAULT_BUTTON_GROUP_DEBOUNCE = 3; // Scans, when debounce is 0 or omitted
+constexpr uint8_t MAX_BUTTON_GROUP_DEBOUNCE = 7; // Three-bit vertical counters
+
+// Extended input IDs - inputs that don't map to a single pin (e.g. shift register bits)
+// are reported with InputValueExtended using id = EXTENDED_ID_BASE * (part_number + 1) + index
+constexpr uint16_t EXTENDED_ID_BASE = 256;
+
+constexpr uint16_t extendedInputId(uint8_t part_number, uint8_t index)
+{
+    return (uint16_t)(EXTENDED_ID_BASE * (part_number + 1) + index);
+}
+
+// Maximum size of a message the device receives (the largest, a Configure
+// with a full notch table, is 33 bytes)
 constexpr size_t MAX_PAYLOAD_SIZE = 64;
 
 // Identity Request message
@@ -66,12 +135,22 @@ struct Configure {
         struct {
             uint8_t pin;
             uint8_t sensitivity;
+            uint8_t oversample; // Extra bits from oversampling (0-MAX_OVERSAMPLE_BITS, optional on the wire)
+            uint8_t filter; // ANALOG_FILTER_* (optional on the wire)
+            uint8_t filter_alpha; // Filter coefficient in Q8 (1-255, optional on the wire)
+            uint8_t filter_beta; // ONE_EURO speed gain (optional on the wire)
+            uint8_t median; // ANALOG_MEDIAN_* prefilter window (optional on the wire)
+            uint8_t dead_zone; // Send dead zone in counts, 0 = default (optional on the wire)
+            uint8_t hysteresis; // Extra counts to reverse direction, 0 = off (optional on the wire)
+            uint16_t min_interval_ms; // Minimum time between sends, 0 = from sensitivity (optional on the wire)
+            uint16_t keepalive_ms; // Forced send interval, 0 = 2000ms (optional on the wire)
         } analog;
 
         // INPUT_TYPE_BUTTON
         struct {
             uint8_t pin;
             uint8_t debounce;
+            uint8_t flags; // BUTTON_FLAG_* bits (optional on the wire, 0 if omitted)
         } button;
 
         // INPUT_TYPE_MATRIX
@@ -79,7 +158,61 @@ struct Configure {
             uint8_t num_row_pins;
             uint8_t num_col_pins;
             uint8_t pins[MAX_MATRIX_PINS]; // row_pins followed by col_pins
+            uint8_t flags; // MATRIX_FLAG_* bits (optional on the wire, 0 if omitted)
         } matrix;
+
+        // INPUT_TYPE_SHIFT_REGISTER
+        struct {
+            uint8_t latch_pin; // SH/LD pin of the chain (data and clock use hardware SPI)
+            uint8_t num_registers; // Number of chained registers (1-MAX_SHIFT_REGISTERS)
+        } shift_register;
+
+        // INPUT_TYPE_I2C_EXPANDER
+        struct {
+            uint8_t chip; // EXPANDER_CHIP_*
+            uint8_t address; // 7-bit I2C address
+            uint8_t int_pin; // Pin wired to the INT output, or EXPANDER_NO_INT_PIN
+        } expander;
+
+        // INPUT_TYPE_ANALOG_MUX
+        struct {
+            uint8_t adc_pin; // Analog pin wired to the mux common (SIG) output
+            uint8_t sensitivity; // Same meaning as analog.sensitivity, applied per channel
+            uint8_t num_channels; // Number of channels in use (1-MAX_MUX_CHANNELS)
+            uint8_t settle_us; // Minimum settle time after switching, else discard a sample (0 = never)
+            uint8_t select_pins[MUX_SELECT_PINS]; // S0-S3 (pins beyond what num_channels needs are ignored)
+        } analog_mux;
+
+        // INPUT_TYPE_ANALOG_NOTCH
+        struct {
+            uint8_t pin; // Analog pin of the lever
+            uint8_t hysteresis; // Counts past a threshold needed to change notch
+            uint8_t num_thresholds; // 1-MAX_NOTCH_THRESHOLDS
+            uint16_t thresholds[MAX_NOTCH_THRESHOLDS]; // Strictly ascending raw 10-bit values
+        } notch;
+
+        // INPUT_TYPE_RESISTOR_LADDER
+        struct {
+            uint8_t pin; // Analog pin of the ladder
+            uint8_t debounce; // Scans a button must be stable (same as button.debounce)
+            uint8_t num_buttons; // 1-MAX_LADDER_BUTTONS
+            uint16_t thresholds[MAX_LADDER_BUTTONS]; // Strictly ascending upper edge of each button's band
+        } ladder;
+
+        // INPUT_TYPE_ENCODER
+        struct {
+            uint8_t pin_a; // Encoder A pin (reported pin)
+            uint8_t pin_b; // Encoder B pin
+            uint8_t steps_per_detent; // Quadrature transitions per reported step (0 = 1)
+            uint8_t sensitivity; // 0-10, same send interval as analog.sensitivity
+        } encoder;
+
+        // INPUT_TYPE_BUTTON_GROUP
+        struct {
+            uint8_t num_pins; // 1-MAX_BUTTON_GROUP_PINS
+            uint8_t pins[MAX_BUTTON_GROUP_PINS];
+            uint8_t debounce; // Scans a pin must be stable, 0-MAX_BUTTON_GROUP_DEBOUNCE (optional on the wire, 0 = default)
+        } button_group;
     };
 
     Configure()
@@ -90,6 +223,17 @@ struct Configure {
     {
         analog.pin = 0;
         analog.sensitivity = 0;
+        analog.oversample = 0;
+        analog.filter = ANALOG_FILTER_NONE;
+        analog.filter_alpha = 0;
+        analog.filter_beta = 0;
+        analog.median = ANALOG_MEDIAN_OFF;
+        analog.dead_zone = 0;
+        analog.hysteresis = 0;
+        analog.min_interval_ms = 0;
+        analog.keepalive_ms = 0;
+        button.flags = 0;
+        matrix.flags = 0;
     }
 
     // Encode to buffer (returns number of bytes written, 0 on error)
@@ -97,6 +241,10 @@ struct Configure {
 
     // Decode from buffer (returns true on success)
     bool decode(const uint8_t* buffer, size_t length);
+
+private:
+    // Number of optional analog bytes to encode: fields are sent up to the last non-default one
+    size_t analogOptionCount() const;
 };
 
 // ConfigurationStored message - sent by device when configuration is successfully stored
@@ -133,6 +281,56 @@ struct InputValue {
     bool decode(const uint8_t* buffer, size_t length);
 };
 
+// InputValueExtended message - like InputValue, for inputs reported by extended input ID
+struct InputValueExtended {
+    uint16_t input_id;
+    int16_t value;
+
+    // Encode to buffer (returns number of bytes written, 0 on error)
+    size_t encode(uint8_t* buffer, size_t buffer_size) const;
+
+    // Decode from buffer (returns true on success)
+    bool decode(const uint8_t* buffer, size_t length);
+};
+
+// InputResolution message - sent by device to tell the host how many bits an analog input reports
+struct InputResolution {
+    uint8_t pin;
+    uint8_t bits; // Effective resolution (10 = plain analogRead, up to 13 with oversampling)
+
+    // Encode to buffer (returns number of bytes written, 0 on error)
+    size_t encode(uint8_t* buffer, size_t buffer_size) const;
+
+    // Decode from buffer (returns true on success)
+    bool decode(const uint8_t* buffer, size_t length);
+};
+
+// CalibrateNoise message - sent by host to measure the noise floor of every analog input
+struct CalibrateNoise {
+    uint16_t scans; // Measurement window (scans, ~10ms each)
+
+    // Encode to buffer (returns number of bytes written, 0 on error)
+    size_t encode(uint8_t* buffer, size_t buffer_size) const;
+
+    // Decode from buffer (returns true on success)
+    bool decode(const uint8_t* buffer, size_t length);
+};
+
+// NoiseStats message - sent by device for each analog input when noise calibration completes
+struct NoiseStats {
+    uint8_t pin;
+    uint16_t samples; // Scans measured
+    uint16_t min_value; // Lowest processed value seen
+    uint16_t max_value; // Highest processed value seen
+    uint8_t dead_zone; // Dead zone derived and stored for this input
+
+    // Encode to buffer (returns number of bytes written, 0 on error)
+    size_t encode(uint8_t* buffer, size_t buffer_size) const;
+
+    // Decode from buffer (returns true on success)
+    bool decode(const uint8_t* buffer, size_t length);
+};
+
 // Heartbeat message - sent periodically by device to keep connection alive
 struct Heartbeat {
     // Encode to buffer (returns number of bytes written, 0 on error)
@@ -167,6 +365,10 @@ struct Message {
         InputValue input_value;
         Heartbeat heartbeat;
         SetOutput set_output;
+        InputValueExtended input_value_extended;
+        InputResolution input_resolution;
+        CalibrateNoise calibrate_noise;
+        NoiseStats noise_stats;
     };
 
     Message()
@@ -202,6 +404,18 @@ struct Message {
 
     // Check if this is a SetOutput message
     bool isSetOutput() const { return message_type == MESSAGE_TYPE_SET_OUTPUT; }
+
+    // Check if this is an InputValueExtended message
+    bool isInputValueExtended() const { return message_type == MESSAGE_TYPE_INPUT_VALUE_EXTENDED; }
+
+    // Check if this is an InputResolution message
+    bool isInputResolution() const { return message_type == MESSAGE_TYPE_INPUT_RESOLUTION; }
+
+    // Check if this is a CalibrateNoise message
+    bool isCalibrateNoise() const { return message_type == MESSAGE_TYPE_CALIBRATE_NOISE; }
+
+    // Check if this is a NoiseStats message
+    bool isNoiseStats() const { return message_type == MESSAGE_TYPE_NOISE_STATS; }
 };
 
 } // namespace Protocol
@@ -0,0 +1,104 @@
+#include "resistor_ladder_sensor.h"
+#include "adc_engine.h"
+
+namespace Sensor {
+
+ResistorLadderSensor::ResistorLadderSensor(uint8_t pin_number, uint8_t debounce_scans, uint8_t button_count,
+                                           const uint16_t* threshold_values, uint16_t input_id_base)
+    : pin(pin_number)
+    , debounce_threshold(debounce_scans)
+    , num_buttons(button_count < MAX_BUTTONS ? button_count : MAX_BUTTONS)
+    , id_base(input_id_base)
+    , adc_slot(AdcEngine::NO_SLOT)
+    , held(0)
+    , candidate(0)
+    , debounce_count(0)
+    , pressed(0)
+    , pending(0)
+{
+    for (uint8_t i = 0; i < num_buttons; i++) {
+        thresholds[i] = threshold_values[i];
+    }
+    held = num_buttons;
+    candidate = num_buttons;
+}
+
+void ResistorLadderSensor::begin()
+{
+    // Register for background conversion (see AnalogSensor::begin for why there's no pinMode)
+    attachAdc();
+
+    // Reset state - nothing held
+    held = num_buttons;
+    candidate = num_buttons;
+    debounce_count = 0;
+    pressed = 0;
+    pending = 0;
+}
+
+void ResistorLadderSensor::attachAdc()
+{
+    adc_slot = AdcEngine::addChannel(pin);
+}
+
+uint8_t ResistorLadderSensor::decode(uint16_t value) const
+{
+    uint8_t button = 0;
+    while (button < num_buttons && value >= thresholds[button]) {
+        button++;
+    }
+    return button;
+}
+
+void ResistorLadderSensor::scan()
+{
+    uint16_t value = (adc_slot != AdcEngine::NO_SLOT) ? AdcEngine::read(adc_slot) : AdcEngine::readNow(pin);
+    uint8_t button = decode(value);
+
+    if (button == held) {
+        // Back to the debounced state - drop any partial change
+        candidate = held;
+        debounce_count = 0;
+        return;
+    }
+
+    if (button != candidate) {
+        // New value band - restart the debounce
+        candidate = button;
+        debounce_count = 0;
+    }
+
+    debounce_count++;
+    if (debounce_count < debounce_threshold) {
+        return;
+    }
+
+    // Accept: release the old button and press the new one (either may be "none")
+    uint8_t next = (button < num_buttons) ? (uint8_t)(1 << button) : 0;
+    pending |= pressed ^ next;
+    if (pending != 0) {
+        markReady();
+    }
+    pressed = next;
+    held = button;
+    debounce_count = 0;
+}
+
+Reading ResistorLadderSensor::getReading()
+{
+    if (pending == 0) {
+        return Reading(); // No unreported changes
+    }
+
+    // Lowest changed button first
+    uint8_t button = 0;
+    while ((pending & (1 << button)) == 0) {
+        button++;
+    }
+    pending &= (uint8_t)~(1 << button);
+
+    int16_t value = (pressed & (1 << button)) ? 1 : 0;
+    return Reading(value, InputType::ResistorLadder, (uint16_t)(id_base + button));
+}
+
+} // namespace Sensor
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "protocol.h"
+#include "sensor.h"
+#include <Arduino.h>
+
+namespace Sensor {
+
+// Resistor ladder sensor implementation
+// Decodes several buttons wired through a resistor ladder onto one analog pin.
+// Button i is held while the value is below thresholds[i] (and not below the
+// threshold of a lower button); at or above the last threshold nothing is held.
+// The decoded button is debounced in the value domain (it must stay the same
+// for debounce scans), so a value sweeping through other bands while a button
+// settles never registers them. Reports the same press/release edge events as
+// ButtonSensor using extended input IDs: id_base + button index.
+class ResistorLadderSensor : public ISensor {
+public:
+    static constexpr uint8_t MAX_BUTTONS = Protocol::MAX_LADDER_BUTTONS;
+
+private:
+    uint8_t pin; // Arduino pin number
+    uint8_t debounce_threshold; // Number of scans for debounce
+    uint8_t num_buttons; // Buttons on the ladder
+    uint16_t thresholds[MAX_BUTTONS]; // Ascending upper edge of each button's band
+    uint16_t id_base; // Extended input ID of button 0
+    uint8_t adc_slot; // Background ADC engine slot (AdcEngine::NO_SLOT if not registered)
+
+    // State
+    uint8_t held; // Debounced button index (num_buttons = none)
+    uint8_t candidate; // Button index seen on recent scans
+    uint8_t debounce_count; // Scans the candidate has been stable
+    uint8_t pressed; // Debounced state bitmask (bit = button index)
+    uint8_t pending; // Buttons with an unreported debounced change
+
+public:
+    ResistorLadderSensor(uint8_t pin_number, uint8_t debounce_scans, uint8_t button_count,
+                         const uint16_t* threshold_values, uint16_t input_id_base);
+
+    // ISensor interface implementation
+    void begin() override;
+    void attachAdc() override;
+    void scan() override;
+    Reading getReading() override;
+    InputType getType() const override { return InputType::ResistorLadder; }
+    uint8_t getPin() const override { return pin; }
+
+    // Button index for a value (num_buttons = none held)
+    uint8_t decode(uint16_t value) const;
+};
+
+} // namespace Sensor
@@ -8,7 +8,14 @@ namespace Sensor {
 enum class InputType : uint8_t {
     Analog = 0,
     Button = 1,
-    Matrix = 2
+    Matrix = 2,
+    ShiftRegister = 3,
+    I2CExpander = 4,
+    MuxAnalog = 5,
+    AnalogNotch = 6,
+    ResistorLadder = 7,
+    Encoder = 8,
+    ButtonGroup = 9
 };
 
 // Sensor reading result
@@ -16,7 +23,7 @@ struct Reading {
     bool has_value; // True if sensor has a value to report
     int16_t value; // Normalized integer value
     InputType type; // Type of input
-    uint8_t pin; // Pin number
+    uint16_t pin; // Pin number, or extended input ID (>= Protocol::EXTENDED_ID_BASE)
 
     Reading()
         : has_value(false)
@@ -26,7 +33,7 @@ struct Reading {
     {
     }
 
-    Reading(int16_t val, InputType t, uint8_t p)
+    Reading(int16_t val, InputType t, uint16_t p)
         : has_value(true)
         , value(val)
         , type(t)
@@ -35,6 +42,15 @@ struct Reading {
     }
 };
 
+// Most sensors that can share one set of ready flags
+constexpr uint8_t MAX_READY_SLOTS = 64;
+
+// Flags of the sensors with a reading pending, shared by one SensorManager
+struct ReadyFlags {
+    uint8_t any; // Bit b set = bits[b] has a flag set (0 = nothing pending)
+    uint8_t bits[MAX_READY_SLOTS / 8]; // Bit s % 8 of bits[s / 8] = slot s pending
+};
+
 // Base sensor interface
 class ISensor {
 public:
@@ -55,6 +71,31 @@ public:
 
     // Get the pin number
     virtual uint8_t getPin() const = 0;
+
+    // Register the sensor's background ADC channel again after AdcEngine::reset()
+    // (sensors that don't use the ADC engine have nothing to do)
+    virtual void attachAdc() { }
+
+    // Attach to shared ready flags: scan() sets the slot's flag when a reading is pending
+    void setReadyFlag(ReadyFlags* flags, uint8_t slot)
+    {
+        ready_flags = flags;
+        ready_slot = slot;
+    }
+
+protected:
+    // Flag this sensor for the next drain (no-op when not attached)
+    void markReady()
+    {
+        if (ready_flags != nullptr) {
+            ready_flags->bits[ready_slot / 8] |= (uint8_t)(1 << (ready_slot % 8));
+            ready_flags->any |= (uint8_t)(1 << (ready_slot / 8));
+        }
+    }
+
+private:
+    ReadyFlags* ready_flags = nullptr;
+    uint8_t ready_slot = 0;
 };
 
 } // namespace Sensor
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <new>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace Sensor {
+
+// Largest sizeof() among a list of types (for sizing an Arena at compile time)
+template <typename T>
+constexpr size_t largestSizeOf()
+{
+    return sizeof(T);
+}
+
+template <typename T, typename U, typename... Rest>
+constexpr size_t largestSizeOf()
+{
+    return sizeof(T) > largestSizeOf<U, Rest...>() ? sizeof(T) : largestSizeOf<U, Rest...>();
+}
+
+// Arena space an object of object_size takes: a size header, then the object,
+// both rounded up to the strictest alignment
+constexpr size_t arenaBlockSize(size_t object_size)
+{
+    return ((sizeof(size_t) + alignof(max_align_t) - 1) & ~(alignof(max_align_t) - 1))
+        + ((object_size + alignof(max_align_t) - 1) & ~(alignof(max_align_t) - 1));
+}
+
+// Fixed-size allocator for objects constructed in place
+// Blocks are laid out back to back, each behind a header with its size and a
+// free flag. create() reuses the first freed block that's big enough (splitting
+// off the rest) before growing, and release() merges a freed block with its free
+// neighbours, so objects can be replaced one at a time without leaking space.
+// Nothing touches the heap, so the RAM cost is a static buffer that shows up at
+// link time.
+template <size_t CAPACITY>
+class Arena {
+private:
+    static constexpr size_t HEADER_SIZE = arenaBlockSize(0);
+    static constexpr size_t FREE = ~(~(size_t)0 >> 1); // Top bit of a header
+
+    alignas(max_align_t) uint8_t buffer[CAPACITY];
+    size_t used; // End of the last block in use
+
+    size_t header(size_t offset) const
+    {
+        size_t value;
+        memcpy(&value, buffer + offset, sizeof(value));
+        return value;
+    }
+
+    void setHeader(size_t offset, size_t value) { memcpy(buffer + offset, &value, sizeof(value)); }
+
+public:
+    Arena()
+        : used(0)
+    {
+    }
+
+    // Construct a T in the arena; returns nullptr if it doesn't fit
+    template <typename T, typename... Args>
+    T* create(Args&&... args)
+    {
+        static_assert(alignof(T) <= alignof(max_align_t), "Arena blocks are aligned to max_align_t");
+        const size_t size = arenaBlockSize(sizeof(T));
+
+        // First freed block that's big enough, otherwise the end
+        size_t offset = 0;
+        while (offset < used && !((header(offset) & FREE) != 0 && (header(offset) & ~FREE) >= size)) {
+            offset += header(offset) & ~FREE;
+        }
+
+        if (offset < used) {
+            size_t block = header(offset) & ~FREE;
+            if (block - size >= arenaBlockSize(1)) {
+                setHeader(offset + size, (block - size) | FREE);
+                block = size;
+            }
+            setHeader(offset, block);
+        } else {
+            if (size > CAPACITY - used) {
+                return nullptr;
+            }
+            setHeader(offset, size);
+            used += size;
+        }
+
+        return new (buffer + offset + HEADER_SIZE) T(static_cast<Args&&>(args)...);
+    }
+
+    // Free the block of an object (its destructor must already have run);
+    // any pointer into the object will do
+    void release(const void* object)
+    {
+        size_t at = (size_t)((const uint8_t*)object - buffer);
+        size_t offset = 0;
+        while (offset < used && offset + (header(offset) & ~FREE) <= at) {
+            offset += header(offset) & ~FREE;
+        }
+        if (offset >= used) {
+            return;
+        }
+        setHeader(offset, header(offset) | FREE);
+
+        // Merge runs of free blocks, and drop a free run at the end
+        for (offset = 0; offset < used;) {
+            size_t block = header(offset);
+            if ((block & FREE) != 0) {
+                block &= ~FREE;
+                while (offset + block < used && (header(offset + block) & FREE) != 0) {
+                    block += header(offset + block) & ~FREE;
+                }
+                if (offset + block == used) {
+                    used = offset;
+                    break;
+                }
+                setHeader(offset, block | FREE);
+            }
+            offset += block;
+        }
+    }
+
+    // Release everything at once (destructors must already have run)
+    void reset() { used = 0; }
+
+    // Bytes up to the end of the last block in use (freed blocks before it included)
+    size_t bytesUsed() const { return used; }
+    static constexpr size_t capacity() { return CAPACITY; }
+};
+
+} // namespace Sensor
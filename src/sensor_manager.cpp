@@ -1,115 +1,560 @@
 #include "sensor_manager.h"
+#include "adc_engine.h"
 
 namespace SensorManager {
 
-// Array of sensor pointers
+// Storage for the sensor objects, and pointers into it grouped by type:
+// [0, g_analog_end) analog, then buttons up to g_button_end, matrices up to
+// g_matrix_end and every other type up to g_sensor_count. The common types are
+// final, so the per-type loops call them directly rather than through ISensor.
+static Sensor::Arena<ARENA_SIZE> g_arena;
 static Sensor::ISensor* g_sensors[MAX_SENSORS];
+static uint8_t g_analog_end = 0;
+static uint8_t g_button_end = 0;
+static uint8_t g_matrix_end = 0;
 static uint8_t g_sensor_count = 0;
 
+// Index of the input each slot's sensor was built from, and the input count and
+// generation of that configuration (updateConfiguration() compares against it)
+static uint8_t g_input_index[MAX_SENSORS];
+static uint8_t g_built_inputs = 0;
+static uint32_t g_built_generation = 0;
+
+// Slot i flagged = g_sensors[i] has a reading pending since its last scan()
+static Sensor::ReadyFlags g_ready;
+static_assert(MAX_SENSORS <= Sensor::MAX_READY_SLOTS, "Ready flags need a slot per sensor");
+
 // Index for round-robin reading retrieval
 static uint8_t g_next_reading_index = 0;
 
-void init()
+// Scans left in the noise calibration window (0 = not calibrating)
+static uint16_t g_calibration_scans_left = 0;
+static bool g_calibration_complete = false;
+
+static_assert(sizeof(g_arena) + sizeof(g_sensors) + sizeof(g_analog_end) + sizeof(g_button_end)
+            + sizeof(g_matrix_end) + sizeof(g_sensor_count) + sizeof(g_input_index) + sizeof(g_built_inputs)
+            + sizeof(g_built_generation) + sizeof(g_ready) + sizeof(g_next_reading_index)
+            + sizeof(g_calibration_scans_left) + sizeof(g_calibration_complete)
+        <= STATIC_RAM,
+    "SensorManager::STATIC_RAM doesn't cover the sensor tables");
+
+// Clear every sensor's ready flag
+static void clearReadyFlags()
 {
-    // Clear all sensors
-    for (uint8_t i = 0; i < MAX_SENSORS; i++) {
-        if (g_sensors[i] != nullptr) {
-            delete g_sensors[i];
-            g_sensors[i] = nullptr;
-        }
+    g_ready.any = 0;
+    for (uint8_t i = 0; i < sizeof(g_ready.bits); i++) {
+        g_ready.bits[i] = 0;
     }
-    g_sensor_count = 0;
+}
+
+// Destroy all sensors, last slot first, and free the arena
+static void destroySensors()
+{
+    while (g_sensor_count > 0) {
+        g_sensor_count--;
+        g_sensors[g_sensor_count]->~ISensor();
+        g_sensors[g_sensor_count] = nullptr;
+    }
+    g_analog_end = 0;
+    g_button_end = 0;
+    g_matrix_end = 0;
+    g_built_inputs = 0;
+    g_built_generation = 0;
+    clearReadyFlags();
+    g_arena.reset();
+}
+
+// Insert a sensor built from input index at the end of its type's group
+static void addSensor(Sensor::ISensor* sensor, uint8_t input_type, uint8_t index)
+{
+    uint8_t slot = g_sensor_count;
+    switch (input_type) {
+    case Protocol::INPUT_TYPE_ANALOG:
+        slot = g_analog_end++;
+        g_button_end++;
+        g_matrix_end++;
+        break;
+    case Protocol::INPUT_TYPE_BUTTON:
+        slot = g_button_end++;
+        g_matrix_end++;
+        break;
+    case Protocol::INPUT_TYPE_MATRIX:
+        slot = g_matrix_end++;
+        break;
+    }
+
+    for (uint8_t i = g_sensor_count; i > slot; i--) {
+        g_sensors[i] = g_sensors[i - 1];
+        g_input_index[i] = g_input_index[i - 1];
+    }
+    g_sensors[slot] = sensor;
+    g_input_index[slot] = index;
+    g_sensor_count++;
+}
+
+// Attach every slot to the ready flags, once each sensor is in its group
+static void assignReadyFlags()
+{
+    for (uint8_t i = 0; i < g_sensor_count; i++) {
+        g_sensors[i]->setReadyFlag(&g_ready, i);
+    }
+}
+
+// Input types whose readings carry the input's index (extended input IDs), so
+// a sensor can only be kept for an input at the same index
+static bool usesInputIndex(uint8_t input_type)
+{
+    return input_type == Protocol::INPUT_TYPE_SHIFT_REGISTER
+        || input_type == Protocol::INPUT_TYPE_I2C_EXPANDER
+        || input_type == Protocol::INPUT_TYPE_ANALOG_MUX
+        || input_type == Protocol::INPUT_TYPE_RESISTOR_LADDER;
+}
+
+// Create the sensor for input index in the arena (nullptr if it doesn't fit)
+static Sensor::ISensor* createSensor(const ConfigManager::InputConfig& config, uint8_t i)
+{
+    // Create sensor based on input type
+    switch (config.input_type) {
+    case Protocol::INPUT_TYPE_ANALOG: {
+        Sensor::AnalogOptions options;
+        options.oversample = config.analog.oversample;
+        options.filter = config.analog.filter;
+        options.filter_alpha = config.analog.filter_alpha;
+        options.filter_beta = config.analog.filter_beta;
+        options.median = config.analog.median;
+        options.dead_zone = config.analog.dead_zone;
+        options.hysteresis = config.analog.hysteresis;
+        options.min_interval_ms = config.analog.min_interval_ms;
+        options.keepalive_ms = config.analog.keepalive_ms;
+        return g_arena.create<Sensor::AnalogSensor>(config.analog.pin, config.analog.sensitivity, options);
+    }
+
+    case Protocol::INPUT_TYPE_BUTTON:
+        return g_arena.create<Sensor::ButtonSensor>(
+            config.button.pin,
+            config.button.debounce,
+            (config.button.flags & Protocol::BUTTON_FLAG_EAGER_DEBOUNCE) != 0,
+            (config.button.flags & Protocol::BUTTON_FLAG_INTERRUPT) != 0);
+
+    case Protocol::INPUT_TYPE_MATRIX:
+        return g_arena.create<Sensor::MatrixSensor>(
+            config.matrix.num_row_pins,
+            config.matrix.num_col_pins,
+            config.matrix.pins, // row pins
+            config.matrix.pins + config.matrix.num_row_pins, // col pins
+            (config.matrix.flags & Protocol::MATRIX_FLAG_NO_DIODES) == 0,
+            (config.matrix.flags & Protocol::MATRIX_FLAG_EAGER_DEBOUNCE) != 0);
+
+    case Protocol::INPUT_TYPE_SHIFT_REGISTER:
+        return g_arena.create<Sensor::ShiftRegisterSensor>(
+            config.shift_register.latch_pin,
+            config.shift_register.num_registers,
+            Protocol::extendedInputId(i, 0));
+
+    case Protocol::INPUT_TYPE_I2C_EXPANDER:
+        return g_arena.create<Sensor::I2CExpanderSensor>(
+            config.expander.chip,
+            config.expander.address,
+            config.expander.int_pin,
+            Protocol::extendedInputId(i, 0));
+
+    case Protocol::INPUT_TYPE_ANALOG_MUX:
+        return g_arena.create<Sensor::MuxAnalogSensor>(
+            config.analog_mux.adc_pin,
+            config.analog_mux.sensitivity,
+            config.analog_mux.num_channels,
+            config.analog_mux.settle_us,
+            config.analog_mux.select_pins,
+            Protocol::extendedInputId(i, 0));
+
+    case Protocol::INPUT_TYPE_ANALOG_NOTCH:
+        return g_arena.create<Sensor::NotchSensor>(
+            config.notch.pin,
+            config.notch.hysteresis,
+            config.notch.num_thresholds,
+            config.notch.thresholds);
+
+    case Protocol::INPUT_TYPE_RESISTOR_LADDER:
+        return g_arena.create<Sensor::ResistorLadderSensor>(
+            config.ladder.pin,
+            config.ladder.debounce,
+            config.ladder.num_buttons,
+            config.ladder.thresholds,
+            Protocol::extendedInputId(i, 0));
+
+    case Protocol::INPUT_TYPE_ENCODER:
+        return g_arena.create<Sensor::EncoderSensor>(
+            config.encoder.pin_a,
+            config.encoder.pin_b,
+            config.encoder.steps_per_detent,
+            config.encoder.sensitivity);
+
+    case Protocol::INPUT_TYPE_BUTTON_GROUP:
+        return g_arena.create<Sensor::ButtonGroupSensor>(
+            config.button_group.num_pins,
+            config.button_group.pins,
+            config.button_group.debounce);
+
+    default:
+        // Unknown input type (not accepted into a ConfigImage)
+        return nullptr;
+    }
+}
+
+// Size of the sensor an input type creates (0 for an unknown type)
+static size_t sensorSize(uint8_t input_type)
+{
+    switch (input_type) {
+    case Protocol::INPUT_TYPE_ANALOG:
+        return sizeof(Sensor::AnalogSensor);
+    case Protocol::INPUT_TYPE_BUTTON:
+        return sizeof(Sensor::ButtonSensor);
+    case Protocol::INPUT_TYPE_MATRIX:
+        return sizeof(Sensor::MatrixSensor);
+    case Protocol::INPUT_TYPE_SHIFT_REGISTER:
+        return sizeof(Sensor::ShiftRegisterSensor);
+    case Protocol::INPUT_TYPE_I2C_EXPANDER:
+        return sizeof(Sensor::I2CExpanderSensor);
+    case Protocol::INPUT_TYPE_ANALOG_MUX:
+        return sizeof(Sensor::MuxAnalogSensor);
+    case Protocol::INPUT_TYPE_ANALOG_NOTCH:
+        return sizeof(Sensor::NotchSensor);
+    case Protocol::INPUT_TYPE_RESISTOR_LADDER:
+        return sizeof(Sensor::ResistorLadderSensor);
+    case Protocol::INPUT_TYPE_ENCODER:
+        return sizeof(Sensor::EncoderSensor);
+    case Protocol::INPUT_TYPE_BUTTON_GROUP:
+        return sizeof(Sensor::ButtonGroupSensor);
+    default:
+        return 0;
+    }
+}
+
+// Whether the sensors of a configuration fit the arena when built from scratch
+// (each packed input starts with its type byte)
+static bool fitsArena(const ConfigManager::ConfigImage& inputs)
+{
+    if (inputs.getNumInputs() > MAX_SENSORS) {
+        return false;
+    }
+
+    size_t required = 0;
+    size_t offset = 0;
+    for (uint8_t i = 0; i < inputs.getNumInputs(); i++) {
+        required += Sensor::arenaBlockSize(sensorSize(inputs.getData()[offset]));
+        offset = inputs.next(offset);
+    }
+    return required <= ARENA_SIZE;
+}
+
+// getReading() of the sensor in a slot, called directly for the typed sensors
+static Sensor::Reading readingOf(uint8_t index)
+{
+    if (index < g_analog_end) {
+        return static_cast<Sensor::AnalogSensor*>(g_sensors[index])->getReading();
+    }
+    if (index < g_button_end) {
+        return static_cast<Sensor::ButtonSensor*>(g_sensors[index])->getReading();
+    }
+    if (index < g_matrix_end) {
+        return static_cast<Sensor::MatrixSensor*>(g_sensors[index])->getReading();
+    }
+    return g_sensors[index]->getReading();
+}
+
+void init()
+{
+    destroySensors();
     g_next_reading_index = 0;
+    g_calibration_scans_left = 0;
+    g_calibration_complete = false;
+
+    AdcEngine::reset();
 }
 
-bool applyConfiguration(const ConfigManager::InputConfig* inputs, uint8_t input_count)
+bool applyConfiguration(const ConfigManager::ConfigImage& inputs)
 {
+    // Reject a configuration that can't run before touching the running one
+    if (!fitsArena(inputs)) {
+        return false;
+    }
+
     // Clear existing sensors
-    for (uint8_t i = 0; i < MAX_SENSORS; i++) {
-        if (g_sensors[i] != nullptr) {
-            delete g_sensors[i];
-            g_sensors[i] = nullptr;
+    destroySensors();
+    g_next_reading_index = 0;
+
+    // Sensors being calibrated are gone
+    g_calibration_scans_left = 0;
+    g_calibration_complete = false;
+
+    // Stop background conversions - analog sensors re-register in begin()
+    AdcEngine::reset();
+
+    // Create sensors based on configuration, unpacking one input at a time
+    ConfigManager::InputConfig config;
+    size_t offset = 0;
+    for (uint8_t i = 0; i < inputs.getNumInputs(); i++) {
+        offset = inputs.read(offset, config);
+
+        Sensor::ISensor* sensor = createSensor(config, i);
+        if (sensor == nullptr) {
+            // Unknown input type - run nothing rather than part of the configuration
+            destroySensors();
+            AdcEngine::reset();
+            return false;
         }
+
+        sensor->begin();
+        addSensor(sensor, config.input_type, i);
     }
-    g_sensor_count = 0;
-    g_next_reading_index = 0;
 
-    // Validate input count
-    if (input_count > MAX_SENSORS) {
+    // Slots are final once every sensor is in its group
+    assignReadyFlags();
+    g_built_inputs = inputs.getNumInputs();
+    g_built_generation = inputs.getGeneration();
+
+    // Convert the registered analog channels in the background from now on
+    AdcEngine::start();
+
+    return true;
+}
+
+bool updateConfiguration(const ConfigManager::ConfigImage& inputs, const ConfigManager::ConfigImage& built_from)
+{
+    // Nothing is destroyed for a configuration that can't run (the running
+    // sensors keep scanning)
+    if (!fitsArena(inputs)) {
         return false;
     }
 
-    // Create sensors based on configuration
-    for (uint8_t i = 0; i < input_count; i++) {
-        const ConfigManager::InputConfig& config = inputs[i];
+    // Nothing running, or not what the running sensors were built from: rebuild
+    if (g_sensor_count == 0 || built_from.getGeneration() != g_built_generation) {
+        return applyConfiguration(inputs);
+    }
 
-        Sensor::ISensor* sensor = nullptr;
+    // Where each input the sensors were built from starts
+    uint16_t built_offsets[MAX_SENSORS];
+    size_t offset = 0;
+    for (uint8_t i = 0; i < g_built_inputs; i++) {
+        built_offsets[i] = (uint16_t)offset;
+        offset = built_from.next(offset);
+    }
 
-        // Create sensor based on input type
-        switch (config.input_type) {
-        case Protocol::INPUT_TYPE_ANALOG:
-            sensor = new Sensor::AnalogSensor(config.analog.pin, config.analog.sensitivity);
-            break;
+    // Pair each new input with a running sensor built from the same input
+    // (analog inputs whose dead zone changed are retuned in place)
+    Sensor::ISensor* sensors[MAX_SENSORS];
+    uint8_t kept[MAX_SENSORS / 8] = { 0 }; // Bit per slot of the running sensors
+    ConfigManager::InputConfig config;
+    offset = 0;
+    for (uint8_t i = 0; i < inputs.getNumInputs(); i++) {
+        size_t next = inputs.read(offset, config);
+        sensors[i] = nullptr;
 
-        case Protocol::INPUT_TYPE_BUTTON:
-            sensor = new Sensor::ButtonSensor(config.button.pin, config.button.debounce);
-            break;
+        for (uint8_t slot = 0; slot < g_sensor_count; slot++) {
+            uint8_t built_index = g_input_index[slot];
+            if ((kept[slot / 8] & (1 << (slot % 8))) != 0
+                || (usesInputIndex(config.input_type) && built_index != i)) {
+                continue;
+            }
 
-        case Protocol::INPUT_TYPE_MATRIX:
-            sensor = new Sensor::MatrixSensor(
-                config.matrix.num_row_pins,
-                config.matrix.num_col_pins,
-                config.matrix.pins, // row pins
-                config.matrix.pins + config.matrix.num_row_pins); // col pins
+            ConfigManager::InputChange change = ConfigManager::compareInputs(
+                built_from, built_offsets[built_index], inputs, offset);
+            if (change == ConfigManager::InputChange::Different) {
+                continue;
+            }
+            if (change == ConfigManager::InputChange::Retune) {
+                static_cast<Sensor::AnalogSensor*>(g_sensors[slot])->setDeadZone(config.analog.dead_zone);
+            }
+
+            kept[slot / 8] |= (uint8_t)(1 << (slot % 8));
+            sensors[i] = g_sensors[slot];
             break;
+        }
+        offset = next;
+    }
 
-        default:
-            // Unknown input type - skip
+    // A calibration window spans sensors that may be gone
+    for (uint8_t slot = 0; slot < g_analog_end; slot++) {
+        static_cast<Sensor::AnalogSensor*>(g_sensors[slot])->stopNoiseCalibration();
+    }
+    g_calibration_scans_left = 0;
+    g_calibration_complete = false;
+
+    // Destroy the sensors nothing was paired with (releasing their pins and
+    // interrupts before the new sensors claim them), last slot first, and free
+    // their arena space for the new sensors
+    for (uint8_t slot = g_sensor_count; slot > 0; slot--) {
+        if ((kept[(slot - 1) / 8] & (1 << ((slot - 1) % 8))) == 0) {
+            g_sensors[slot - 1]->~ISensor();
+            g_arena.release(g_sensors[slot - 1]);
+        }
+        g_sensors[slot - 1] = nullptr;
+    }
+    g_sensor_count = 0;
+    g_analog_end = 0;
+    g_button_end = 0;
+    g_matrix_end = 0;
+
+    // Channels are registered again: the kept sensors', then the new ones' in begin()
+    AdcEngine::reset();
+    for (uint8_t i = 0; i < inputs.getNumInputs(); i++) {
+        if (sensors[i] != nullptr) {
+            sensors[i]->attachAdc();
+        }
+    }
+
+    // Create the sensors for the new and changed inputs
+    offset = 0;
+    for (uint8_t i = 0; i < inputs.getNumInputs(); i++) {
+        offset = inputs.read(offset, config);
+        if (sensors[i] != nullptr) {
             continue;
         }
 
-        if (sensor != nullptr) {
-            sensor->begin();
-            g_sensors[g_sensor_count++] = sensor;
+        sensors[i] = createSensor(config, i);
+        if (sensors[i] == nullptr) {
+            // Out of arena space (the freed blocks are too fragmented for it) -
+            // drop everything and rebuild from scratch, which fitsArena() says fits
+            for (uint8_t j = inputs.getNumInputs(); j > 0; j--) {
+                if (sensors[j - 1] != nullptr) {
+                    sensors[j - 1]->~ISensor();
+                }
+            }
+            return applyConfiguration(inputs);
         }
+        sensors[i]->begin();
+    }
+
+    // Rebuild the slots in configuration order, grouped by type
+    offset = 0;
+    for (uint8_t i = 0; i < inputs.getNumInputs(); i++) {
+        offset = inputs.read(offset, config);
+        addSensor(sensors[i], config.input_type, i);
+    }
+    assignReadyFlags();
+    g_built_inputs = inputs.getNumInputs();
+    g_built_generation = inputs.getGeneration();
+    g_next_reading_index = 0;
+
+    // Flag every slot once: kept sensors may hold readings flagged under their
+    // old slots (the first drain clears the ones with nothing to send)
+    clearReadyFlags();
+    for (uint8_t slot = 0; slot < g_sensor_count; slot++) {
+        g_ready.bits[slot / 8] |= (uint8_t)(1 << (slot % 8));
+        g_ready.any |= (uint8_t)(1 << (slot / 8));
     }
 
+    AdcEngine::start();
+
     return true;
 }
 
 void scan()
 {
-    // Scan all active sensors
-    for (uint8_t i = 0; i < g_sensor_count; i++) {
-        if (g_sensors[i] != nullptr) {
-            g_sensors[i]->scan();
-        }
+    // Scan all active sensors, one tight loop per type (analog reads back-to-back)
+    uint8_t i = 0;
+    for (; i < g_analog_end; i++) {
+        static_cast<Sensor::AnalogSensor*>(g_sensors[i])->scan();
+    }
+    for (; i < g_button_end; i++) {
+        static_cast<Sensor::ButtonSensor*>(g_sensors[i])->scan();
+    }
+    for (; i < g_matrix_end; i++) {
+        static_cast<Sensor::MatrixSensor*>(g_sensors[i])->scan();
+    }
+    for (; i < g_sensor_count; i++) {
+        g_sensors[i]->scan();
+    }
+
+    if (g_calibration_scans_left > 0 && --g_calibration_scans_left == 0) {
+        g_calibration_complete = true;
     }
 }
 
 bool getNextReading(Sensor::Reading& reading)
 {
-    // Check all sensors starting from the next index (round-robin)
-    for (uint8_t i = 0; i < g_sensor_count; i++) {
-        uint8_t index = (g_next_reading_index + i) % g_sensor_count;
-
-        if (g_sensors[index] != nullptr) {
-            Sensor::Reading r = g_sensors[index]->getReading();
-            if (r.has_value) {
-                reading = r;
-                // Move to next sensor for next call
-                g_next_reading_index = (index + 1) % g_sensor_count;
-                return true;
-            }
+    // Only sensors that flagged a reading during scan() are visited, starting
+    // from the next index (round-robin); a quiet tick ends at the first check
+    for (uint8_t i = 0; g_ready.any != 0 && i < g_sensor_count; i++) {
+        uint8_t index = (uint8_t)((g_next_reading_index + i) % g_sensor_count);
+        uint8_t group = index / 8;
+        uint8_t bit = (uint8_t)(1 << (index % 8));
+
+        if (g_ready.bits[group] == 0) {
+            // Nothing flagged in this group of 8 - skip to its end (or the last sensor)
+            uint8_t group_end = (uint8_t)(index | 7);
+            uint8_t last = (uint8_t)(g_sensor_count - 1);
+            i = (uint8_t)(i + (group_end < last ? group_end : last) - index);
+            continue;
+        }
+        if ((g_ready.bits[group] & bit) == 0) {
+            continue;
+        }
+
+        Sensor::Reading r = readingOf(index);
+        if (r.has_value) {
+            reading = r;
+            // Move to next sensor for next call (it stays flagged until it runs dry)
+            g_next_reading_index = (uint8_t)((index + 1) % g_sensor_count);
+            return true;
+        }
+
+        g_ready.bits[group] &= (uint8_t)~bit;
+        if (g_ready.bits[group] == 0) {
+            g_ready.any &= (uint8_t)~(1 << group);
         }
     }
 
     return false; // No readings available
 }
 
+void adoptConfiguration(const ConfigManager::ConfigImage& inputs)
+{
+    if (g_sensor_count > 0 && inputs.getNumInputs() == g_built_inputs) {
+        g_built_generation = inputs.getGeneration();
+    }
+}
+
 uint8_t getSensorCount()
 {
     return g_sensor_count;
 }
 
+size_t getArenaUsage()
+{
+    return g_arena.bytesUsed();
+}
+
+void startNoiseCalibration(uint16_t scans)
+{
+    for (uint8_t i = 0; i < g_analog_end; i++) {
+        static_cast<Sensor::AnalogSensor*>(g_sensors[i])->startNoiseCalibration();
+    }
+
+    // A new request restarts the window
+    g_calibration_scans_left = scans;
+    g_calibration_complete = false;
+}
+
+bool noiseCalibrationComplete()
+{
+    if (!g_calibration_complete) {
+        return false;
+    }
+
+    g_calibration_complete = false;
+    return true;
+}
+
+Sensor::AnalogSensor* findAnalogSensor(uint8_t pin)
+{
+    for (uint8_t i = 0; i < g_analog_end; i++) {
+        if (g_sensors[i]->getPin() == pin) {
+            return static_cast<Sensor::AnalogSensor*>(g_sensors[i]);
+        }
+    }
+
+    return nullptr;
+}
+
 } // namespace SensorManager
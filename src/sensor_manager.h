@@ -1,23 +1,91 @@
 #pragma once
 
 #include "analog_sensor.h"
+#include "button_group_sensor.h"
 #include "button_sensor.h"
 #include "config_manager.h"
+#include "encoder_sensor.h"
+#include "i2c_expander_sensor.h"
 #include "matrix_sensor.h"
+#include "mux_analog_sensor.h"
+#include "notch_sensor.h"
+#include "resistor_ladder_sensor.h"
 #include "sensor.h"
+#include "sensor_arena.h"
+#include "shift_register_sensor.h"
 #include <stdint.h>
 
 namespace SensorManager {
 
 // Maximum number of sensors (matches MAX_INPUTS in config_manager)
-constexpr uint8_t MAX_SENSORS = 8;
+constexpr uint8_t MAX_SENSORS = ConfigManager::MAX_INPUTS;
+
+// Largest sensor object any input type can create
+constexpr size_t LARGEST_SENSOR_SIZE = Sensor::largestSizeOf<
+    Sensor::AnalogSensor,
+    Sensor::ButtonSensor,
+    Sensor::MatrixSensor,
+    Sensor::ShiftRegisterSensor,
+    Sensor::I2CExpanderSensor,
+    Sensor::MuxAnalogSensor,
+    Sensor::NotchSensor,
+    Sensor::ResistorLadderSensor,
+    Sensor::EncoderSensor,
+    Sensor::ButtonGroupSensor>();
+
+// Analog inputs on the small AVR boards (A0-A7 on the Nano)
+constexpr uint8_t SMALL_BOARD_ANALOG_INPUTS = 8;
+
+// Arena for boards with little SRAM: enough for max_sensors buttons or an
+// analog input on every analog pin, whichever takes more (larger types fit fewer)
+constexpr size_t smallArenaSize(uint8_t max_sensors)
+{
+    return max_sensors * Sensor::arenaBlockSize(sizeof(Sensor::ButtonSensor))
+            > SMALL_BOARD_ANALOG_INPUTS * Sensor::arenaBlockSize(sizeof(Sensor::AnalogSensor))
+        ? max_sensors * Sensor::arenaBlockSize(sizeof(Sensor::ButtonSensor))
+        : SMALL_BOARD_ANALOG_INPUTS * Sensor::arenaBlockSize(sizeof(Sensor::AnalogSensor));
+}
+
+// Static storage for all sensor objects (no heap)
+// The budget is fixed and a configuration that needs more is rejected: on AVR
+// smallArenaSize(MAX_SENSORS), elsewhere MAX_SENSORS analog inputs plus 8 of the
+// largest type (override with -DSENSOR_ARENA_SIZE=<bytes>).
+#if defined(SENSOR_ARENA_SIZE)
+constexpr size_t ARENA_SIZE = SENSOR_ARENA_SIZE;
+#elif defined(__AVR__)
+constexpr size_t ARENA_SIZE = smallArenaSize(MAX_SENSORS) > Sensor::arenaBlockSize(LARGEST_SENSOR_SIZE)
+    ? smallArenaSize(MAX_SENSORS)
+    : Sensor::arenaBlockSize(LARGEST_SENSOR_SIZE);
+#else
+constexpr size_t ARENA_SIZE = MAX_SENSORS * Sensor::arenaBlockSize(sizeof(Sensor::AnalogSensor))
+    + 8 * Sensor::arenaBlockSize(LARGEST_SENSOR_SIZE);
+#endif
+static_assert(ARENA_SIZE >= Sensor::arenaBlockSize(LARGEST_SENSOR_SIZE), "Sensor arena can't hold the largest sensor");
+
+// SRAM taken by the sensor manager: the arena, the per-slot tables and the
+// scalars around them (for the build-time SRAM check in main.cpp)
+constexpr size_t STATIC_RAM = sizeof(Sensor::Arena<ARENA_SIZE>) + MAX_SENSORS * (sizeof(Sensor::ISensor*) + 1)
+    + sizeof(Sensor::ReadyFlags) + 16;
 
 // Initialize sensor manager with configuration from ConfigManager
 void init();
 
 // Apply configuration - creates sensors based on configuration
-// Returns true if configuration was successfully applied
-bool applyConfiguration(const ConfigManager::InputConfig* inputs, uint8_t input_count);
+// Returns true if configuration was successfully applied (false if there are too
+// many inputs or the sensors don't fit in the arena, checked before the running
+// sensors are destroyed, so they keep running)
+bool applyConfiguration(const ConfigManager::ConfigImage& inputs);
+
+// Switch to a new configuration, keeping the sensors (and their debounce, filter
+// and pending state) of inputs that didn't change; built_from must be the
+// configuration the running sensors were built from, unchanged since (checked by
+// its generation), otherwise (or when the freed arena space is too fragmented)
+// this is a full applyConfiguration(). Same return value.
+bool updateConfiguration(const ConfigManager::ConfigImage& inputs, const ConfigManager::ConfigImage& built_from);
+
+// The running sensors were retuned along with a change to the configuration they
+// were built from (e.g. calibrated dead zones), so they now match inputs
+void adoptConfiguration(const ConfigManager::ConfigImage& inputs);
 
 // Scan all sensors (read values, update running averages)
 void scan();
@@ -30,4 +98,16 @@ bool getNextReading(Sensor::Reading& reading);
 // Get number of active sensors
 uint8_t getSensorCount();
 
+// Bytes of the sensor arena used by the current configuration
+size_t getArenaUsage();
+
+// Measure the noise floor of every analog input for the given number of scans
+void startNoiseCalibration(uint16_t scans);
+
+// Returns true once, on the scan that ends the calibration window
+bool noiseCalibrationComplete();
+
+// Find the analog sensor on a pin (nullptr if none)
+Sensor::AnalogSensor* findAnalogSensor(uint8_t pin);
+
 } // namespace SensorManager
@@ -0,0 +1,66 @@
+#include "shift_register_sensor.h"
+#include <string.h>
+
+namespace Sensor {
+
+ShiftRegisterSensor::ShiftRegisterSensor(uint8_t latch, uint8_t registers, uint16_t input_id_base)
+    : latch_pin(latch)
+    , num_registers(registers < MAX_REGISTERS ? registers : MAX_REGISTERS)
+    , id_base(input_id_base)
+    , next_register(0)
+{
+    memset(pending, 0, sizeof(pending));
+}
+
+void ShiftRegisterSensor::begin()
+{
+    // Latch idles HIGH (shift mode)
+    pinMode(latch_pin, OUTPUT);
+    digitalWrite(latch_pin, HIGH);
+
+    SPI.begin();
+
+    // Reset state
+    for (uint8_t i = 0; i < num_registers; i++) {
+        debouncers[i].reset();
+    }
+    memset(pending, 0, sizeof(pending));
+    next_register = 0;
+}
+
+void ShiftRegisterSensor::scan()
+{
+    SPI.beginTransaction(SPISettings(SPI_CLOCK_HZ, MSBFIRST, SPI_MODE0));
+
+    // Pulse SH/LD low to capture all parallel inputs into the chain
+    digitalWrite(latch_pin, LOW);
+    digitalWrite(latch_pin, HIGH);
+
+    // Clock the whole chain out, one byte per register
+    // MSB first puts input H in bit 7 and input A in bit 0
+    for (uint8_t i = 0; i < num_registers; i++) {
+        uint8_t sample = (uint8_t)~SPI.transfer(0x00); // Active LOW
+        pending[i] |= debouncers[i].update(sample);
+        if (pending[i] != 0) {
+            markReady();
+        }
+    }
+
+    SPI.endTransaction();
+}
+
+Reading ShiftRegisterSensor::getReading()
+{
+    uint8_t index;
+    if (!takePendingBit(pending, num_registers, next_register, index)) {
+        return Reading(); // No events to report
+    }
+
+    // value = 1 for press, 0 for release
+    uint8_t mask = (uint8_t)(1 << (index % 8));
+    int16_t value = (debouncers[index / 8].getState() & mask) ? 1 : 0;
+
+    return Reading(value, InputType::ShiftRegister, (uint16_t)(id_base + index));
+}
+
+} // namespace Sensor
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "protocol.h"
+#include "sensor.h"
+#include "vertical_debounce.h"
+#include <Arduino.h>
+#include <SPI.h>
+
+namespace Sensor {
+
+// Shift register chain sensor implementation
+// Reads a daisy-chain of 74HC165 parallel-in shift registers over hardware SPI
+// (SCK -> CLK, MISO -> QH of the first register) and debounces each byte with a
+// bit-parallel vertical counter. Inputs are active LOW (switch to GND with pullups).
+// Reports edge events for each input using extended input IDs: id_base + index,
+// where index = register * 8 + bit (bit 0 = input A of the register).
+class ShiftRegisterSensor : public ISensor {
+public:
+    // Maximum chain length (to avoid dynamic allocation)
+    static constexpr uint8_t MAX_REGISTERS = Protocol::MAX_SHIFT_REGISTERS;
+
+    // SPI clock for the chain (74HC165 is good for well above this at 5V)
+    static constexpr uint32_t SPI_CLOCK_HZ = 8000000;
+
+private:
+    uint8_t latch_pin; // SH/LD pin (LOW = load parallel inputs)
+    uint8_t num_registers; // Number of registers in the chain
+    uint16_t id_base; // Extended input ID of input 0
+
+    // Per-register state
+    VerticalDebouncer debouncers[MAX_REGISTERS];
+    uint8_t pending[MAX_REGISTERS]; // Bits with an unreported debounced change
+
+    // Register to resume reporting from (round-robin over the chain)
+    uint8_t next_register;
+
+public:
+    ShiftRegisterSensor(uint8_t latch, uint8_t registers, uint16_t input_id_base);
+
+    // ISensor interface implementation
+    void begin() override;
+    void scan() override;
+    Reading getReading() override;
+    InputType getType() const override { return InputType::ShiftRegister; }
+    uint8_t getPin() const override { return latch_pin; }
+};
+
+} // namespace Sensor
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace Sensor {
+
+// Bit-parallel debouncer for 8 inputs using a three-bit vertical counter
+// Bit i of cnt0/cnt1/cnt2 is the counter for input i, so a whole byte of inputs
+// is debounced with a handful of logic operations instead of 8 counters.
+// A bit's debounced state flips after `samples` consecutive samples that differ
+// from it - the same rule ButtonSensor applies to a single pin.
+class VerticalDebouncer {
+public:
+    static constexpr uint8_t DEBOUNCE_SAMPLES = 3; // Default samples to commit a change
+    static constexpr uint8_t MAX_DEBOUNCE_SAMPLES = 7; // Largest count the counter holds
+
+private:
+    uint8_t state; // Debounced state (bit set = active)
+    uint8_t cnt0; // Counter bit 0 per input
+    uint8_t cnt1; // Counter bit 1 per input
+    uint8_t cnt2; // Counter bit 2 per input
+    uint8_t samples; // Consecutive differing samples that commit a change (1-MAX_DEBOUNCE_SAMPLES)
+
+public:
+    explicit VerticalDebouncer(uint8_t debounce_samples = DEBOUNCE_SAMPLES)
+        : state(0)
+        , cnt0(0)
+        , cnt1(0)
+        , cnt2(0)
+        , samples(DEBOUNCE_SAMPLES)
+    {
+        setSamples(debounce_samples);
+    }
+
+    // Set the samples needed to commit a change (0 = DEBOUNCE_SAMPLES, capped at MAX_DEBOUNCE_SAMPLES)
+    void setSamples(uint8_t debounce_samples)
+    {
+        samples = (debounce_samples == 0) ? DEBOUNCE_SAMPLES
+            : (debounce_samples < MAX_DEBOUNCE_SAMPLES) ? debounce_samples
+                                                         : MAX_DEBOUNCE_SAMPLES;
+    }
+
+    void reset()
+    {
+        state = 0;
+        cnt0 = 0;
+        cnt1 = 0;
+        cnt2 = 0;
+    }
+
+    // Feed one sample (bit set = active)
+    // Returns the mask of bits whose debounced state changed
+    uint8_t update(uint8_t sample)
+    {
+        uint8_t delta = sample ^ state;
+
+        // Count up where the sample differs from the state, clear where it agrees
+        cnt2 = (uint8_t)((cnt2 ^ (cnt1 & cnt0)) & delta);
+        cnt1 = (uint8_t)((cnt1 ^ cnt0) & delta);
+        cnt0 = (uint8_t)(~cnt0 & delta);
+
+        // Counter reached `samples`: commit the new state
+        uint8_t toggle = (uint8_t)(((samples & 4) ? cnt2 : ~cnt2)
+            & ((samples & 2) ? cnt1 : ~cnt1)
+            & ((samples & 1) ? cnt0 : ~cnt0));
+        state ^= toggle;
+        cnt0 &= (uint8_t)~toggle;
+        cnt1 &= (uint8_t)~toggle;
+        cnt2 &= (uint8_t)~toggle;
+
+        return toggle;
+    }
+
+    // Debounced state (bit set = active)
+    uint8_t getState() const { return state; }
+
+    // Samples needed to commit a change
+    uint8_t getSamples() const { return samples; }
+
+    // True while any input is partway through a debounce count
+    bool isSettling() const { return (cnt0 | cnt1 | cnt2) != 0; }
+};
+
+// Find and clear the next pending bit across a byte array, round-robin from cursor
+// Returns false if nothing is pending; otherwise index = byte * 8 + bit
+inline bool takePendingBit(uint8_t* pending, uint8_t count, uint8_t& cursor, uint8_t& index)
+{
+    for (uint8_t n = 0; n < count; n++) {
+        uint8_t i = (uint8_t)((cursor + n) % count);
+        if (pending[i] == 0) {
+            continue;
+        }
+
+        uint8_t bit = 0;
+        while (!(pending[i] & (1 << bit))) {
+            bit++;
+        }
+        pending[i] &= (uint8_t)~(1 << bit);
+        cursor = i;
+        index = (uint8_t)(i * 8 + bit);
+        return true;
+    }
+
+    return false;
+}
+
+} // namespace Sensor
@@ -29,3 +29,13 @@ int digitalRead(uint8_t pin);
 void digitalWrite(uint8_t pin, uint8_t val);
 void delayMicroseconds(unsigned int us);
 unsigned long millis();
+unsigned long micros();
+
+// Interrupts
+#define CHANGE 1
+#define NOT_AN_INTERRUPT -1
+int digitalPinToInterrupt(uint8_t pin);
+void attachInterrupt(uint8_t interrupt, void (*isr)(void), int mode);
+void detachInterrupt(uint8_t interrupt);
+void noInterrupts();
+void interrupts();
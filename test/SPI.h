@@ -0,0 +1,29 @@
+// Mock SPI.h for native testing
+#pragma once
+
+#include <stdint.h>
+
+#define MSBFIRST 1
+#define LSBFIRST 0
+#define SPI_MODE0 0x00
+
+class SPISettings {
+public:
+    SPISettings(uint32_t clock, uint8_t bitOrder, uint8_t dataMode)
+    {
+        (void)clock;
+        (void)bitOrder;
+        (void)dataMode;
+    }
+};
+
+// Mock SPI bus (member implementations in test files)
+class SPIClass {
+public:
+    void begin();
+    void beginTransaction(SPISettings settings);
+    uint8_t transfer(uint8_t data);
+    void endTransaction();
+};
+
+extern SPIClass SPI;
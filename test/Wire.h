@@ -0,0 +1,78 @@
+// Mock Wire.h for native testing
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Mock I2C bus: every write transaction is logged, reads are served from a
+// per-address 16-bit port value (low byte first, like MCP23017 GPIOA/GPIOB
+// in byte mode and PCF8575 P0x/P1x)
+constexpr size_t MOCK_WIRE_LOG_SIZE = 32;
+constexpr size_t MOCK_WIRE_MAX_WRITE = 8;
+
+struct MockWireWrite {
+    uint8_t address;
+    uint8_t length;
+    uint8_t data[MOCK_WIRE_MAX_WRITE];
+};
+
+extern MockWireWrite mock_wire_log[MOCK_WIRE_LOG_SIZE];
+extern size_t mock_wire_log_count;
+extern uint16_t mock_wire_port[128]; // Value returned by reads, per 7-bit address
+extern bool mock_wire_present[128]; // Devices that ACK their address
+extern size_t mock_wire_read_count; // Number of read transactions
+
+class TwoWire {
+private:
+    MockWireWrite pending;
+    uint8_t rx_buffer[32];
+    uint8_t rx_length;
+    uint8_t rx_position;
+
+public:
+    void begin() { }
+
+    void setClock(uint32_t clock) { (void)clock; }
+
+    void beginTransmission(uint8_t address)
+    {
+        pending.address = address;
+        pending.length = 0;
+    }
+
+    size_t write(uint8_t data)
+    {
+        if (pending.length < MOCK_WIRE_MAX_WRITE) {
+            pending.data[pending.length++] = data;
+        }
+        return 1;
+    }
+
+    uint8_t endTransmission()
+    {
+        if (mock_wire_log_count < MOCK_WIRE_LOG_SIZE) {
+            mock_wire_log[mock_wire_log_count++] = pending;
+        }
+        return mock_wire_present[pending.address & 0x7F] ? 0 : 2; // 2 = address NACK
+    }
+
+    uint8_t requestFrom(uint8_t address, uint8_t quantity)
+    {
+        mock_wire_read_count++;
+        rx_length = 0;
+        rx_position = 0;
+        if (!mock_wire_present[address & 0x7F]) {
+            return 0;
+        }
+        for (uint8_t i = 0; i < quantity && i < sizeof(rx_buffer); i++) {
+            rx_buffer[rx_length++] = (uint8_t)(mock_wire_port[address & 0x7F] >> (8 * (i % 2)));
+        }
+        return rx_length;
+    }
+
+    int available() { return rx_length - rx_position; }
+
+    int read() { return rx_position < rx_length ? rx_buffer[rx_position++] : -1; }
+};
+
+extern TwoWire Wire;
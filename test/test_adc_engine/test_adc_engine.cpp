@@ -0,0 +1,184 @@
+// Mock Arduino environment for native testing
+#include <stdint.h>
+
+#define A0 14
+#define A1 15
+
+// Mock Arduino functions
+static uint16_t g_mock_analog_values[32];
+static uint16_t g_analog_read_count = 0;
+
+int analogRead(uint8_t pin)
+{
+    g_analog_read_count++;
+    return g_mock_analog_values[pin];
+}
+
+// Include the engine code (native builds use the blocking fallback)
+#include "../../src/adc_engine.cpp"
+#include <unity.h>
+
+void setUp(void)
+{
+    AdcEngine::reset();
+    for (uint8_t i = 0; i < 32; i++) {
+        g_mock_analog_values[i] = 0;
+    }
+    g_analog_read_count = 0;
+}
+void tearDown(void) {}
+
+// Test that native builds report no background conversions
+void test_adc_engine_native_is_not_background()
+{
+    TEST_ASSERT_FALSE(AdcEngine::isBackground());
+}
+
+// Test that channels get consecutive slots
+void test_adc_engine_assigns_slots()
+{
+    TEST_ASSERT_EQUAL_UINT8(0, AdcEngine::addChannel(A0));
+    TEST_ASSERT_EQUAL_UINT8(1, AdcEngine::addChannel(A1));
+}
+
+// Test that registering the same pin twice shares a slot
+void test_adc_engine_same_pin_shares_slot()
+{
+    uint8_t first = AdcEngine::addChannel(A0);
+    AdcEngine::addChannel(A1);
+
+    TEST_ASSERT_EQUAL_UINT8(first, AdcEngine::addChannel(A0));
+}
+
+// Test that registration fails once all slots are taken
+void test_adc_engine_full_returns_no_slot()
+{
+    for (uint8_t i = 0; i < AdcEngine::MAX_CHANNELS; i++) {
+        TEST_ASSERT_TRUE(AdcEngine::addChannel(i) != AdcEngine::NO_SLOT);
+    }
+
+    TEST_ASSERT_EQUAL_UINT8(AdcEngine::NO_SLOT, AdcEngine::addChannel(AdcEngine::MAX_CHANNELS));
+}
+
+// Test that reset forgets all channels
+void test_adc_engine_reset_clears_channels()
+{
+    AdcEngine::addChannel(A0);
+    AdcEngine::addChannel(A1);
+    AdcEngine::reset();
+
+    TEST_ASSERT_EQUAL_UINT8(0, AdcEngine::addChannel(A1));
+}
+
+// Test that read() returns the sample for the slot's pin
+void test_adc_engine_read_returns_slot_pin()
+{
+    uint8_t slot0 = AdcEngine::addChannel(A0);
+    uint8_t slot1 = AdcEngine::addChannel(A1);
+    AdcEngine::start();
+
+    g_mock_analog_values[A0] = 100;
+    g_mock_analog_values[A1] = 900;
+
+    TEST_ASSERT_EQUAL_UINT16(100, AdcEngine::read(slot0));
+    TEST_ASSERT_EQUAL_UINT16(900, AdcEngine::read(slot1));
+}
+
+// Test that readNow() converts any pin, registered or not
+void test_adc_engine_read_now()
+{
+    AdcEngine::addChannel(A0);
+    AdcEngine::start();
+    g_analog_read_count = 0;
+
+    g_mock_analog_values[A1] = 321;
+
+    TEST_ASSERT_EQUAL_UINT16(321, AdcEngine::readNow(A1));
+    TEST_ASSERT_EQUAL_UINT16(1, g_analog_read_count);
+}
+
+// Test that the same pin with a different oversampling factor gets its own slot
+void test_adc_engine_oversample_separate_slot()
+{
+    uint8_t plain = AdcEngine::addChannel(A0);
+    uint8_t oversampled = AdcEngine::addChannel(A0, 2);
+
+    TEST_ASSERT_TRUE(plain != oversampled);
+}
+
+// Test that start() primes an oversampled slot at its full resolution
+void test_adc_engine_oversample_primed()
+{
+    uint8_t slot = AdcEngine::addChannel(A0, 2);
+    g_mock_analog_values[A0] = 500;
+    AdcEngine::start();
+
+    // Not enough accumulated yet - still the primed value (500 at 12 bits)
+    g_mock_analog_values[A0] = 0;
+    TEST_ASSERT_EQUAL_UINT16(2000, AdcEngine::read(slot));
+}
+
+// Test that 4^n samples decimate to 10 + n bits
+void test_adc_engine_oversample_decimation()
+{
+    uint8_t slot = AdcEngine::addChannel(A0, 2); // 16x -> 12 bits
+    AdcEngine::start();
+
+    // 16 samples alternating 511/512: sum 8184, >> 2 = 2046 (511.5 at 10 bits)
+    uint16_t value = 0;
+    for (uint8_t i = 0; i < 16; i++) {
+        g_mock_analog_values[A0] = (i & 1) ? 512 : 511;
+        value = AdcEngine::read(slot);
+    }
+
+    TEST_ASSERT_EQUAL_UINT16(2046, value);
+}
+
+// Test that a 64x result spans the full 13-bit range without overflow
+void test_adc_engine_oversample_full_scale()
+{
+    uint8_t slot = AdcEngine::addChannel(A0, 3); // 64x -> 13 bits
+    AdcEngine::start();
+
+    g_mock_analog_values[A0] = 1023;
+    uint16_t value = 0;
+    for (uint8_t i = 0; i < 64; i++) {
+        value = AdcEngine::read(slot);
+    }
+
+    TEST_ASSERT_EQUAL_UINT16(8184, value);
+}
+
+// Test blocking reads take several samples, so 64x updates every 16 reads
+void test_adc_engine_oversample_samples_per_read()
+{
+    uint8_t slot = AdcEngine::addChannel(A0, 3); // 64x -> 13 bits
+    g_mock_analog_values[A0] = 0;
+    AdcEngine::start();
+
+    g_mock_analog_values[A0] = 1023;
+    for (uint8_t i = 0; i < 15; i++) {
+        TEST_ASSERT_EQUAL_UINT16(0, AdcEngine::read(slot));
+    }
+    TEST_ASSERT_EQUAL_UINT16(8184, AdcEngine::read(slot));
+}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_adc_engine_native_is_not_background);
+    RUN_TEST(test_adc_engine_assigns_slots);
+    RUN_TEST(test_adc_engine_same_pin_shares_slot);
+    RUN_TEST(test_adc_engine_full_returns_no_slot);
+    RUN_TEST(test_adc_engine_reset_clears_channels);
+    RUN_TEST(test_adc_engine_read_returns_slot_pin);
+    RUN_TEST(test_adc_engine_read_now);
+    RUN_TEST(test_adc_engine_oversample_separate_slot);
+    RUN_TEST(test_adc_engine_oversample_primed);
+    RUN_TEST(test_adc_engine_oversample_decimation);
+    RUN_TEST(test_adc_engine_oversample_full_scale);
+    RUN_TEST(test_adc_engine_oversample_samples_per_read);
+
+    return UNITY_END();
+}
@@ -0,0 +1,217 @@
+#include "../../src/analog_filter.h"
+#include <unity.h>
+
+using namespace Sensor;
+
+// Test that NONE passes samples through unchanged
+void test_filter_none_passthrough()
+{
+    AnalogFilter filter;
+
+    TEST_ASSERT_EQUAL_UINT16(100, filter.apply(100));
+    TEST_ASSERT_EQUAL_UINT16(900, filter.apply(900));
+}
+
+// Test that a zero coefficient disables filtering
+void test_filter_zero_alpha_is_none()
+{
+    AnalogFilter filter(AnalogFilter::EMA, 0);
+
+    filter.apply(100);
+    TEST_ASSERT_EQUAL_UINT16(900, filter.apply(900));
+}
+
+// Test that the first sample seeds the state (no ramp from zero)
+void test_filter_ema_first_sample_seeds()
+{
+    AnalogFilter filter(AnalogFilter::EMA, 64);
+
+    TEST_ASSERT_EQUAL_UINT16(512, filter.apply(512));
+    TEST_ASSERT_EQUAL_UINT16(512, filter.apply(512));
+}
+
+// Test a single EMA step with alpha = 1/4
+void test_filter_ema_step()
+{
+    AnalogFilter filter(AnalogFilter::EMA, 64); // alpha = 64/256 = 0.25
+
+    filter.apply(0);
+
+    // y = 0 + 0.25 * (400 - 0) = 100
+    TEST_ASSERT_EQUAL_UINT16(100, filter.apply(400));
+
+    // y = 100 + 0.25 * (400 - 100) = 175
+    TEST_ASSERT_EQUAL_UINT16(175, filter.apply(400));
+}
+
+// Test that the EMA settles on a constant input (no fixed-point bias)
+void test_filter_ema_converges()
+{
+    AnalogFilter filter(AnalogFilter::EMA, 16);
+
+    filter.apply(0);
+    uint16_t value = 0;
+    for (int i = 0; i < 400; i++) {
+        value = filter.apply(1023);
+    }
+
+    TEST_ASSERT_UINT16_WITHIN(1, 1023, value);
+}
+
+// Test that the EMA attenuates alternating noise
+void test_filter_ema_suppresses_jitter()
+{
+    AnalogFilter filter(AnalogFilter::EMA, 32);
+
+    filter.apply(500);
+    uint16_t min_value = 0xFFFF;
+    uint16_t max_value = 0;
+    for (int i = 0; i < 100; i++) {
+        uint16_t value = filter.apply((i & 1) ? 508 : 492); // +/-8 counts of noise
+        if (i >= 50) {
+            min_value = (value < min_value) ? value : min_value;
+            max_value = (value > max_value) ? value : max_value;
+        }
+    }
+
+    // Output swing is well inside the DEAD_ZONE of 2
+    TEST_ASSERT_TRUE(max_value - min_value <= 2);
+}
+
+// Test that the second-order filter lags a step more but settles to the same value
+void test_filter_ema2_step_response()
+{
+    AnalogFilter first(AnalogFilter::EMA, 64);
+    AnalogFilter second(AnalogFilter::EMA2, 64);
+
+    first.apply(0);
+    second.apply(0);
+
+    uint16_t first_value = first.apply(1000);
+    uint16_t second_value = second.apply(1000);
+    TEST_ASSERT_TRUE(second_value < first_value);
+
+    for (int i = 0; i < 200; i++) {
+        first_value = first.apply(1000);
+        second_value = second.apply(1000);
+    }
+    TEST_ASSERT_UINT16_WITHIN(1, 1000, first_value);
+    TEST_ASSERT_UINT16_WITHIN(1, 1000, second_value);
+}
+
+// Test that a 13-bit full-scale input doesn't overflow the Q8 state
+void test_filter_full_scale_13_bit()
+{
+    AnalogFilter filter(AnalogFilter::EMA2, 255);
+
+    filter.apply(0);
+    uint16_t value = 0;
+    for (int i = 0; i < 20; i++) {
+        value = filter.apply(8191);
+    }
+
+    TEST_ASSERT_UINT16_WITHIN(1, 8191, value);
+}
+
+// Test that One-Euro with zero beta behaves like a plain EMA
+void test_filter_one_euro_zero_beta_is_ema()
+{
+    AnalogFilter ema(AnalogFilter::EMA, 32);
+    AnalogFilter one_euro(AnalogFilter::ONE_EURO, 32, 0);
+
+    ema.apply(100);
+    one_euro.apply(100);
+    for (int i = 0; i < 50; i++) {
+        uint16_t sample = (uint16_t)(100 + (i * 37) % 400);
+        TEST_ASSERT_EQUAL_UINT16(ema.apply(sample), one_euro.apply(sample));
+    }
+}
+
+// Test that One-Euro follows a fast step much closer than the EMA with the same resting alpha
+void test_filter_one_euro_follows_fast_step()
+{
+    AnalogFilter ema(AnalogFilter::EMA, 16);
+    AnalogFilter one_euro(AnalogFilter::ONE_EURO, 16, 64);
+
+    ema.apply(100);
+    one_euro.apply(100);
+
+    uint16_t ema_value = 0;
+    uint16_t one_euro_value = 0;
+    for (int i = 0; i < 5; i++) {
+        ema_value = ema.apply(900);
+        one_euro_value = one_euro.apply(900);
+    }
+
+    TEST_ASSERT_TRUE(ema_value < 400);
+    TEST_ASSERT_TRUE(one_euro_value > 850);
+}
+
+// Test that One-Euro stays quiet on noise at rest
+void test_filter_one_euro_quiet_at_rest()
+{
+    AnalogFilter filter(AnalogFilter::ONE_EURO, 16, 64);
+
+    filter.apply(500);
+    uint16_t min_value = 0xFFFF;
+    uint16_t max_value = 0;
+    for (int i = 0; i < 200; i++) {
+        uint16_t value = filter.apply((i & 1) ? 504 : 496); // +/-4 counts of noise
+        if (i >= 100) {
+            min_value = (value < min_value) ? value : min_value;
+            max_value = (value > max_value) ? value : max_value;
+        }
+    }
+
+    TEST_ASSERT_TRUE(max_value - min_value <= 2);
+}
+
+// Test that a large beta saturates at alpha = 1 (output tracks input exactly)
+void test_filter_one_euro_saturates()
+{
+    AnalogFilter filter(AnalogFilter::ONE_EURO, 255, 255);
+
+    filter.apply(0);
+    uint16_t value = 0;
+    for (int i = 0; i < 3; i++) {
+        value = filter.apply(8191);
+    }
+
+    TEST_ASSERT_EQUAL_UINT16(8191, value);
+}
+
+// Test that reset re-seeds from the next sample
+void test_filter_reset()
+{
+    AnalogFilter filter(AnalogFilter::EMA, 16);
+
+    filter.apply(0);
+    filter.apply(1000);
+    filter.reset();
+
+    TEST_ASSERT_EQUAL_UINT16(700, filter.apply(700));
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_filter_none_passthrough);
+    RUN_TEST(test_filter_zero_alpha_is_none);
+    RUN_TEST(test_filter_ema_first_sample_seeds);
+    RUN_TEST(test_filter_ema_step);
+    RUN_TEST(test_filter_ema_converges);
+    RUN_TEST(test_filter_ema_suppresses_jitter);
+    RUN_TEST(test_filter_ema2_step_response);
+    RUN_TEST(test_filter_full_scale_13_bit);
+    RUN_TEST(test_filter_one_euro_zero_beta_is_ema);
+    RUN_TEST(test_filter_one_euro_follows_fast_step);
+    RUN_TEST(test_filter_one_euro_quiet_at_rest);
+    RUN_TEST(test_filter_one_euro_saturates);
+    RUN_TEST(test_filter_reset);
+
+    return UNITY_END();
+}
@@ -8,6 +8,8 @@
 
 // Mock Arduino functions
 static uint16_t g_mock_analog_value = 512;
+static unsigned long g_micros = 0;
+static unsigned long g_scan_period_us = 10000;
 
 void pinMode(uint8_t pin, uint8_t mode)
 {
@@ -20,8 +22,16 @@ int analogRead(uint8_t pin)
     return g_mock_analog_value;
 }
 
+// AnalogSensor reads the clock once per scan - each read is one loop later
+unsigned long micros()
+{
+    g_micros += g_scan_period_us;
+    return g_micros;
+}
+
 // Now include the sensor code (include .cpp directly since we provide mocks above)
 #include "../../src/sensor.h"
+#include "../../src/adc_engine.cpp"
 #include "../../src/analog_sensor.cpp"
 #include <unity.h>
 
@@ -296,7 +306,242 @@ void test_analog_sensor_boundary_values()
     TEST_ASSERT_TRUE(sensor.getReading().has_value);
 }
 
-void setUp(void) {}
+// Test that an oversampled input reports at its wider resolution
+void test_analog_sensor_oversample_resolution()
+{
+    AnalogOptions options;
+    options.oversample = 1; // 4x -> 11 bits
+    AnalogSensor sensor(A1, 10, options);
+    sensor.begin();
+
+    setMockAnalogValue(700);
+    for (int i = 0; i < 4; i++) {
+        sensor.scan();
+    }
+
+    Reading r = sensor.getReading();
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(1400, r.value);
+}
+
+// Test that an EMA-filtered input stays quiet on noise that beats the dead zone
+void test_analog_sensor_filter_suppresses_noise_sends()
+{
+    AnalogSensor raw_sensor(A0, 10);
+    AnalogOptions options;
+    options.filter = AnalogFilter::EMA;
+    options.filter_alpha = 32;
+    AnalogSensor filtered_sensor(A0, 10, options);
+    raw_sensor.begin();
+    filtered_sensor.begin();
+
+    int raw_sends = 0;
+    int filtered_sends = 0;
+    for (int i = 0; i < 100; i++) {
+        setMockAnalogValue((i & 1) ? 506 : 494); // +/-6 counts of noise around 500
+        raw_sensor.scan();
+        filtered_sensor.scan();
+        if (i < 20) {
+            // Let both settle
+            raw_sensor.getReading();
+            filtered_sensor.getReading();
+            continue;
+        }
+        raw_sends += raw_sensor.getReading().has_value ? 1 : 0;
+        filtered_sends += filtered_sensor.getReading().has_value ? 1 : 0;
+    }
+
+    TEST_ASSERT_EQUAL(80, raw_sends);
+    TEST_ASSERT_EQUAL(0, filtered_sends);
+}
+
+// Test that a median prefilter keeps single-sample spikes from triggering sends
+void test_analog_sensor_median_rejects_spikes()
+{
+    AnalogOptions options;
+    options.median = 3;
+    AnalogSensor sensor(A0, 10, options);
+    sensor.begin();
+
+    setMockAnalogValue(500);
+    for (int i = 0; i < 5; i++) {
+        sensor.scan();
+    }
+    sensor.getReading(); // Consume initial reading
+
+    for (int i = 0; i < 20; i++) {
+        setMockAnalogValue((i % 4 == 0) ? 1023 : 500); // Isolated spikes
+        sensor.scan();
+        TEST_ASSERT_FALSE(sensor.getReading().has_value);
+    }
+}
+
+// Test that noise calibration measures the processed value's spread
+void test_analog_sensor_noise_calibration_stats()
+{
+    AnalogSensor sensor(A0, 10);
+    sensor.begin();
+
+    sensor.startNoiseCalibration();
+    for (int i = 0; i < 30; i++) {
+        setMockAnalogValue(500 + (i % 5) - 2); // 498..502
+        sensor.scan();
+    }
+
+    const NoiseStats& noise = sensor.stopNoiseCalibration();
+    TEST_ASSERT_EQUAL_UINT16(30, noise.samples);
+    TEST_ASSERT_EQUAL_UINT16(498, noise.min_value);
+    TEST_ASSERT_EQUAL_UINT16(502, noise.max_value);
+    TEST_ASSERT_EQUAL_UINT8(4, noise.deadZone());
+
+    // Stopped - further scans aren't counted
+    sensor.scan();
+    TEST_ASSERT_EQUAL_UINT16(30, noise.samples);
+
+    // A perfectly quiet input still gets the smallest dead zone
+    NoiseStats quiet;
+    quiet.samples = 10;
+    quiet.min_value = 500;
+    quiet.max_value = 500;
+    TEST_ASSERT_EQUAL_UINT8(1, quiet.deadZone());
+    TEST_ASSERT_EQUAL_UINT8(0, NoiseStats().deadZone());
+}
+
+// Test that a calibrated dead zone silences the measured noise but not real movement
+void test_analog_sensor_calibrated_dead_zone()
+{
+    AnalogSensor sensor(A0, 10);
+    sensor.begin();
+
+    // Measure +/-3 counts of noise (beats the default dead zone of 2)
+    sensor.startNoiseCalibration();
+    for (int i = 0; i < 20; i++) {
+        setMockAnalogValue((i & 1) ? 503 : 497);
+        sensor.scan();
+    }
+    uint8_t dead_zone = sensor.stopNoiseCalibration().deadZone();
+    TEST_ASSERT_EQUAL_UINT8(6, dead_zone);
+    sensor.setDeadZone(dead_zone);
+    sensor.getReading(); // Consume initial reading
+
+    for (int i = 0; i < 100; i++) {
+        setMockAnalogValue((i & 1) ? 503 : 497);
+        sensor.scan();
+        TEST_ASSERT_FALSE(sensor.getReading().has_value);
+    }
+
+    // Movement past the band still gets through
+    setMockAnalogValue(520);
+    sensor.scan();
+    TEST_ASSERT_TRUE(sensor.getReading().has_value);
+}
+
+// Test that hysteresis stops a value resting on a boundary from flip-flopping
+void test_analog_sensor_hysteresis_boundary()
+{
+    AnalogSensor plain_sensor(A0, 10);
+    AnalogOptions options;
+    options.hysteresis = 2;
+    AnalogSensor sensor(A0, 10, options);
+    plain_sensor.begin();
+    sensor.begin();
+
+    int plain_sends = 0;
+    int sends = 0;
+    for (int i = 0; i < 100; i++) {
+        setMockAnalogValue((i & 1) ? 503 : 500); // Noise of 3 counts beats the dead zone
+        plain_sensor.scan();
+        sensor.scan();
+        plain_sends += plain_sensor.getReading().has_value ? 1 : 0;
+        sends += sensor.getReading().has_value ? 1 : 0;
+    }
+
+    TEST_ASSERT_GREATER_THAN(90, plain_sends);
+    TEST_ASSERT_LESS_OR_EQUAL(plain_sends / 10, sends);
+}
+
+// Test that hysteresis only delays reversals, not movement in the same direction
+void test_analog_sensor_hysteresis_direction()
+{
+    AnalogOptions options;
+    options.hysteresis = 4;
+    AnalogSensor sensor(A0, 10, options);
+    sensor.begin();
+
+    setMockAnalogValue(500);
+    sensor.scan();
+    sensor.getReading(); // Consume initial reading
+
+    // Moving up: the plain dead zone applies
+    setMockAnalogValue(503);
+    sensor.scan();
+    TEST_ASSERT_EQUAL(503, sensor.getReading().value);
+    setMockAnalogValue(506);
+    sensor.scan();
+    TEST_ASSERT_EQUAL(506, sensor.getReading().value);
+
+    // Turning back needs dead zone + band (2 + 4)
+    setMockAnalogValue(500);
+    sensor.scan();
+    TEST_ASSERT_FALSE(sensor.getReading().has_value);
+    setMockAnalogValue(499);
+    sensor.scan();
+    TEST_ASSERT_EQUAL(499, sensor.getReading().value);
+
+    // Now moving down: small steps pass again
+    setMockAnalogValue(496);
+    sensor.scan();
+    TEST_ASSERT_EQUAL(496, sensor.getReading().value);
+}
+
+// Test that send intervals follow the clock, not the number of scans
+void test_analog_sensor_interval_is_time_based()
+{
+    AnalogSensor sensor(A0, 5); // sensitivity 5 -> 60ms minimum interval
+    g_scan_period_us = 1000; // Loop runs 10x faster than usual
+    sensor.begin();
+
+    // 59 scans = 59ms since begin(): still rate limited
+    setMockAnalogValue(600);
+    for (int i = 0; i < 59; i++) {
+        sensor.scan();
+        TEST_ASSERT_FALSE(sensor.getReading().has_value);
+    }
+
+    // 60ms
+    sensor.scan();
+    TEST_ASSERT_TRUE(sensor.getReading().has_value);
+}
+
+// Test configured minimum and keepalive intervals
+void test_analog_sensor_configured_intervals()
+{
+    AnalogOptions options;
+    options.min_interval_ms = 25;
+    options.keepalive_ms = 500;
+    AnalogSensor sensor(A0, 0, options); // Sensitivity alone would mean 110ms
+    sensor.begin();
+
+    setMockAnalogValue(600);
+    sensor.scan();
+    sensor.scan();
+    TEST_ASSERT_FALSE(sensor.getReading().has_value); // 20ms
+    sensor.scan();
+    TEST_ASSERT_TRUE(sensor.getReading().has_value); // 30ms
+
+    // No change: keepalive after 500ms instead of 2s
+    for (int i = 0; i < 49; i++) {
+        sensor.scan();
+        TEST_ASSERT_FALSE(sensor.getReading().has_value);
+    }
+    sensor.scan();
+    TEST_ASSERT_TRUE(sensor.getReading().has_value);
+}
+
+void setUp(void)
+{
+    g_scan_period_us = 10000;
+}
 void tearDown(void) {}
 
 int main(int argc, char** argv)
@@ -314,6 +559,15 @@ int main(int argc, char** argv)
     RUN_TEST(test_analog_sensor_reading_resets_counter);
     RUN_TEST(test_analog_sensor_consecutive_readings);
     RUN_TEST(test_analog_sensor_boundary_values);
+    RUN_TEST(test_analog_sensor_oversample_resolution);
+    RUN_TEST(test_analog_sensor_filter_suppresses_noise_sends);
+    RUN_TEST(test_analog_sensor_median_rejects_spikes);
+    RUN_TEST(test_analog_sensor_noise_calibration_stats);
+    RUN_TEST(test_analog_sensor_calibrated_dead_zone);
+    RUN_TEST(test_analog_sensor_hysteresis_boundary);
+    RUN_TEST(test_analog_sensor_hysteresis_direction);
+    RUN_TEST(test_analog_sensor_interval_is_time_based);
+    RUN_TEST(test_analog_sensor_configured_intervals);
 
     return UNITY_END();
 }
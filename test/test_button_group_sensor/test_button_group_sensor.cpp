@@ -0,0 +1,236 @@
+// Mock Arduino environment for native testing
+#include <stdint.h>
+#include <string.h>
+
+// Arduino pin definitions
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define LOW 0
+#define HIGH 1
+
+// Mock GPIO ports: 8 pins per port, pin p is bit (p % 8) of port (p / 8)
+static uint32_t g_port_in[4];
+static int g_digital_reads = 0;
+static int g_pullups = 0;
+
+#define digitalPinToPort(pin) ((pin) / 8)
+#define digitalPinToBitMask(pin) (1UL << ((pin) % 8))
+#define portInputRegister(port) (&g_port_in[(port)])
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    (void)pin;
+    if (mode == INPUT_PULLUP) {
+        g_pullups++;
+    }
+}
+
+int digitalRead(uint8_t pin)
+{
+    g_digital_reads++;
+    return (g_port_in[pin / 8] >> (pin % 8)) & 1;
+}
+
+// Now include the sensor code
+#include "../../src/sensor.h"
+#include "../../src/button_group_sensor.cpp"
+#include <unity.h>
+
+using namespace Sensor;
+
+static const uint8_t PINS[] = { 2, 3, 9, 14, 20 };
+
+// Helper to press a button (pin pulled LOW)
+void pressPin(uint8_t pin)
+{
+    g_port_in[pin / 8] &= ~(1UL << (pin % 8));
+}
+
+// Helper to release a button (pullup HIGH)
+void releasePin(uint8_t pin)
+{
+    g_port_in[pin / 8] |= (1UL << (pin % 8));
+}
+
+// Helper to scan n times
+void scanTimes(ButtonGroupSensor& sensor, int n)
+{
+    for (int i = 0; i < n; i++) {
+        sensor.scan();
+    }
+}
+
+// Test begin() enables pullups and groups the pins by port
+void test_button_group_begin_groups_ports()
+{
+    ButtonGroupSensor sensor(5, PINS);
+    sensor.begin();
+
+    TEST_ASSERT_EQUAL(InputType::ButtonGroup, sensor.getType());
+    TEST_ASSERT_EQUAL(2, sensor.getPin());
+    TEST_ASSERT_EQUAL(5, g_pullups);
+    TEST_ASSERT_EQUAL_UINT8(3, sensor.getPortCount()); // Ports 0, 1 and 2
+}
+
+// Test scans read port registers, not individual pins
+void test_button_group_reads_ports_not_pins()
+{
+    ButtonGroupSensor sensor(5, PINS);
+    sensor.begin();
+
+    scanTimes(sensor, 10);
+    TEST_ASSERT_EQUAL(0, g_digital_reads);
+}
+
+// Test no events while nothing is pressed
+void test_button_group_no_events_idle()
+{
+    ButtonGroupSensor sensor(5, PINS);
+    sensor.begin();
+
+    scanTimes(sensor, 10);
+    TEST_ASSERT_FALSE(sensor.getReading().has_value);
+}
+
+// Test a press is debounced and reported on the button's own pin
+void test_button_group_press_reported_on_pin()
+{
+    ButtonGroupSensor sensor(5, PINS);
+    sensor.begin();
+
+    pressPin(9);
+    scanTimes(sensor, 2);
+    TEST_ASSERT_FALSE(sensor.getReading().has_value);
+
+    sensor.scan();
+    Reading r = sensor.getReading();
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(1, r.value);
+    TEST_ASSERT_EQUAL(InputType::Button, r.type);
+    TEST_ASSERT_EQUAL(9, r.pin);
+    TEST_ASSERT_FALSE(sensor.getReading().has_value);
+
+    releasePin(9);
+    scanTimes(sensor, 3);
+    r = sensor.getReading();
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(0, r.value);
+    TEST_ASSERT_EQUAL(9, r.pin);
+}
+
+// Test a glitch shorter than the debounce window is filtered
+void test_button_group_filters_glitch()
+{
+    ButtonGroupSensor sensor(5, PINS);
+    sensor.begin();
+
+    pressPin(3);
+    scanTimes(sensor, 2);
+    releasePin(3);
+    scanTimes(sensor, 5);
+
+    TEST_ASSERT_FALSE(sensor.getReading().has_value);
+}
+
+// Test the debounce count is configurable up to the counter's width
+void test_vertical_debouncer_custom_samples()
+{
+    VerticalDebouncer one(1);
+    TEST_ASSERT_EQUAL_UINT8(0x80, one.update(0x80));
+
+    VerticalDebouncer seven(7);
+    for (int i = 0; i < 6; i++) {
+        TEST_ASSERT_EQUAL_UINT8(0x00, seven.update(0x03));
+    }
+    TEST_ASSERT_EQUAL_UINT8(0x03, seven.update(0x03));
+    TEST_ASSERT_FALSE(seven.isSettling());
+
+    VerticalDebouncer capped(20);
+    TEST_ASSERT_EQUAL_UINT8(VerticalDebouncer::MAX_DEBOUNCE_SAMPLES, capped.getSamples());
+    TEST_ASSERT_EQUAL_UINT8(VerticalDebouncer::DEBOUNCE_SAMPLES, VerticalDebouncer(0).getSamples());
+}
+
+// Test the debounce count comes from the configuration
+void test_button_group_custom_debounce()
+{
+    ButtonGroupSensor sensor(5, PINS, 5);
+    sensor.begin();
+
+    pressPin(14);
+    scanTimes(sensor, 4);
+    TEST_ASSERT_FALSE(sensor.getReading().has_value);
+
+    sensor.scan();
+    Reading r = sensor.getReading();
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(1, r.value);
+    TEST_ASSERT_EQUAL(14, r.pin);
+}
+
+// Test simultaneous presses on different ports are each reported
+void test_button_group_simultaneous_presses()
+{
+    ButtonGroupSensor sensor(5, PINS);
+    sensor.begin();
+
+    for (uint8_t i = 0; i < 5; i++) {
+        pressPin(PINS[i]);
+    }
+    scanTimes(sensor, 3);
+
+    bool seen[5] = { false, false, false, false, false };
+    for (int n = 0; n < 5; n++) {
+        Reading r = sensor.getReading();
+        TEST_ASSERT_TRUE(r.has_value);
+        TEST_ASSERT_EQUAL(1, r.value);
+        for (uint8_t i = 0; i < 5; i++) {
+            if (r.pin == PINS[i]) {
+                seen[i] = true;
+            }
+        }
+    }
+    for (uint8_t i = 0; i < 5; i++) {
+        TEST_ASSERT_TRUE(seen[i]);
+    }
+    TEST_ASSERT_FALSE(sensor.getReading().has_value);
+}
+
+// Test the pin count is capped at MAX_PINS
+void test_button_group_caps_pin_count()
+{
+    uint8_t pins[ButtonGroupSensor::MAX_PINS + 2];
+    for (uint8_t i = 0; i < sizeof(pins); i++) {
+        pins[i] = i;
+    }
+    ButtonGroupSensor sensor(sizeof(pins), pins);
+    sensor.begin();
+
+    TEST_ASSERT_EQUAL(ButtonGroupSensor::MAX_PINS, g_pullups);
+}
+
+void setUp(void)
+{
+    // All buttons released (pullups HIGH)
+    memset(g_port_in, 0xFF, sizeof(g_port_in));
+    g_digital_reads = 0;
+    g_pullups = 0;
+}
+void tearDown(void) {}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_button_group_begin_groups_ports);
+    RUN_TEST(test_button_group_reads_ports_not_pins);
+    RUN_TEST(test_button_group_no_events_idle);
+    RUN_TEST(test_button_group_press_reported_on_pin);
+    RUN_TEST(test_button_group_filters_glitch);
+    RUN_TEST(test_vertical_debouncer_custom_samples);
+    RUN_TEST(test_button_group_custom_debounce);
+    RUN_TEST(test_button_group_simultaneous_presses);
+    RUN_TEST(test_button_group_caps_pin_count);
+
+    return UNITY_END();
+}
@@ -8,9 +8,16 @@
 #define LOW 0
 #define HIGH 1
 
+#define CHANGE 1
+#define NOT_AN_INTERRUPT -1
+
 // Mock Arduino functions
 static int g_mock_digital_value = HIGH; // Default to HIGH (not pressed, due to INPUT_PULLUP)
 static uint8_t g_last_pin_mode = 0;
+static unsigned long g_micros = 0;
+static bool g_pin_has_interrupt = true;
+static void (*g_isr)(void) = nullptr;
+static int g_interrupts_disabled = 0;
 
 void pinMode(uint8_t pin, uint8_t mode)
 {
@@ -30,6 +37,33 @@ void digitalWrite(uint8_t pin, uint8_t val)
     (void)val;
 }
 
+unsigned long micros()
+{
+    return g_micros;
+}
+
+int digitalPinToInterrupt(uint8_t pin)
+{
+    (void)pin;
+    return g_pin_has_interrupt ? 0 : NOT_AN_INTERRUPT;
+}
+
+void attachInterrupt(uint8_t interrupt, void (*isr)(void), int mode)
+{
+    (void)interrupt;
+    (void)mode;
+    g_isr = isr;
+}
+
+void detachInterrupt(uint8_t interrupt)
+{
+    (void)interrupt;
+    g_isr = nullptr;
+}
+
+void noInterrupts() { g_interrupts_disabled++; }
+void interrupts() { g_interrupts_disabled--; }
+
 // Now include the sensor code (include .cpp directly since we provide mocks above)
 #include "../../src/sensor.h"
 #include "../../src/button_sensor.cpp"
@@ -292,7 +326,196 @@ void test_button_sensor_reading_clears_event()
     TEST_ASSERT_FALSE(r2.has_value);
 }
 
-void setUp(void) { g_mock_digital_value = HIGH; }
+// Test eager debounce reports the press on the first scan
+void test_button_sensor_eager_press_on_first_edge()
+{
+    ButtonSensor sensor(7, 3, true);
+    sensor.begin();
+
+    setMockDigitalValue(HIGH);
+    sensor.scan();
+    TEST_ASSERT_FALSE(sensor.getReading().has_value);
+
+    setMockDigitalValue(LOW);
+    sensor.scan();
+
+    Reading r = sensor.getReading();
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(1, r.value);
+    TEST_ASSERT_EQUAL(7, r.pin);
+}
+
+// Test eager debounce ignores contact bounce during the lockout window
+void test_button_sensor_eager_lockout_rejects_bounce()
+{
+    ButtonSensor sensor(7, 3, true);
+    sensor.begin();
+
+    // Press, then bounce for the 3-scan lockout
+    setMockDigitalValue(LOW);
+    sensor.scan();
+    TEST_ASSERT_EQUAL(1, sensor.getReading().value);
+
+    const int bounce[] = {HIGH, LOW, HIGH};
+    for (int i = 0; i < 3; i++) {
+        setMockDigitalValue(bounce[i]);
+        sensor.scan();
+        TEST_ASSERT_FALSE(sensor.getReading().has_value);
+    }
+
+    // Contacts settled closed: no spurious release
+    setMockDigitalValue(LOW);
+    for (int i = 0; i < 5; i++) {
+        sensor.scan();
+    }
+    TEST_ASSERT_FALSE(sensor.getReading().has_value);
+
+    // Release is reported on its first edge too
+    setMockDigitalValue(HIGH);
+    sensor.scan();
+    Reading r = sensor.getReading();
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(0, r.value);
+}
+
+// Test a release that happens during the lockout is reported once it ends
+void test_button_sensor_eager_release_after_lockout()
+{
+    ButtonSensor sensor(7, 2, true);
+    sensor.begin();
+
+    setMockDigitalValue(LOW);
+    sensor.scan();
+    TEST_ASSERT_EQUAL(1, sensor.getReading().value);
+
+    // Short tap: released while still locked out
+    setMockDigitalValue(HIGH);
+    sensor.scan();
+    sensor.scan();
+    TEST_ASSERT_FALSE(sensor.getReading().has_value);
+
+    sensor.scan();
+    Reading r = sensor.getReading();
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(0, r.value);
+}
+
+// Helper to change the pin level and fire the pin-change interrupt
+void setLevelWithInterrupt(int value)
+{
+    g_mock_digital_value = value;
+    if (g_isr) {
+        g_isr();
+    }
+}
+
+// Test interrupt capture reports a press without waiting for debounce scans
+void test_button_sensor_interrupt_press_latency()
+{
+    ButtonSensor sensor(7, 3, false, true);
+    sensor.begin();
+    TEST_ASSERT_TRUE(sensor.isInterruptDriven());
+    TEST_ASSERT_NOT_NULL(g_isr);
+
+    g_micros = 1000;
+    setLevelWithInterrupt(LOW);
+
+    // Reported on the first read, no scan needed
+    Reading r = sensor.getReading();
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(1, r.value);
+    TEST_ASSERT_EQUAL(7, r.pin);
+    TEST_ASSERT_FALSE(sensor.getReading().has_value);
+}
+
+// Test bounce within the time lockout is ignored and a late release is caught by scan
+void test_button_sensor_interrupt_lockout()
+{
+    ButtonSensor sensor(7, 3, false, true); // 30ms lockout
+    sensor.begin();
+
+    g_micros = 1000;
+    setLevelWithInterrupt(LOW);
+    TEST_ASSERT_EQUAL(1, sensor.getReading().value);
+
+    // Bounce 1-5ms after the press
+    g_micros = 2000;
+    setLevelWithInterrupt(HIGH);
+    g_micros = 3000;
+    setLevelWithInterrupt(LOW);
+    g_micros = 5000;
+    setLevelWithInterrupt(HIGH); // Real release, but inside the lockout
+    sensor.scan();
+    TEST_ASSERT_FALSE(sensor.getReading().has_value);
+
+    // Once the lockout has passed the scan picks up the missed release
+    g_micros = 31000;
+    sensor.scan();
+    Reading r = sensor.getReading();
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(0, r.value);
+    TEST_ASSERT_EQUAL(0, g_interrupts_disabled);
+}
+
+// Test a tap shorter than the scan period yields both press and release
+void test_button_sensor_interrupt_queues_short_tap()
+{
+    ButtonSensor sensor(7, 1, false, true); // 10ms lockout
+    sensor.begin();
+
+    g_micros = 100000;
+    setLevelWithInterrupt(LOW);
+    g_micros = 115000;
+    setLevelWithInterrupt(HIGH);
+
+    Reading press = sensor.getReading();
+    Reading release = sensor.getReading();
+    TEST_ASSERT_TRUE(press.has_value);
+    TEST_ASSERT_EQUAL(1, press.value);
+    TEST_ASSERT_TRUE(release.has_value);
+    TEST_ASSERT_EQUAL(0, release.value);
+}
+
+// Test a pin without an interrupt falls back to polled debounce
+void test_button_sensor_interrupt_fallback_polls()
+{
+    g_pin_has_interrupt = false;
+    ButtonSensor sensor(7, 3, false, true);
+    sensor.begin();
+    TEST_ASSERT_FALSE(sensor.isInterruptDriven());
+
+    setMockDigitalValue(LOW);
+    sensor.scan();
+    sensor.scan();
+    TEST_ASSERT_FALSE(sensor.getReading().has_value);
+    sensor.scan();
+    TEST_ASSERT_EQUAL(1, sensor.getReading().value);
+}
+
+// Test the interrupt is detached when the sensor is destroyed
+void test_button_sensor_interrupt_detached_on_destroy()
+{
+    {
+        ButtonSensor sensor(7, 3, false, true);
+        sensor.begin();
+        TEST_ASSERT_NOT_NULL(g_isr);
+    }
+    TEST_ASSERT_NULL(g_isr);
+
+    // The slot is free again
+    ButtonSensor other(7, 3, false, true);
+    other.begin();
+    TEST_ASSERT_TRUE(other.isInterruptDriven());
+}
+
+void setUp(void)
+{
+    g_mock_digital_value = HIGH;
+    g_micros = 0;
+    g_pin_has_interrupt = true;
+    g_isr = nullptr;
+    g_interrupts_disabled = 0;
+}
 void tearDown(void) {}
 
 int main(int argc, char** argv)
@@ -310,6 +533,14 @@ int main(int argc, char** argv)
     RUN_TEST(test_button_sensor_full_cycle);
     RUN_TEST(test_button_sensor_multiple_cycles);
     RUN_TEST(test_button_sensor_reading_clears_event);
+    RUN_TEST(test_button_sensor_eager_press_on_first_edge);
+    RUN_TEST(test_button_sensor_eager_lockout_rejects_bounce);
+    RUN_TEST(test_button_sensor_eager_release_after_lockout);
+    RUN_TEST(test_button_sensor_interrupt_press_latency);
+    RUN_TEST(test_button_sensor_interrupt_lockout);
+    RUN_TEST(test_button_sensor_interrupt_queues_short_tap);
+    RUN_TEST(test_button_sensor_interrupt_fallback_polls);
+    RUN_TEST(test_button_sensor_interrupt_detached_on_destroy);
 
     return UNITY_END();
 }
@@ -43,6 +43,39 @@ void tearDown()
     // Nothing to clean up
 }
 
+// Pack inputs into an image
+static ConfigManager::ConfigImage pack(const ConfigManager::InputConfig* inputs, uint8_t count)
+{
+    ConfigManager::ConfigImage image;
+    for (uint8_t i = 0; i < count; i++) {
+        TEST_ASSERT_TRUE(image.append(inputs[i]));
+    }
+    return image;
+}
+
+// Configure message for a button input
+static Protocol::Configure buttonPart(uint32_t config_id, uint8_t total, uint8_t part, uint8_t pin)
+{
+    Protocol::Configure cfg;
+    cfg.config_id = config_id;
+    cfg.total_parts = total;
+    cfg.part_number = part;
+    cfg.input_type = Protocol::INPUT_TYPE_BUTTON;
+    cfg.button.pin = pin;
+    cfg.button.debounce = 2;
+    cfg.button.flags = 0;
+    return cfg;
+}
+
+// Run a background store to the end
+static ConfigManager::StoreStatus finishStore()
+{
+    ConfigManager::StoreStatus status;
+    while ((status = ConfigManager::updateStore()) == ConfigManager::StoreStatus::Writing) {
+    }
+    return status;
+}
+
 // Test that storeToEEPROM writes the device version
 void test_store_writes_version()
 {
@@ -56,7 +89,7 @@ void test_store_writes_version()
 
     uint32_t config_id = 12345;
 
-    ConfigManager::storeToEEPROM(config_id, inputs, 2);
+    ConfigManager::storeToEEPROM(config_id, pack(inputs, 2));
 
     // Verify magic number
     uint32_t magic;
@@ -89,7 +122,7 @@ void test_load_succeeds_with_matching_version()
     inputs[0].analog.sensitivity = 5;
 
     uint32_t config_id = 54321;
-    ConfigManager::storeToEEPROM(config_id, inputs, 1);
+    ConfigManager::storeToEEPROM(config_id, pack(inputs, 1));
 
     // Load it back
     bool result = ConfigManager::loadFromEEPROM();
@@ -99,12 +132,13 @@ void test_load_succeeds_with_matching_version()
     TEST_ASSERT_EQUAL_UINT32(config_id, ConfigManager::getCurrentConfigId());
 
     // Verify loaded inputs
-    uint8_t num_inputs = 0;
-    const ConfigManager::InputConfig* loaded = ConfigManager::getCurrentConfig(num_inputs);
-    TEST_ASSERT_EQUAL_UINT8(1, num_inputs);
-    TEST_ASSERT_EQUAL_UINT8(Protocol::INPUT_TYPE_ANALOG, loaded[0].input_type);
-    TEST_ASSERT_EQUAL_UINT8(14, loaded[0].analog.pin);
-    TEST_ASSERT_EQUAL_UINT8(5, loaded[0].analog.sensitivity);
+    const ConfigManager::ConfigImage& loaded = ConfigManager::getCurrentConfig();
+    ConfigManager::InputConfig input;
+    TEST_ASSERT_EQUAL_UINT8(1, loaded.getNumInputs());
+    TEST_ASSERT_TRUE(loaded.get(0, input));
+    TEST_ASSERT_EQUAL_UINT8(Protocol::INPUT_TYPE_ANALOG, input.input_type);
+    TEST_ASSERT_EQUAL_UINT8(14, input.analog.pin);
+    TEST_ASSERT_EQUAL_UINT8(5, input.analog.sensitivity);
 }
 
 // Test that loadFromEEPROM fails and clears EEPROM with mismatched version
@@ -159,6 +193,321 @@ void test_load_fails_with_invalid_num_inputs()
     TEST_ASSERT_FALSE(result);
 }
 
+// Test that a calibrated dead zone survives a store/load and can be changed in place
+void test_analog_dead_zone_persists()
+{
+    ConfigManager::InputConfig inputs[2];
+    inputs[0].input_type = Protocol::INPUT_TYPE_ANALOG;
+    inputs[0].analog.pin = 14;
+    inputs[0].analog.sensitivity = 5;
+    inputs[1].input_type = Protocol::INPUT_TYPE_BUTTON;
+    inputs[1].button.pin = 2;
+    inputs[1].button.debounce = 3;
+
+    ConfigManager::storeToEEPROM(777, pack(inputs, 2));
+    TEST_ASSERT_TRUE(ConfigManager::loadFromEEPROM());
+
+    // Only analog inputs carry a dead zone
+    TEST_ASSERT_TRUE(ConfigManager::setAnalogDeadZone(0, 9));
+    TEST_ASSERT_FALSE(ConfigManager::setAnalogDeadZone(1, 9));
+    TEST_ASSERT_FALSE(ConfigManager::setAnalogDeadZone(2, 9));
+    ConfigManager::storeCurrentConfig();
+    TEST_ASSERT_EQUAL(ConfigManager::StoreStatus::Stored, finishStore());
+
+    TEST_ASSERT_TRUE(ConfigManager::loadFromEEPROM());
+    const ConfigManager::ConfigImage& loaded = ConfigManager::getCurrentConfig();
+    ConfigManager::InputConfig input;
+    TEST_ASSERT_EQUAL_UINT8(2, loaded.getNumInputs());
+    TEST_ASSERT_EQUAL_UINT32(777, ConfigManager::getCurrentConfigId());
+    TEST_ASSERT_TRUE(loaded.get(0, input));
+    TEST_ASSERT_EQUAL_UINT8(9, input.analog.dead_zone);
+    TEST_ASSERT_TRUE(loaded.get(1, input));
+    TEST_ASSERT_EQUAL_UINT8(3, input.button.debounce);
+}
+
+// Test inputs are packed by type, and replacing one moves the inputs after it
+void test_image_packs_and_replaces()
+{
+    ConfigManager::InputConfig inputs[3];
+    inputs[0].input_type = Protocol::INPUT_TYPE_BUTTON;
+    inputs[0].button.pin = 2;
+    inputs[0].button.debounce = 3;
+    inputs[1].input_type = Protocol::INPUT_TYPE_ANALOG_NOTCH;
+    inputs[1].notch.pin = 14;
+    inputs[1].notch.hysteresis = 4;
+    inputs[1].notch.num_thresholds = 2;
+    inputs[1].notch.thresholds[0] = 300;
+    inputs[1].notch.thresholds[1] = 700;
+    inputs[2].input_type = Protocol::INPUT_TYPE_ENCODER;
+    inputs[2].encoder.pin_a = 0;
+    inputs[2].encoder.pin_b = 1;
+    inputs[2].encoder.steps_per_detent = 4;
+    inputs[2].encoder.sensitivity = 5;
+
+    ConfigManager::ConfigImage image = pack(inputs, 3);
+    TEST_ASSERT_EQUAL_UINT8(3, image.getNumInputs());
+    TEST_ASSERT_EQUAL_UINT16(4 + 8 + 5, image.getSize()); // Type byte + fields each
+
+    // Grow the notch table in the middle
+    inputs[1].notch.num_thresholds = 3;
+    inputs[1].notch.thresholds[2] = 900;
+    TEST_ASSERT_TRUE(image.replace(1, inputs[1]));
+    TEST_ASSERT_EQUAL_UINT16(4 + 10 + 5, image.getSize());
+
+    ConfigManager::InputConfig input;
+    TEST_ASSERT_TRUE(image.get(1, input));
+    TEST_ASSERT_EQUAL_UINT8(3, input.notch.num_thresholds);
+    TEST_ASSERT_EQUAL_UINT16(900, input.notch.thresholds[2]);
+    TEST_ASSERT_TRUE(image.get(2, input));
+    TEST_ASSERT_EQUAL_UINT8(Protocol::INPUT_TYPE_ENCODER, input.input_type);
+    TEST_ASSERT_EQUAL_UINT8(4, input.encoder.steps_per_detent);
+    TEST_ASSERT_FALSE(image.get(3, input));
+
+    // Invalid inputs are refused and leave the image as it was
+    inputs[1].notch.num_thresholds = Protocol::MAX_NOTCH_THRESHOLDS + 1;
+    TEST_ASSERT_FALSE(image.replace(1, inputs[1]));
+    inputs[0].input_type = 0xEE;
+    TEST_ASSERT_FALSE(image.append(inputs[0]));
+    TEST_ASSERT_EQUAL_UINT16(4 + 10 + 5, image.getSize());
+}
+
+// Test a configuration of MAX_INPUTS buttons, received out of order, is stored in part order
+void test_configure_max_inputs_out_of_order()
+{
+    const uint8_t total = ConfigManager::MAX_INPUTS;
+    bool complete = false;
+    bool error = false;
+
+    ConfigManager::g_config_state.reset();
+    for (uint8_t n = 0; n < total; n++) {
+        uint8_t part = (uint8_t)(total - 1 - n);
+        ConfigManager::handleConfigure(buttonPart(4242, total, part, (uint8_t)(part + 2)), complete, error);
+        TEST_ASSERT_FALSE(error);
+
+        // A resent part replaces the copy already received
+        if (n == 3) {
+            ConfigManager::handleConfigure(buttonPart(4242, total, part, (uint8_t)(part + 2)), complete, error);
+        }
+    }
+    TEST_ASSERT_TRUE(complete);
+
+    const ConfigManager::ConfigImage& current = ConfigManager::getCurrentConfig();
+    TEST_ASSERT_EQUAL_UINT8(total, current.getNumInputs());
+    TEST_ASSERT_EQUAL_UINT16(4 * total, current.getSize());
+
+    ConfigManager::InputConfig input;
+    size_t offset = 0;
+    for (uint8_t i = 0; i < total; i++) {
+        offset = current.read(offset, input);
+        TEST_ASSERT_EQUAL_UINT8(i + 2, input.button.pin);
+    }
+
+    // And it comes back from EEPROM the same once stored
+    ConfigManager::storeCurrentConfig();
+    TEST_ASSERT_EQUAL(ConfigManager::StoreStatus::Stored, finishStore());
+    TEST_ASSERT_TRUE(ConfigManager::loadFromEEPROM());
+    TEST_ASSERT_EQUAL_UINT8(total, ConfigManager::getCurrentConfig().getNumInputs());
+    TEST_ASSERT_TRUE(ConfigManager::getCurrentConfig().get(total - 1, input));
+    TEST_ASSERT_EQUAL_UINT8(total + 1, input.button.pin);
+}
+
+// Test a configuration that doesn't fit the image is an error, not a partial config
+void test_configure_over_image_size_fails()
+{
+    bool complete = false;
+    bool error = false;
+
+    Protocol::Configure cfg;
+    cfg.config_id = 99;
+    cfg.total_parts = ConfigManager::MAX_INPUTS;
+    cfg.input_type = Protocol::INPUT_TYPE_ANALOG_NOTCH;
+    cfg.notch.pin = 14;
+    cfg.notch.hysteresis = 4;
+    cfg.notch.num_thresholds = Protocol::MAX_NOTCH_THRESHOLDS;
+    for (uint8_t t = 0; t < Protocol::MAX_NOTCH_THRESHOLDS; t++) {
+        cfg.notch.thresholds[t] = (uint16_t)(80 * (t + 1));
+    }
+
+    ConfigManager::g_config_state.reset();
+    for (uint8_t part = 0; part < cfg.total_parts && !error; part++) {
+        cfg.part_number = part;
+        ConfigManager::handleConfigure(cfg, complete, error);
+    }
+
+    TEST_ASSERT_TRUE(error);
+    TEST_ASSERT_FALSE(complete);
+    TEST_ASSERT_FALSE(ConfigManager::g_config_state.isActive());
+}
+
+// Test a completed configuration keeps the one before it, and inputs compare by content
+void test_configure_keeps_previous_config()
+{
+    bool complete = false;
+    bool error = false;
+
+    ConfigManager::g_config_state.reset();
+    ConfigManager::handleConfigure(buttonPart(1, 2, 0, 2), complete, error);
+    ConfigManager::handleConfigure(buttonPart(1, 2, 1, 3), complete, error);
+    TEST_ASSERT_TRUE(complete);
+    ConfigManager::handleConfigure(buttonPart(2, 2, 1, 3), complete, error);
+    ConfigManager::handleConfigure(buttonPart(2, 2, 0, 4), complete, error);
+    TEST_ASSERT_TRUE(complete);
+
+    const ConfigManager::ConfigImage& previous = ConfigManager::getPreviousConfig();
+    const ConfigManager::ConfigImage& current = ConfigManager::getCurrentConfig();
+    TEST_ASSERT_EQUAL_UINT32(2, ConfigManager::getCurrentConfigId());
+    TEST_ASSERT_EQUAL_UINT8(2, previous.getNumInputs());
+
+    // Completing a configuration doesn't write EEPROM (the caller stores it later)
+    TEST_ASSERT_FALSE(ConfigManager::loadFromEEPROM());
+    TEST_ASSERT_EQUAL_UINT8(2, current.getNumInputs());
+    TEST_ASSERT_EQUAL(ConfigManager::InputChange::Different, ConfigManager::compareInputs(previous, 0, current, 0));
+    TEST_ASSERT_EQUAL(ConfigManager::InputChange::Same, ConfigManager::compareInputs(previous, 4, current, 4));
+
+    // Analog inputs that only differ in dead zone can be retuned
+    ConfigManager::InputConfig analog[2];
+    analog[0].input_type = Protocol::INPUT_TYPE_ANALOG;
+    analog[0].analog.pin = 14;
+    analog[0].analog.sensitivity = 5;
+    analog[1] = analog[0];
+    analog[1].analog.dead_zone = 30;
+    ConfigManager::ConfigImage image = pack(analog, 2);
+    size_t second = image.next(0);
+    TEST_ASSERT_EQUAL(ConfigManager::InputChange::Retune, ConfigManager::compareInputs(image, 0, image, second));
+    analog[1].analog.hysteresis = 2;
+    TEST_ASSERT_TRUE(image.replace(1, analog[1]));
+    TEST_ASSERT_EQUAL(ConfigManager::InputChange::Different, ConfigManager::compareInputs(image, 0, image, second));
+}
+
+// Test a configuration that couldn't be applied hands current back to the previous one,
+// unless a configuration received since has overwritten it
+void test_revert_restores_previous_config()
+{
+    bool complete = false;
+    bool error = false;
+
+    ConfigManager::g_config_state.reset();
+    ConfigManager::handleConfigure(buttonPart(1, 1, 0, 2), complete, error);
+    TEST_ASSERT_TRUE(complete);
+    ConfigManager::handleConfigure(buttonPart(2, 2, 0, 4), complete, error);
+    ConfigManager::handleConfigure(buttonPart(2, 2, 1, 5), complete, error);
+    TEST_ASSERT_TRUE(complete);
+
+    TEST_ASSERT_TRUE(ConfigManager::revertConfiguration());
+    TEST_ASSERT_EQUAL_UINT32(1, ConfigManager::getCurrentConfigId());
+    TEST_ASSERT_EQUAL_UINT8(1, ConfigManager::getCurrentConfig().getNumInputs());
+    TEST_ASSERT_FALSE(ConfigManager::revertConfiguration()); // Once only
+
+    // Configuration 3 completes, then 4 starts over the image of 3's predecessor
+    ConfigManager::handleConfigure(buttonPart(3, 1, 0, 6), complete, error);
+    TEST_ASSERT_TRUE(complete);
+    ConfigManager::handleConfigure(buttonPart(4, 2, 0, 7), complete, error);
+    TEST_ASSERT_FALSE(complete);
+    TEST_ASSERT_FALSE(ConfigManager::revertConfiguration());
+    TEST_ASSERT_EQUAL_UINT32(3, ConfigManager::getCurrentConfigId());
+    ConfigManager::g_config_state.reset();
+}
+
+// Test the background store writes a byte per call, magic number last, and reads it back
+void test_background_store_streams_and_verifies()
+{
+    ConfigManager::InputConfig inputs[2];
+    inputs[0].input_type = Protocol::INPUT_TYPE_BUTTON;
+    inputs[0].button.pin = 2;
+    inputs[0].button.debounce = 2;
+    inputs[1] = inputs[0];
+    inputs[1].button.pin = 3;
+    ConfigManager::storeToEEPROM(7, pack(inputs, 2));
+
+    // Only the changed pin byte is written, after invalidating the old configuration
+    bool complete = false;
+    bool error = false;
+    ConfigManager::g_config_state.reset();
+    ConfigManager::handleConfigure(buttonPart(7, 2, 0, 2), complete, error);
+    ConfigManager::handleConfigure(buttonPart(7, 2, 1, 4), complete, error);
+    TEST_ASSERT_TRUE(complete);
+
+    uint32_t magic;
+    ConfigManager::storeCurrentConfig();
+    TEST_ASSERT_EQUAL(ConfigManager::StoreStatus::Writing, ConfigManager::updateStore());
+    EEPROM.get(ConfigManager::EEPROM_MAGIC_ADDR, magic);
+    TEST_ASSERT_NOT_EQUAL(ConfigManager::EEPROM_MAGIC, magic);
+    int calls = 1;
+    ConfigManager::StoreStatus status;
+    while ((status = ConfigManager::updateStore()) == ConfigManager::StoreStatus::Writing) {
+        calls++;
+    }
+    TEST_ASSERT_EQUAL(ConfigManager::StoreStatus::Stored, status);
+    TEST_ASSERT_EQUAL(3, calls); // Invalidate, pin, magic
+    TEST_ASSERT_EQUAL(ConfigManager::StoreStatus::Idle, ConfigManager::updateStore());
+    EEPROM.get(ConfigManager::EEPROM_MAGIC_ADDR, magic);
+    TEST_ASSERT_EQUAL_UINT32(ConfigManager::EEPROM_MAGIC, magic);
+
+    // Storing it again writes nothing
+    ConfigManager::storeCurrentConfig();
+    TEST_ASSERT_EQUAL(ConfigManager::StoreStatus::Stored, ConfigManager::updateStore());
+
+    // A byte changed behind the writer's back fails the read back
+    ConfigManager::g_config_state.reset();
+    ConfigManager::handleConfigure(buttonPart(8, 2, 0, 5), complete, error);
+    ConfigManager::handleConfigure(buttonPart(8, 2, 1, 6), complete, error);
+    ConfigManager::storeCurrentConfig();
+    TEST_ASSERT_EQUAL(ConfigManager::StoreStatus::Writing, ConfigManager::updateStore());
+    TEST_ASSERT_EQUAL(ConfigManager::StoreStatus::Writing, ConfigManager::updateStore());
+    mock_eeprom_storage[ConfigManager::EEPROM_VERSION_ADDR] = 0; // Already checked
+    TEST_ASSERT_EQUAL(ConfigManager::StoreStatus::Failed, finishStore());
+    TEST_ASSERT_FALSE(ConfigManager::loadFromEEPROM());
+}
+
+// Test a store keeps writing its configuration when the next one completes, and
+// fails once that configuration's buffer is reused
+void test_background_store_outlives_next_config()
+{
+    bool complete = false;
+    bool error = false;
+    uint32_t stored_id;
+
+    ConfigManager::g_config_state.reset();
+    ConfigManager::handleConfigure(buttonPart(1, 1, 0, 2), complete, error);
+    ConfigManager::storeCurrentConfig();
+    TEST_ASSERT_EQUAL(ConfigManager::StoreStatus::Writing, ConfigManager::updateStore());
+    ConfigManager::handleConfigure(buttonPart(2, 1, 0, 3), complete, error);
+    TEST_ASSERT_TRUE(complete);
+    TEST_ASSERT_EQUAL(ConfigManager::StoreStatus::Stored, finishStore());
+    EEPROM.get(ConfigManager::EEPROM_CONFIG_ID_ADDR, stored_id);
+    TEST_ASSERT_EQUAL_UINT32(1, stored_id);
+
+    // Configuration 2 is being stored; 3 completes, and 4 is received over 2
+    ConfigManager::storeCurrentConfig();
+    TEST_ASSERT_EQUAL(ConfigManager::StoreStatus::Writing, ConfigManager::updateStore());
+    ConfigManager::handleConfigure(buttonPart(3, 1, 0, 4), complete, error);
+    ConfigManager::handleConfigure(buttonPart(4, 2, 0, 5), complete, error);
+    TEST_ASSERT_EQUAL(ConfigManager::StoreStatus::Failed, ConfigManager::updateStore());
+    TEST_ASSERT_EQUAL(ConfigManager::StoreStatus::Idle, ConfigManager::updateStore());
+}
+
+// Test a stored image that doesn't decode is rejected
+void test_load_fails_with_corrupt_image()
+{
+    ConfigManager::InputConfig inputs[2];
+    inputs[0].input_type = Protocol::INPUT_TYPE_BUTTON;
+    inputs[0].button.pin = 2;
+    inputs[1] = inputs[0];
+    ConfigManager::storeToEEPROM(555, pack(inputs, 2));
+    TEST_ASSERT_TRUE(ConfigManager::loadFromEEPROM());
+
+    // Second input's type byte
+    mock_eeprom_storage[ConfigManager::EEPROM_INPUTS_ADDR + 4] = 0xEE;
+    TEST_ASSERT_FALSE(ConfigManager::loadFromEEPROM());
+    TEST_ASSERT_EQUAL_UINT8(0, ConfigManager::getCurrentConfig().getNumInputs());
+
+    // Length that disagrees with the inputs
+    ConfigManager::storeToEEPROM(555, pack(inputs, 2));
+    uint16_t size = 9;
+    EEPROM.put(ConfigManager::EEPROM_IMAGE_SIZE_ADDR, size);
+    TEST_ASSERT_FALSE(ConfigManager::loadFromEEPROM());
+}
+
 int main()
 {
     UNITY_BEGIN();
@@ -168,6 +517,15 @@ int main()
     RUN_TEST(test_load_fails_with_mismatched_version);
     RUN_TEST(test_load_fails_with_no_magic);
     RUN_TEST(test_load_fails_with_invalid_num_inputs);
+    RUN_TEST(test_analog_dead_zone_persists);
+    RUN_TEST(test_image_packs_and_replaces);
+    RUN_TEST(test_configure_max_inputs_out_of_order);
+    RUN_TEST(test_configure_over_image_size_fails);
+    RUN_TEST(test_configure_keeps_previous_config);
+    RUN_TEST(test_revert_restores_previous_config);
+    RUN_TEST(test_background_store_streams_and_verifies);
+    RUN_TEST(test_background_store_outlives_next_config);
+    RUN_TEST(test_load_fails_with_corrupt_image);
 
     return UNITY_END();
 }
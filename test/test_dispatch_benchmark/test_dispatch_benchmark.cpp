@@ -0,0 +1,256 @@
+// Dispatch benchmark: SensorManager's typed per-type loops vs. the virtual ISensor loop
+// Run with: pio test -e native -f test_dispatch_benchmark -v (prints the comparison)
+#include <chrono>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// Arduino pin definitions
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define LOW 0
+#define HIGH 1
+#define CHANGE 1
+#define NOT_AN_INTERRUPT -1
+
+#include "../EEPROM.h"
+#include "../SPI.h"
+#include "../Wire.h"
+
+// Mock hardware: a clock advanced once per tick, a slowly moving analog input
+static unsigned long g_micros = 0;
+static int g_analog_value = 512;
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    (void)pin;
+    (void)mode;
+}
+
+int digitalRead(uint8_t pin)
+{
+    (void)pin;
+    return HIGH;
+}
+void digitalWrite(uint8_t pin, uint8_t val) { (void)pin; (void)val; }
+int analogRead(uint8_t pin) { return g_analog_value + pin; }
+void delayMicroseconds(unsigned int us) { (void)us; }
+unsigned long micros() { return g_micros; }
+unsigned long millis() { return g_micros / 1000; }
+int digitalPinToInterrupt(uint8_t pin)
+{
+    (void)pin;
+    return NOT_AN_INTERRUPT;
+}
+void attachInterrupt(uint8_t interrupt, void (*isr)(void), int mode) { (void)interrupt; (void)isr; (void)mode; }
+void detachInterrupt(uint8_t interrupt) { (void)interrupt; }
+void noInterrupts() { }
+void interrupts() { }
+
+SPIClass SPI;
+void SPIClass::begin() { }
+void SPIClass::beginTransaction(SPISettings settings) { (void)settings; }
+void SPIClass::endTransaction() { }
+uint8_t SPIClass::transfer(uint8_t data) { return (uint8_t)~data; }
+
+MockWireWrite mock_wire_log[MOCK_WIRE_LOG_SIZE];
+size_t mock_wire_log_count = 0;
+uint16_t mock_wire_port[128];
+bool mock_wire_present[128];
+size_t mock_wire_read_count = 0;
+TwoWire Wire;
+
+uint8_t mock_eeprom_storage[1024];
+EEPROMClass EEPROM;
+
+#include "../../src/adc_engine.cpp"
+#include "../../src/analog_sensor.cpp"
+#include "../../src/button_group_sensor.cpp"
+#include "../../src/button_sensor.cpp"
+#include "../../src/config_manager.cpp"
+#include "../../src/encoder_sensor.cpp"
+#include "../../src/i2c_expander_sensor.cpp"
+#include "../../src/matrix_sensor.cpp"
+#include "../../src/mux_analog_sensor.cpp"
+#include "../../src/notch_sensor.cpp"
+#include "../../src/resistor_ladder_sensor.cpp"
+#include "../../src/sensor_manager.cpp"
+#include "../../src/shift_register_sensor.cpp"
+#include <unity.h>
+
+// A typical panel: 4 levers, 3 buttons, a small key matrix
+constexpr uint8_t NUM_ANALOG = 4;
+constexpr uint8_t NUM_BUTTONS = 3;
+constexpr uint8_t NUM_INPUTS = NUM_ANALOG + NUM_BUTTONS + 1;
+constexpr uint32_t TICKS = 100000;
+constexpr int RUNS = 5; // Best of, to keep scheduler noise out of the comparison
+constexpr uint32_t SCAN_US = 10000;
+
+static const uint8_t MATRIX_ROWS[] = { 20, 21 };
+static const uint8_t MATRIX_COLS[] = { 22, 23, 24 };
+
+struct Result {
+    double ns_per_tick;
+    uint32_t readings;
+};
+
+static Result g_virtual;
+static Result g_typed;
+
+static void buildConfig(ConfigManager::InputConfig* inputs)
+{
+    for (uint8_t i = 0; i < NUM_ANALOG; i++) {
+        inputs[i].input_type = Protocol::INPUT_TYPE_ANALOG;
+        inputs[i].analog.pin = (uint8_t)(14 + i);
+        inputs[i].analog.sensitivity = 8;
+    }
+    for (uint8_t i = 0; i < NUM_BUTTONS; i++) {
+        inputs[NUM_ANALOG + i].input_type = Protocol::INPUT_TYPE_BUTTON;
+        inputs[NUM_ANALOG + i].button.pin = (uint8_t)(4 + i);
+        inputs[NUM_ANALOG + i].button.debounce = 3;
+    }
+    ConfigManager::InputConfig& matrix = inputs[NUM_INPUTS - 1];
+    matrix.input_type = Protocol::INPUT_TYPE_MATRIX;
+    matrix.matrix.num_row_pins = 2;
+    matrix.matrix.num_col_pins = 3;
+    memcpy(matrix.matrix.pins, MATRIX_ROWS, 2);
+    memcpy(matrix.matrix.pins + 2, MATRIX_COLS, 3);
+}
+
+// Same lever movement for both runs
+static void advanceTick(uint32_t tick)
+{
+    g_micros += SCAN_US;
+    g_analog_value = 300 + (int)((tick / 4) % 400);
+}
+
+static double nsSince(std::chrono::steady_clock::time_point start)
+{
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// The pre-typed SensorManager loop: virtual scan() and getReading() on every sensor
+static Result runVirtual()
+{
+    Sensor::AnalogSensor analog[NUM_ANALOG] = {
+        Sensor::AnalogSensor(14, 8), Sensor::AnalogSensor(15, 8),
+        Sensor::AnalogSensor(16, 8), Sensor::AnalogSensor(17, 8)
+    };
+    Sensor::ButtonSensor buttons[NUM_BUTTONS] = {
+        Sensor::ButtonSensor(4, 3), Sensor::ButtonSensor(5, 3), Sensor::ButtonSensor(6, 3)
+    };
+    Sensor::MatrixSensor matrix(2, 3, MATRIX_ROWS, MATRIX_COLS);
+
+    Sensor::ISensor* sensors[NUM_INPUTS];
+    for (uint8_t i = 0; i < NUM_ANALOG; i++) {
+        sensors[i] = &analog[i];
+    }
+    for (uint8_t i = 0; i < NUM_BUTTONS; i++) {
+        sensors[NUM_ANALOG + i] = &buttons[i];
+    }
+    sensors[NUM_INPUTS - 1] = &matrix;
+
+    g_micros = 0;
+    AdcEngine::reset();
+    for (uint8_t i = 0; i < NUM_INPUTS; i++) {
+        sensors[i]->begin();
+    }
+    AdcEngine::start();
+
+    Result result = { 0, 0 };
+    uint8_t next = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t tick = 0; tick < TICKS; tick++) {
+        advanceTick(tick);
+        for (uint8_t i = 0; i < NUM_INPUTS; i++) {
+            sensors[i]->scan();
+        }
+        bool found = true;
+        while (found) {
+            found = false;
+            for (uint8_t i = 0; i < NUM_INPUTS; i++) {
+                uint8_t index = (uint8_t)((next + i) % NUM_INPUTS);
+                if (sensors[index]->getReading().has_value) {
+                    result.readings++;
+                    next = (uint8_t)((index + 1) % NUM_INPUTS);
+                    found = true;
+                    break;
+                }
+            }
+        }
+    }
+    result.ns_per_tick = nsSince(start) / TICKS;
+    return result;
+}
+
+// SensorManager: typed loops with direct calls
+static Result runTyped()
+{
+    ConfigManager::InputConfig inputs[NUM_INPUTS];
+    buildConfig(inputs);
+
+    g_micros = 0;
+    SensorManager::init();
+    ConfigManager::ConfigImage image;
+    for (uint8_t i = 0; i < NUM_INPUTS; i++) {
+        image.append(inputs[i]);
+    }
+    SensorManager::applyConfiguration(image);
+
+    Result result = { 0, 0 };
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t tick = 0; tick < TICKS; tick++) {
+        advanceTick(tick);
+        SensorManager::scan();
+        Sensor::Reading reading;
+        while (SensorManager::getNextReading(reading)) {
+            result.readings++;
+        }
+    }
+    result.ns_per_tick = nsSince(start) / TICKS;
+    return result;
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static Result best(Result (*run)())
+{
+    Result result = run();
+    for (int i = 1; i < RUNS; i++) {
+        Result r = run();
+        if (r.ns_per_tick < result.ns_per_tick) {
+            result = r;
+        }
+    }
+    return result;
+}
+
+void test_benchmark_report()
+{
+    g_virtual = best(runVirtual);
+    g_typed = best(runTyped);
+
+    printf("\n%u analog + %u buttons + 2x3 matrix, %lu ticks (best of %d):\n", NUM_ANALOG, NUM_BUTTONS, (unsigned long)TICKS, RUNS);
+    printf("  %-8s %7.1f ns/tick   readings %lu\n", "virtual", g_virtual.ns_per_tick, (unsigned long)g_virtual.readings);
+    printf("  %-8s %7.1f ns/tick   readings %lu\n", "typed", g_typed.ns_per_tick, (unsigned long)g_typed.readings);
+
+    TEST_ASSERT_TRUE(g_typed.readings > 0);
+}
+
+// Dispatch strategy must not change what gets reported
+void test_typed_reports_same_readings()
+{
+    TEST_ASSERT_EQUAL_UINT32(g_virtual.readings, g_typed.readings);
+}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_benchmark_report);
+    RUN_TEST(test_typed_reports_same_readings);
+
+    return UNITY_END();
+}
@@ -0,0 +1,268 @@
+// Mock Arduino environment for native testing
+#include <stdint.h>
+
+// Arduino pin definitions
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define LOW 0
+#define HIGH 1
+#define CHANGE 1
+#define NOT_AN_INTERRUPT -1
+
+// Mock encoder on pins 2 (A) and 3 (B), both with external interrupts 0 and 1
+static int g_pin_level[32];
+static void (*g_isr[2])(void);
+static int g_interrupts_disabled = 0;
+static bool g_pins_have_interrupts = true;
+static unsigned long g_micros = 0;
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    (void)pin;
+    (void)mode;
+}
+
+int digitalRead(uint8_t pin)
+{
+    return g_pin_level[pin];
+}
+
+int digitalPinToInterrupt(uint8_t pin)
+{
+    if (!g_pins_have_interrupts) {
+        return NOT_AN_INTERRUPT;
+    }
+    return (pin == 2) ? 0 : (pin == 3) ? 1 : NOT_AN_INTERRUPT;
+}
+
+void attachInterrupt(uint8_t interrupt, void (*isr)(void), int mode)
+{
+    (void)mode;
+    g_isr[interrupt] = isr;
+}
+
+void detachInterrupt(uint8_t interrupt)
+{
+    g_isr[interrupt] = nullptr;
+}
+
+void noInterrupts() { g_interrupts_disabled++; }
+void interrupts() { g_interrupts_disabled--; }
+
+unsigned long micros()
+{
+    return g_micros;
+}
+
+// Now include the sensor code (include .cpp directly since we provide mocks above)
+#include "../../src/sensor.h"
+#include "../../src/encoder_sensor.cpp"
+#include <unity.h>
+
+using namespace Sensor;
+
+// Gray code sequence for one clockwise cycle (A leads B): AB 00 -> 10 -> 11 -> 01 -> 00
+static const uint8_t CW_SEQUENCE[4] = { 0x2, 0x3, 0x1, 0x0 };
+static uint8_t g_position = 0;
+
+// Helper to set pin levels and fire the interrupt of the pin that changed
+void setLevels(uint8_t ab)
+{
+    int a = (ab >> 1) & 1;
+    int b = ab & 1;
+    bool a_changed = g_pin_level[2] != a;
+    bool b_changed = g_pin_level[3] != b;
+    g_pin_level[2] = a;
+    g_pin_level[3] = b;
+    if (a_changed && g_isr[0]) {
+        g_isr[0]();
+    }
+    if (b_changed && g_isr[1]) {
+        g_isr[1]();
+    }
+}
+
+// Helper to turn the encoder by a number of transitions (negative = counter-clockwise)
+void turn(int transitions)
+{
+    while (transitions > 0) {
+        setLevels(CW_SEQUENCE[g_position]);
+        g_position = (g_position + 1) & 3;
+        transitions--;
+    }
+    while (transitions < 0) {
+        g_position = (g_position + 3) & 3;
+        setLevels(CW_SEQUENCE[(g_position + 3) & 3]);
+        transitions++;
+    }
+}
+
+// Helper to scan one ~10ms loop later
+Reading scanLater(EncoderSensor& sensor)
+{
+    g_micros += 10000;
+    sensor.scan();
+    return sensor.getReading();
+}
+
+// Test initialization
+void test_encoder_sensor_init()
+{
+    EncoderSensor sensor(2, 3, 1, 10);
+
+    TEST_ASSERT_EQUAL(InputType::Encoder, sensor.getType());
+    TEST_ASSERT_EQUAL(2, sensor.getPin());
+}
+
+// Test that begin() attaches CHANGE interrupts to both pins
+void test_encoder_sensor_attaches_interrupts()
+{
+    EncoderSensor sensor(2, 3, 1, 10);
+    sensor.begin();
+
+    TEST_ASSERT_TRUE(sensor.isInterruptDriven());
+    TEST_ASSERT_NOT_NULL(g_isr[0]);
+    TEST_ASSERT_NOT_NULL(g_isr[1]);
+}
+
+// Test clockwise and counter-clockwise steps decoded between scans
+void test_encoder_sensor_reports_direction()
+{
+    EncoderSensor sensor(2, 3, 1, 10);
+    sensor.begin();
+
+    turn(3); // Several steps between two scans are all counted
+    Reading r = scanLater(sensor);
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(3, r.value);
+
+    turn(-5);
+    r = scanLater(sensor);
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(-5, r.value);
+
+    // Nothing moved
+    TEST_ASSERT_FALSE(scanLater(sensor).has_value);
+    TEST_ASSERT_EQUAL(0, g_interrupts_disabled);
+}
+
+// Test bounce (A toggling back and forth) cancels out
+void test_encoder_sensor_bounce_cancels()
+{
+    EncoderSensor sensor(2, 3, 1, 10);
+    sensor.begin();
+
+    for (int i = 0; i < 10; i++) {
+        turn(1);
+        turn(-1);
+    }
+    TEST_ASSERT_FALSE(scanLater(sensor).has_value);
+
+    // Both pins changing at once is an invalid transition and counts as 0
+    setLevels(0x3);
+    setLevels(0x0);
+    TEST_ASSERT_FALSE(scanLater(sensor).has_value);
+}
+
+// Test transitions are grouped into detents, keeping partial detents
+void test_encoder_sensor_steps_per_detent()
+{
+    EncoderSensor sensor(2, 3, 4, 10);
+    sensor.begin();
+
+    turn(3);
+    TEST_ASSERT_FALSE(scanLater(sensor).has_value);
+    turn(1);
+    Reading r = scanLater(sensor);
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(1, r.value);
+
+    turn(-9);
+    r = scanLater(sensor);
+    TEST_ASSERT_EQUAL(-2, r.value);
+    turn(-3);
+    r = scanLater(sensor);
+    TEST_ASSERT_EQUAL(-1, r.value);
+}
+
+// Test the send interval aggregates fast turns into one message
+void test_encoder_sensor_rate_limited_aggregation()
+{
+    EncoderSensor sensor(2, 3, 1, 5); // sensitivity 5 -> 60ms
+    sensor.begin();
+
+    int reports = 0;
+    int total = 0;
+    for (int i = 0; i < 12; i++) {
+        turn(2);
+        Reading r = scanLater(sensor);
+        if (r.has_value) {
+            reports++;
+            total += r.value;
+        }
+    }
+
+    TEST_ASSERT_EQUAL(2, reports); // 120ms of turning
+    TEST_ASSERT_EQUAL(24, total); // Nothing lost
+}
+
+// Test pins without external interrupts are decoded by polling
+void test_encoder_sensor_polled_fallback()
+{
+    g_pins_have_interrupts = false;
+    EncoderSensor sensor(2, 3, 1, 10);
+    sensor.begin();
+    TEST_ASSERT_FALSE(sensor.isInterruptDriven());
+
+    int total = 0;
+    for (int i = 0; i < 4; i++) {
+        turn(1);
+        Reading r = scanLater(sensor);
+        total += r.has_value ? r.value : 0;
+    }
+    TEST_ASSERT_EQUAL(4, total);
+}
+
+// Test destroying a sensor releases its interrupts and slot
+void test_encoder_sensor_releases_interrupts()
+{
+    for (int i = 0; i < EncoderSensor::MAX_INTERRUPT_ENCODERS + 1; i++) {
+        EncoderSensor* sensor = new EncoderSensor(2, 3, 1, 10);
+        sensor->begin();
+        TEST_ASSERT_TRUE(sensor->isInterruptDriven());
+        delete sensor;
+        TEST_ASSERT_NULL(g_isr[0]);
+        TEST_ASSERT_NULL(g_isr[1]);
+    }
+}
+
+void setUp(void)
+{
+    for (int i = 0; i < 32; i++) {
+        g_pin_level[i] = LOW;
+    }
+    g_isr[0] = nullptr;
+    g_isr[1] = nullptr;
+    g_interrupts_disabled = 0;
+    g_pins_have_interrupts = true;
+    g_position = 0;
+    g_micros = 0;
+}
+void tearDown(void) {}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_encoder_sensor_init);
+    RUN_TEST(test_encoder_sensor_attaches_interrupts);
+    RUN_TEST(test_encoder_sensor_reports_direction);
+    RUN_TEST(test_encoder_sensor_bounce_cancels);
+    RUN_TEST(test_encoder_sensor_steps_per_detent);
+    RUN_TEST(test_encoder_sensor_rate_limited_aggregation);
+    RUN_TEST(test_encoder_sensor_polled_fallback);
+    RUN_TEST(test_encoder_sensor_releases_interrupts);
+
+    return UNITY_END();
+}
@@ -0,0 +1,177 @@
+// Filter benchmark: lag and jitter of raw, EMA and One-Euro filtering on lever traces
+// Run with: pio test -e native -f test_filter_benchmark -v (prints the comparison table)
+#include "../../src/analog_filter.h"
+#include "../../src/analog_send_policy.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unity.h>
+
+using namespace Sensor;
+
+// Lever trace: a scripted sequence of rests and throws at the ~100 Hz scan rate, with
+// pot/ADC noise added. Modelled on throttle captures: +/-4 count noise with occasional
+// +/-7 count outliers, fast throws of 8-12 scans and a slow fine adjustment.
+struct Segment {
+    uint16_t target; // Lever position at the end of the segment
+    uint16_t scans; // Duration
+};
+
+static const Segment LEVER_SCRIPT[] = {
+    { 200, 100 }, // Rest
+    { 850, 12 }, // Fast throw
+    { 850, 100 }, // Rest
+    { 700, 60 }, // Slow adjustment
+    { 700, 100 }, // Rest
+    { 200, 8 }, // Very fast throw back
+    { 200, 100 }, // Rest
+};
+
+constexpr uint16_t MAX_TRACE = 500;
+constexpr uint16_t SETTLE_SCANS = 50; // Ignored at the start of each rest when measuring jitter
+constexpr uint32_t SCAN_US = 10000; // Nominal loop period for the send policy
+
+struct Trace {
+    uint16_t truth[MAX_TRACE]; // Noiseless lever position
+    uint16_t samples[MAX_TRACE]; // What the ADC reports
+    bool at_rest[MAX_TRACE]; // Sample belongs to a settled rest window
+    uint16_t length;
+};
+
+// Deterministic noise so the benchmark is reproducible
+static uint32_t g_noise_state = 12345;
+static int16_t noise()
+{
+    g_noise_state = g_noise_state * 1103515245u + 12345u;
+    uint8_t r = (uint8_t)(g_noise_state >> 16);
+    if (r < 8) {
+        return (r & 1) ? 7 : -7; // Occasional outlier
+    }
+    return (int16_t)(r % 9) - 4;
+}
+
+static void buildTrace(Trace& trace)
+{
+    uint16_t position = LEVER_SCRIPT[0].target;
+    trace.length = 0;
+
+    for (size_t s = 0; s < sizeof(LEVER_SCRIPT) / sizeof(LEVER_SCRIPT[0]); s++) {
+        const Segment& segment = LEVER_SCRIPT[s];
+        uint16_t start = position;
+        bool rest = (segment.target == start);
+
+        for (uint16_t i = 1; i <= segment.scans && trace.length < MAX_TRACE; i++) {
+            int32_t truth = start + ((int32_t)segment.target - start) * i / segment.scans;
+            trace.truth[trace.length] = (uint16_t)truth;
+            trace.samples[trace.length] = (uint16_t)(truth + noise());
+            trace.at_rest[trace.length] = rest && i > SETTLE_SCANS;
+            trace.length++;
+        }
+        position = segment.target;
+    }
+}
+
+struct Result {
+    uint16_t jitter; // Worst peak-to-peak output swing within a rest window (counts)
+    uint32_t lag_error; // Summed |output - truth| while the lever moves and settles (counts * scans)
+    uint16_t sends; // Values sent by the send policy at sensitivity 10
+};
+
+static Result run(const Trace& trace, AnalogFilter filter)
+{
+    Result result = { 0, 0, 0 };
+    AnalogSendPolicy policy(10);
+    uint16_t window_min = 0xFFFF;
+    uint16_t window_max = 0;
+
+    for (uint16_t i = 0; i < trace.length; i++) {
+        uint16_t output = filter.apply(trace.samples[i]);
+
+        policy.update(output, (uint32_t)i * SCAN_US);
+        if (i > 0 && policy.shouldSend()) {
+            policy.markSent();
+            result.sends++;
+        } else if (i == 0) {
+            policy.markSent();
+        }
+
+        if (trace.at_rest[i]) {
+            window_min = (output < window_min) ? output : window_min;
+            window_max = (output > window_max) ? output : window_max;
+        } else {
+            if (window_max >= window_min && window_max - window_min > result.jitter) {
+                result.jitter = window_max - window_min;
+            }
+            window_min = 0xFFFF;
+            window_max = 0;
+            result.lag_error += (uint32_t)abs((int32_t)output - (int32_t)trace.truth[i]);
+        }
+    }
+    if (window_max >= window_min && window_max - window_min > result.jitter) {
+        result.jitter = window_max - window_min;
+    }
+
+    return result;
+}
+
+static Trace g_trace;
+static Result g_raw;
+static Result g_ema;
+static Result g_one_euro;
+
+// EMA tuned for quiet idle; One-Euro uses the same alpha at rest
+constexpr uint8_t BENCH_ALPHA = 24;
+constexpr uint8_t BENCH_BETA = 64;
+
+static void printResult(const char* name, const Result& r)
+{
+    printf("  %-10s jitter %3u counts   lag error %6lu   sends %3u\n", name, r.jitter, (unsigned long)r.lag_error, r.sends);
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_benchmark_report()
+{
+    buildTrace(g_trace);
+    g_raw = run(g_trace, AnalogFilter());
+    g_ema = run(g_trace, AnalogFilter(AnalogFilter::EMA, BENCH_ALPHA));
+    g_one_euro = run(g_trace, AnalogFilter(AnalogFilter::ONE_EURO, BENCH_ALPHA, BENCH_BETA));
+
+    printf("\nLever trace, %u scans (alpha %u, beta %u):\n", g_trace.length, BENCH_ALPHA, BENCH_BETA);
+    printResult("raw", g_raw);
+    printResult("EMA", g_ema);
+    printResult("One-Euro", g_one_euro);
+
+    TEST_ASSERT_TRUE(g_trace.length > 0);
+}
+
+// One-Euro is as quiet as the EMA at rest...
+void test_one_euro_jitter_matches_ema()
+{
+    TEST_ASSERT_LESS_OR_EQUAL(g_ema.jitter + 1, g_one_euro.jitter);
+    TEST_ASSERT_LESS_THAN(g_raw.jitter, g_one_euro.jitter);
+}
+
+// ...but follows throws with far less lag
+void test_one_euro_lag_below_ema()
+{
+    TEST_ASSERT_LESS_THAN(g_ema.lag_error / 2, g_one_euro.lag_error);
+}
+
+// Quiet idle means fewer noise-driven sends than raw
+void test_one_euro_sends_below_raw()
+{
+    TEST_ASSERT_LESS_THAN(g_raw.sends, g_one_euro.sends);
+}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_benchmark_report);
+    RUN_TEST(test_one_euro_jitter_matches_ema);
+    RUN_TEST(test_one_euro_lag_below_ema);
+    RUN_TEST(test_one_euro_sends_below_raw);
+
+    return UNITY_END();
+}
@@ -0,0 +1,268 @@
+// Mock Arduino environment for native testing
+#include <stdint.h>
+#include <string.h>
+
+// Arduino pin definitions
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define LOW 0
+#define HIGH 1
+
+#include "../Wire.h"
+
+// Mock Wire backend storage
+MockWireWrite mock_wire_log[MOCK_WIRE_LOG_SIZE];
+size_t mock_wire_log_count = 0;
+uint16_t mock_wire_port[128];
+bool mock_wire_present[128];
+size_t mock_wire_read_count = 0;
+TwoWire Wire;
+
+// Mock INT line (active LOW)
+static int g_int_level = HIGH;
+
+// Mock time
+static unsigned long g_micros = 0;
+
+unsigned long micros() { return g_micros; }
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    (void)pin;
+    (void)mode;
+}
+
+int digitalRead(uint8_t pin)
+{
+    (void)pin;
+    return g_int_level;
+}
+
+// Now include the sensor code
+#include "../../src/sensor.h"
+#include "../../src/i2c_expander_sensor.cpp"
+#include <unity.h>
+
+using namespace Sensor;
+
+static constexpr uint8_t ADDR = 0x20;
+static constexpr uint8_t INT_PIN = 7;
+static constexpr uint16_t ID_BASE = 512;
+
+// Helper to reset mock state
+void resetMockState()
+{
+    memset(mock_wire_log, 0, sizeof(mock_wire_log));
+    mock_wire_log_count = 0;
+    memset(mock_wire_present, 0, sizeof(mock_wire_present));
+    mock_wire_read_count = 0;
+    for (int i = 0; i < 128; i++) {
+        mock_wire_port[i] = 0xFFFF; // All inputs released (pulled up)
+    }
+    mock_wire_present[ADDR] = true;
+    g_int_level = HIGH;
+    g_micros = 0;
+}
+
+// Helper to press an input: drives the pin LOW and asserts INT like the chip does
+void pressInput(uint8_t index)
+{
+    mock_wire_port[ADDR] &= ~(1 << index);
+    g_int_level = LOW;
+}
+
+// Helper to release an input
+void releaseInput(uint8_t index)
+{
+    mock_wire_port[ADDR] |= (1 << index);
+    g_int_level = LOW;
+}
+
+// Helper to begin a sensor and forget its startup traffic
+void beginQuiet(I2CExpanderSensor& sensor)
+{
+    sensor.begin();
+    sensor.scan(); // Initial read
+    mock_wire_read_count = 0;
+    g_int_level = HIGH;
+}
+
+// Helper to check a logged write
+void assertWrite(size_t entry, uint8_t len, const uint8_t* data)
+{
+    TEST_ASSERT_EQUAL_UINT8(ADDR, mock_wire_log[entry].address);
+    TEST_ASSERT_EQUAL_UINT8(len, mock_wire_log[entry].length);
+    for (uint8_t i = 0; i < len; i++) {
+        TEST_ASSERT_EQUAL_UINT8(data[i], mock_wire_log[entry].data[i]);
+    }
+}
+
+// Test initialization
+void test_expander_sensor_init()
+{
+    I2CExpanderSensor sensor(Protocol::EXPANDER_CHIP_MCP23017, ADDR, INT_PIN, ID_BASE);
+
+    TEST_ASSERT_EQUAL(InputType::I2CExpander, sensor.getType());
+    TEST_ASSERT_EQUAL(ADDR, sensor.getPin());
+}
+
+// Test MCP23017 register setup traffic
+void test_expander_sensor_mcp23017_register_setup()
+{
+    I2CExpanderSensor sensor(Protocol::EXPANDER_CHIP_MCP23017, ADDR, INT_PIN, ID_BASE);
+    sensor.begin();
+
+    TEST_ASSERT_EQUAL(5, mock_wire_log_count);
+    const uint8_t iocon[] = { 0x0A, 0x64 };
+    const uint8_t iodir[] = { 0x00, 0xFF, 0xFF };
+    const uint8_t gppu[] = { 0x0C, 0xFF, 0xFF };
+    const uint8_t gpinten[] = { 0x04, 0xFF, 0xFF };
+    const uint8_t gpio[] = { 0x12 };
+    assertWrite(0, 2, iocon);
+    assertWrite(1, 3, iodir);
+    assertWrite(2, 3, gppu);
+    assertWrite(3, 3, gpinten);
+    assertWrite(4, 1, gpio);
+}
+
+// Test PCF8575 setup traffic
+void test_expander_sensor_pcf8575_setup()
+{
+    I2CExpanderSensor sensor(Protocol::EXPANDER_CHIP_PCF8575, ADDR, INT_PIN, ID_BASE);
+    sensor.begin();
+
+    TEST_ASSERT_EQUAL(1, mock_wire_log_count);
+    const uint8_t all_inputs[] = { 0xFF, 0xFF };
+    assertWrite(0, 2, all_inputs);
+}
+
+// Test that the bus is left alone while INT is idle
+void test_expander_sensor_no_read_without_int()
+{
+    I2CExpanderSensor sensor(Protocol::EXPANDER_CHIP_MCP23017, ADDR, INT_PIN, ID_BASE);
+    beginQuiet(sensor);
+    size_t writes = mock_wire_log_count;
+
+    // Scan every 1ms until just before the safety poll is due
+    for (uint32_t i = 1; i < I2CExpanderSensor::SAFETY_POLL_US / 1000; i++) {
+        g_micros += 1000;
+        sensor.scan();
+    }
+
+    TEST_ASSERT_EQUAL(0, mock_wire_read_count);
+    TEST_ASSERT_EQUAL(writes, mock_wire_log_count); // Reads never rewrite the register pointer
+}
+
+// Test slow safety poll reads even without INT
+void test_expander_sensor_safety_poll()
+{
+    I2CExpanderSensor sensor(Protocol::EXPANDER_CHIP_MCP23017, ADDR, INT_PIN, ID_BASE);
+    beginQuiet(sensor);
+
+    g_micros += I2CExpanderSensor::SAFETY_POLL_US - 1;
+    sensor.scan();
+    TEST_ASSERT_EQUAL(0, mock_wire_read_count);
+
+    g_micros += 1;
+    sensor.scan();
+    TEST_ASSERT_EQUAL(1, mock_wire_read_count);
+
+    // The interval restarts from that read
+    sensor.scan();
+    TEST_ASSERT_EQUAL(1, mock_wire_read_count);
+}
+
+// Test INT-triggered press with debounce continuing after INT clears
+void test_expander_sensor_press_detection()
+{
+    I2CExpanderSensor sensor(Protocol::EXPANDER_CHIP_MCP23017, ADDR, INT_PIN, ID_BASE);
+    beginQuiet(sensor);
+
+    pressInput(10); // Port B, input 2
+    sensor.scan();
+    g_int_level = HIGH; // Reading the port clears INT
+
+    sensor.scan();
+    TEST_ASSERT_FALSE(sensor.getReading().has_value);
+
+    sensor.scan();
+
+    Reading r = sensor.getReading();
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(1, r.value);
+    TEST_ASSERT_EQUAL(InputType::I2CExpander, r.type);
+    TEST_ASSERT_EQUAL(ID_BASE + 10, r.pin);
+    TEST_ASSERT_EQUAL(3, mock_wire_read_count);
+
+    // Settled: no more reads
+    sensor.scan();
+    TEST_ASSERT_EQUAL(3, mock_wire_read_count);
+}
+
+// Test release detection
+void test_expander_sensor_release_detection()
+{
+    I2CExpanderSensor sensor(Protocol::EXPANDER_CHIP_PCF8575, ADDR, INT_PIN, ID_BASE);
+    beginQuiet(sensor);
+
+    pressInput(0);
+    for (int i = 0; i < 3; i++) sensor.scan();
+    sensor.getReading(); // Consume press
+
+    releaseInput(0);
+    for (int i = 0; i < 3; i++) sensor.scan();
+
+    Reading r = sensor.getReading();
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(0, r.value);
+    TEST_ASSERT_EQUAL(ID_BASE, r.pin);
+}
+
+// Test bounce shorter than the debounce threshold is filtered
+void test_expander_sensor_debounce_filters_glitches()
+{
+    I2CExpanderSensor sensor(Protocol::EXPANDER_CHIP_MCP23017, ADDR, INT_PIN, ID_BASE);
+    beginQuiet(sensor);
+
+    pressInput(5);
+    sensor.scan();
+    sensor.scan();
+    releaseInput(5);
+    for (int i = 0; i < 5; i++) sensor.scan();
+
+    TEST_ASSERT_FALSE(sensor.getReading().has_value);
+}
+
+// Test missing device keeps state and produces no events
+void test_expander_sensor_missing_device()
+{
+    mock_wire_present[ADDR] = false;
+    I2CExpanderSensor sensor(Protocol::EXPANDER_CHIP_MCP23017, ADDR, Protocol::EXPANDER_NO_INT_PIN, ID_BASE);
+    sensor.begin();
+
+    for (int i = 0; i < 5; i++) sensor.scan();
+
+    TEST_ASSERT_EQUAL(5, mock_wire_read_count); // Polled every scan without INT line
+    TEST_ASSERT_FALSE(sensor.getReading().has_value);
+}
+
+void setUp(void) { resetMockState(); }
+void tearDown(void) {}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_expander_sensor_init);
+    RUN_TEST(test_expander_sensor_mcp23017_register_setup);
+    RUN_TEST(test_expander_sensor_pcf8575_setup);
+    RUN_TEST(test_expander_sensor_no_read_without_int);
+    RUN_TEST(test_expander_sensor_safety_poll);
+    RUN_TEST(test_expander_sensor_press_detection);
+    RUN_TEST(test_expander_sensor_release_detection);
+    RUN_TEST(test_expander_sensor_debounce_filters_glitches);
+    RUN_TEST(test_expander_sensor_missing_device);
+
+    return UNITY_END();
+}
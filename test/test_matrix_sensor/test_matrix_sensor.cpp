@@ -15,6 +15,44 @@ static bool g_button_pressed[8][8];
 static uint8_t g_pin_state[32]; // Pin states (supports pins 0-31)
 static uint8_t g_row_pin_start = 2;
 static uint8_t g_col_pin_start = 5;
+static bool g_diodeless = false; // Simulate sneak paths through pressed keys
+
+// Columns electrically connected to a row through pressed keys
+// With diodes this is just the row's own pressed keys; without diodes
+// current also flows backwards through other rows (ghosting)
+static uint8_t connectedColumns(uint8_t row)
+{
+    uint8_t cols = 0;
+    for (uint8_t col = 0; col < 8; col++) {
+        if (g_button_pressed[row][col]) {
+            cols |= (1 << col);
+        }
+    }
+    if (!g_diodeless) {
+        return cols;
+    }
+
+    uint8_t rows = (1 << row);
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (uint8_t r = 0; r < 8; r++) {
+            for (uint8_t c = 0; c < 8; c++) {
+                if (!g_button_pressed[r][c]) {
+                    continue;
+                }
+                bool row_in = rows & (1 << r);
+                bool col_in = cols & (1 << c);
+                if (row_in != col_in) {
+                    rows |= (1 << r);
+                    cols |= (1 << c);
+                    changed = true;
+                }
+            }
+        }
+    }
+    return cols;
+}
 
 void pinMode(uint8_t pin, uint8_t mode)
 {
@@ -38,10 +76,11 @@ int digitalRead(uint8_t pin)
         // Check if this row is active (LOW)
         if (row_pin < 32 && g_pin_state[row_pin] == LOW) {
             // Check all columns for this row
+            uint8_t cols = connectedColumns(row);
             for (uint8_t col = 0; col < 8; col++) {
                 uint8_t col_pin = g_col_pin_start + col;
                 // If reading this column pin and button is pressed
-                if (pin == col_pin && g_button_pressed[row][col]) {
+                if (pin == col_pin && (cols & (1 << col))) {
                     return LOW;
                 }
             }
@@ -69,6 +108,7 @@ void resetMockState()
     memset(g_pin_state, HIGH, sizeof(g_pin_state));
     g_row_pin_start = 2;
     g_col_pin_start = 5;
+    g_diodeless = false;
 }
 
 // Helper to configure mock pin mapping
@@ -359,6 +399,133 @@ void test_matrix_sensor_event_queue_overflow()
     TEST_ASSERT_GREATER_OR_EQUAL(7, event_count);
 }
 
+// Helper to drain all pending events, returns number drained
+int drainEvents(MatrixSensor& sensor)
+{
+    int count = 0;
+    while (sensor.getReading().has_value && count < 64) {
+        count++;
+    }
+    return count;
+}
+
+// Test ghost mask flags all four corners of a rectangle
+void test_matrix_sensor_ghost_mask_rectangle()
+{
+    uint8_t raw[3] = { 0x03, 0x03, 0x04 }; // Rows 0 and 1 share columns 0 and 1
+    uint8_t ghost[3];
+
+    MatrixSensor::computeGhostMask(raw, 3, ghost);
+
+    TEST_ASSERT_EQUAL_UINT8(0x03, ghost[0]);
+    TEST_ASSERT_EQUAL_UINT8(0x03, ghost[1]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ghost[2]);
+}
+
+// Test ghost mask ignores rows sharing a single column
+void test_matrix_sensor_ghost_mask_single_shared_column()
+{
+    uint8_t raw[3] = { 0x03, 0x01, 0x06 };
+    uint8_t ghost[3];
+
+    MatrixSensor::computeGhostMask(raw, 3, ghost);
+
+    TEST_ASSERT_EQUAL_UINT8(0x00, ghost[0]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ghost[1]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, ghost[2]);
+}
+
+// Test diode-less matrix never reports the phantom fourth key
+void test_matrix_sensor_diodeless_suppresses_phantom()
+{
+    uint8_t rows[] = {2, 3, 4};
+    uint8_t cols[] = {5, 6, 7, 8};
+    MatrixSensor sensor(3, 4, rows, cols, false);
+    sensor.begin();
+    g_diodeless = true;
+
+    // Two keys on row 0
+    pressButton(0, 0);
+    pressButton(0, 1);
+    for (int i = 0; i < 3; i++) sensor.scan();
+    TEST_ASSERT_EQUAL(2, drainEvents(sensor));
+
+    // Third corner of the rectangle - (1, 1) would ghost
+    pressButton(1, 0);
+    for (int i = 0; i < 10; i++) sensor.scan();
+
+    // Neither the real third key nor the phantom is reported while ambiguous
+    TEST_ASSERT_EQUAL(0, drainEvents(sensor));
+
+    // Releasing one key resolves the ambiguity, the real key is reported
+    releaseButton(0, 1);
+    for (int i = 0; i < 3; i++) sensor.scan();
+
+    bool saw_release_01 = false;
+    bool saw_press_10 = false;
+    bool saw_phantom = false;
+    while (true) {
+        Reading r = sensor.getReading();
+        if (!r.has_value) break;
+        if (r.pin == 129 && r.value == 0) saw_release_01 = true;
+        if (r.pin == 132 && r.value == 1) saw_press_10 = true;
+        if (r.pin == 133) saw_phantom = true;
+    }
+    TEST_ASSERT_TRUE(saw_release_01);
+    TEST_ASSERT_TRUE(saw_press_10);
+    TEST_ASSERT_FALSE(saw_phantom);
+}
+
+// Test matrix with diodes reports all keys of a rectangle
+void test_matrix_sensor_diodes_report_rectangle()
+{
+    uint8_t rows[] = {2, 3, 4};
+    uint8_t cols[] = {5, 6, 7, 8};
+    MatrixSensor sensor(3, 4, rows, cols, true);
+    sensor.begin();
+
+    pressButton(0, 0);
+    pressButton(0, 1);
+    pressButton(1, 0);
+    pressButton(1, 1);
+    for (int i = 0; i < 3; i++) sensor.scan();
+
+    TEST_ASSERT_EQUAL(4, drainEvents(sensor));
+}
+
+// Test eager debounce reports each key on its first edge and rejects bounce
+void test_matrix_sensor_eager_debounce()
+{
+    uint8_t rows[] = {2, 3, 4};
+    uint8_t cols[] = {5, 6, 7, 8};
+    MatrixSensor sensor(3, 4, rows, cols, true, true);
+    sensor.begin();
+
+    pressButton(1, 2);
+    sensor.scan();
+
+    Reading r = sensor.getReading();
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(1, r.value);
+    TEST_ASSERT_EQUAL(128 + 1 * 4 + 2, r.pin);
+
+    // Bounce within the default lockout is ignored
+    releaseButton(1, 2);
+    sensor.scan();
+    pressButton(1, 2);
+    sensor.scan();
+    releaseButton(1, 2);
+    sensor.scan();
+    TEST_ASSERT_EQUAL(0, drainEvents(sensor));
+
+    // Key released for good: one release once the lockout ends
+    for (int i = 0; i < 5; i++) sensor.scan();
+    r = sensor.getReading();
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(0, r.value);
+    TEST_ASSERT_EQUAL(0, drainEvents(sensor));
+}
+
 void setUp(void) { resetMockState(); }
 void tearDown(void) {}
 
@@ -377,6 +544,11 @@ int main(int argc, char** argv)
     RUN_TEST(test_matrix_sensor_full_cycle);
     RUN_TEST(test_matrix_sensor_2x2);
     RUN_TEST(test_matrix_sensor_event_queue_overflow);
+    RUN_TEST(test_matrix_sensor_ghost_mask_rectangle);
+    RUN_TEST(test_matrix_sensor_ghost_mask_single_shared_column);
+    RUN_TEST(test_matrix_sensor_diodeless_suppresses_phantom);
+    RUN_TEST(test_matrix_sensor_diodes_report_rectangle);
+    RUN_TEST(test_matrix_sensor_eager_debounce);
 
     return UNITY_END();
 }
@@ -0,0 +1,132 @@
+#include "../../src/median_filter.h"
+#include <unity.h>
+
+using namespace Sensor;
+
+// Test that window 0 passes samples through
+void test_median_off_passthrough()
+{
+    MedianFilter filter;
+
+    TEST_ASSERT_EQUAL_UINT16(100, filter.apply(100));
+    TEST_ASSERT_EQUAL_UINT16(900, filter.apply(900));
+}
+
+// Test that unsupported window sizes disable the filter
+void test_median_invalid_window_is_off()
+{
+    MedianFilter filter(4);
+
+    TEST_ASSERT_EQUAL_UINT8(0, filter.getWindow());
+    filter.apply(100);
+    TEST_ASSERT_EQUAL_UINT16(900, filter.apply(900));
+}
+
+// Test that median-of-3 removes a single-sample spike
+void test_median3_rejects_single_spike()
+{
+    MedianFilter filter(3);
+
+    TEST_ASSERT_EQUAL_UINT16(500, filter.apply(500));
+    TEST_ASSERT_EQUAL_UINT16(500, filter.apply(1023)); // Spike
+    TEST_ASSERT_EQUAL_UINT16(500, filter.apply(500));
+    TEST_ASSERT_EQUAL_UINT16(500, filter.apply(0)); // Spike the other way
+    TEST_ASSERT_EQUAL_UINT16(500, filter.apply(500));
+}
+
+// Test that median-of-5 removes a two-sample spike
+void test_median5_rejects_double_spike()
+{
+    MedianFilter filter(5);
+
+    filter.apply(500);
+    filter.apply(501);
+    TEST_ASSERT_EQUAL_UINT16(500, filter.apply(1023));
+    TEST_ASSERT_EQUAL_UINT16(501, filter.apply(1023));
+    TEST_ASSERT_EQUAL_UINT16(501, filter.apply(499));
+}
+
+// Test that a real step passes after (N - 1) / 2 samples
+void test_median_step_delay()
+{
+    MedianFilter median3(3);
+    MedianFilter median5(5);
+
+    median3.apply(100);
+    median5.apply(100);
+
+    TEST_ASSERT_EQUAL_UINT16(100, median3.apply(800));
+    TEST_ASSERT_EQUAL_UINT16(800, median3.apply(800));
+
+    TEST_ASSERT_EQUAL_UINT16(100, median5.apply(800));
+    TEST_ASSERT_EQUAL_UINT16(100, median5.apply(800));
+    TEST_ASSERT_EQUAL_UINT16(800, median5.apply(800));
+}
+
+// Test the median-of-5 network against every ordering of 5 distinct values
+void test_median5_network_all_permutations()
+{
+    const uint16_t values[5] = { 10, 20, 30, 40, 50 };
+    uint8_t order[5] = { 0, 1, 2, 3, 4 };
+
+    // Heap's algorithm over all 120 permutations
+    uint8_t c[5] = { 0, 0, 0, 0, 0 };
+    uint8_t checked = 0;
+    uint8_t i = 0;
+    for (;;) {
+        // After 5 samples history[] holds exactly this ordering
+        MedianFilter filter(5);
+        uint16_t result = 0;
+        for (uint8_t k = 0; k < 5; k++) {
+            result = filter.apply(values[order[k]]);
+        }
+        TEST_ASSERT_EQUAL_UINT16(30, result);
+        checked++;
+
+        while (i < 5 && c[i] >= i) {
+            c[i] = 0;
+            i++;
+        }
+        if (i >= 5) {
+            break;
+        }
+        uint8_t j = (i % 2 == 0) ? 0 : c[i];
+        uint8_t tmp = order[j];
+        order[j] = order[i];
+        order[i] = tmp;
+        c[i]++;
+        i = 0;
+    }
+
+    TEST_ASSERT_EQUAL(120, checked);
+}
+
+// Test that reset re-seeds the window from the next sample
+void test_median_reset()
+{
+    MedianFilter filter(5);
+
+    filter.apply(100);
+    filter.apply(100);
+    filter.reset();
+
+    TEST_ASSERT_EQUAL_UINT16(900, filter.apply(900));
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_median_off_passthrough);
+    RUN_TEST(test_median_invalid_window_is_off);
+    RUN_TEST(test_median3_rejects_single_spike);
+    RUN_TEST(test_median5_rejects_double_spike);
+    RUN_TEST(test_median_step_delay);
+    RUN_TEST(test_median5_network_all_permutations);
+    RUN_TEST(test_median_reset);
+
+    return UNITY_END();
+}
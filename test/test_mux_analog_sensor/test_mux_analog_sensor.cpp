@@ -0,0 +1,280 @@
+// Mock Arduino environment for native testing
+#include <stdint.h>
+#include <string.h>
+
+// Arduino pin definitions
+#define INPUT 0
+#define OUTPUT 1
+#define LOW 0
+#define HIGH 1
+#define A0 14
+
+// Mock mux: select pins S0-S3 are 2-5, SIG is on A0
+static const uint8_t SELECT_PIN_ARRAY[4] = { 2, 3, 4, 5 };
+static uint8_t g_pin_state[32];
+static uint16_t g_channel_values[16];
+static unsigned long g_micros = 0;
+static int g_analog_reads = 0;
+static int g_select_writes = 0;
+static unsigned long g_waited_us = 0;
+
+// Conversion time of one analogRead on AVR at the default prescaler
+static constexpr unsigned long CONVERSION_US = 112;
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    (void)pin;
+    (void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+    if (pin < 32) {
+        g_pin_state[pin] = val;
+    }
+    g_select_writes++;
+}
+
+unsigned long micros()
+{
+    return g_micros;
+}
+
+void delayMicroseconds(unsigned int us)
+{
+    g_waited_us += us;
+    g_micros += us;
+}
+
+void noInterrupts() { }
+void interrupts() { }
+
+int analogRead(uint8_t pin)
+{
+    (void)pin;
+    uint8_t channel = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+        if (g_pin_state[SELECT_PIN_ARRAY[i]] == HIGH) {
+            channel |= (1 << i);
+        }
+    }
+    g_analog_reads++;
+    g_micros += CONVERSION_US;
+    return g_channel_values[channel];
+}
+
+// Now include the sensor code
+#include "../../src/sensor.h"
+#include "../../src/adc_engine.cpp"
+#include "../../src/mux_analog_sensor.cpp"
+#include <unity.h>
+
+using namespace Sensor;
+
+static constexpr uint16_t ID_BASE = 256;
+
+// Helper to reset mock state
+void resetMockState()
+{
+    memset(g_pin_state, LOW, sizeof(g_pin_state));
+    for (uint8_t ch = 0; ch < 16; ch++) {
+        g_channel_values[ch] = 100 * ch;
+    }
+    g_micros = 0;
+    g_analog_reads = 0;
+    g_select_writes = 0;
+    g_waited_us = 0;
+}
+
+// Helper to run one scan with the rest of the loop (~10ms) in between
+void scanWithLoopDelay(MuxAnalogSensor& sensor)
+{
+    g_micros += 10000;
+    sensor.scan();
+}
+
+// Test initialization
+void test_mux_sensor_init()
+{
+    MuxAnalogSensor sensor(A0, 10, 16, 0, SELECT_PIN_ARRAY, ID_BASE);
+
+    TEST_ASSERT_EQUAL(InputType::MuxAnalog, sensor.getType());
+    TEST_ASSERT_EQUAL(A0, sensor.getPin());
+}
+
+// Test each channel is read through the pipelined select lines
+void test_mux_sensor_reports_every_channel()
+{
+    MuxAnalogSensor sensor(A0, 10, 16, 0, SELECT_PIN_ARRAY, ID_BASE);
+    sensor.begin();
+
+    scanWithLoopDelay(sensor);
+    TEST_ASSERT_EQUAL(16, g_analog_reads);
+
+    // Channel 0 reads 0 (no change from initial state), all others report their value
+    bool seen[16];
+    memset(seen, 0, sizeof(seen));
+    int count = 0;
+    while (true) {
+        Reading r = sensor.getReading();
+        if (!r.has_value) break;
+        uint16_t channel = r.pin - ID_BASE;
+        TEST_ASSERT_LESS_THAN(16, channel);
+        TEST_ASSERT_EQUAL(100 * channel, r.value);
+        TEST_ASSERT_EQUAL(InputType::MuxAnalog, r.type);
+        seen[channel] = true;
+        count++;
+        if (count > 20) break; // Safety limit
+    }
+    TEST_ASSERT_EQUAL(15, count);
+    for (uint8_t ch = 1; ch < 16; ch++) {
+        TEST_ASSERT_TRUE(seen[ch]);
+    }
+}
+
+// Test the scan leaves the mux pointing at channel 0 for the next scan
+void test_mux_sensor_pipeline_wraps_to_first_channel()
+{
+    MuxAnalogSensor sensor(A0, 10, 4, 0, SELECT_PIN_ARRAY, ID_BASE);
+    sensor.begin();
+
+    scanWithLoopDelay(sensor);
+
+    TEST_ASSERT_EQUAL(LOW, g_pin_state[2]);
+    TEST_ASSERT_EQUAL(LOW, g_pin_state[3]);
+}
+
+// Test only the select lines needed for the channel count are driven
+void test_mux_sensor_uses_needed_select_lines()
+{
+    MuxAnalogSensor sensor(A0, 10, 4, 0, SELECT_PIN_ARRAY, ID_BASE);
+    sensor.begin();
+    g_select_writes = 0;
+
+    scanWithLoopDelay(sensor);
+
+    // 0->1 (S0), 1->2 (S0+S1), 2->3 (S0), 3->0 (S0+S1) = 6 writes, S2/S3 untouched
+    TEST_ASSERT_EQUAL(6, g_select_writes);
+}
+
+// Test blocking reads only wait out the rest of the settle time, without throwaway conversions
+void test_mux_sensor_waits_only_for_settle()
+{
+    MuxAnalogSensor sensor(A0, 10, 4, 20, SELECT_PIN_ARRAY, ID_BASE);
+    sensor.begin();
+
+    scanWithLoopDelay(sensor);
+
+    // Channel 0 settled during the loop delay, channels 1-3 were switched right
+    // before their read (processing takes no mock time)
+    TEST_ASSERT_EQUAL(4, g_analog_reads);
+    TEST_ASSERT_EQUAL(3 * 20, (int)g_waited_us);
+
+    // Without a settle time nothing is waited for
+    MuxAnalogSensor quick(A0, 10, 4, 0, SELECT_PIN_ARRAY, ID_BASE);
+    quick.begin();
+    g_waited_us = 0;
+    scanWithLoopDelay(quick);
+    TEST_ASSERT_EQUAL(0, (int)g_waited_us);
+}
+
+// Test a single-channel mux never switches and never discards
+void test_mux_sensor_single_channel_never_discards()
+{
+    MuxAnalogSensor sensor(A0, 10, 1, 200, SELECT_PIN_ARRAY, ID_BASE);
+    sensor.begin();
+    g_micros += 1000; // Settled since begin()
+
+    // Back-to-back scans, well inside settle_us
+    for (int i = 0; i < 5; i++) {
+        sensor.scan();
+    }
+
+    TEST_ASSERT_EQUAL(5, g_analog_reads);
+}
+
+// Test each sample from the ADC interrupt moves the select lines on, wrapping to channel 0
+void test_mux_sensor_capture_switches_to_next_channel()
+{
+    MuxAnalogSensor sensor(A0, 10, 4, 0, SELECT_PIN_ARRAY, ID_BASE);
+    sensor.begin();
+
+    sensor.capture(0);
+    TEST_ASSERT_EQUAL(HIGH, g_pin_state[2]);
+    TEST_ASSERT_EQUAL(LOW, g_pin_state[3]);
+
+    sensor.capture(100);
+    TEST_ASSERT_EQUAL(LOW, g_pin_state[2]);
+    TEST_ASSERT_EQUAL(HIGH, g_pin_state[3]);
+
+    sensor.capture(200);
+    sensor.capture(300);
+    TEST_ASSERT_EQUAL(LOW, g_pin_state[2]);
+    TEST_ASSERT_EQUAL(LOW, g_pin_state[3]);
+    TEST_ASSERT_EQUAL(0, g_analog_reads); // The engine did the conversions
+}
+
+// Test a sample whose conversion started within settle_us of the switch is thrown away
+void test_mux_sensor_capture_discards_unsettled_sample()
+{
+    MuxAnalogSensor sensor(A0, 10, 4, 20, SELECT_PIN_ARRAY, ID_BASE);
+    sensor.begin();
+    g_micros += 1000; // Settled since begin()
+
+    sensor.capture(0);
+    TEST_ASSERT_EQUAL(HIGH, g_pin_state[2]); // Now on channel 1
+
+    // Back-to-back conversion: started right after the switch
+    g_micros += AdcEngine::CONVERSION_US + 6;
+    sensor.capture(100);
+    TEST_ASSERT_EQUAL(HIGH, g_pin_state[2]); // Discarded, still on channel 1
+
+    // The next one started a full conversion after the switch
+    g_micros += AdcEngine::CONVERSION_US;
+    sensor.capture(100);
+    TEST_ASSERT_EQUAL(LOW, g_pin_state[2]);
+    TEST_ASSERT_EQUAL(HIGH, g_pin_state[3]); // Channel 2
+}
+
+// Test channels share AnalogSensor's send policy (dead zone)
+void test_mux_sensor_channel_send_policy()
+{
+    MuxAnalogSensor sensor(A0, 10, 2, 0, SELECT_PIN_ARRAY, ID_BASE);
+    sensor.begin();
+
+    scanWithLoopDelay(sensor);
+    while (sensor.getReading().has_value) { }
+
+    // Jitter within the dead zone on channel 1
+    g_channel_values[1] += 1;
+    scanWithLoopDelay(sensor);
+    TEST_ASSERT_FALSE(sensor.getReading().has_value);
+
+    // Real change on channel 1
+    g_channel_values[1] += 50;
+    scanWithLoopDelay(sensor);
+    Reading r = sensor.getReading();
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(ID_BASE + 1, r.pin);
+    TEST_ASSERT_EQUAL(151, r.value);
+}
+
+void setUp(void) { resetMockState(); }
+void tearDown(void) {}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_mux_sensor_init);
+    RUN_TEST(test_mux_sensor_reports_every_channel);
+    RUN_TEST(test_mux_sensor_pipeline_wraps_to_first_channel);
+    RUN_TEST(test_mux_sensor_uses_needed_select_lines);
+    RUN_TEST(test_mux_sensor_waits_only_for_settle);
+    RUN_TEST(test_mux_sensor_single_channel_never_discards);
+    RUN_TEST(test_mux_sensor_capture_switches_to_next_channel);
+    RUN_TEST(test_mux_sensor_capture_discards_unsettled_sample);
+    RUN_TEST(test_mux_sensor_channel_send_policy);
+
+    return UNITY_END();
+}
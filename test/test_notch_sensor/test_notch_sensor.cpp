@@ -0,0 +1,155 @@
+// Mock Arduino environment for native testing
+#include <stdint.h>
+
+// Arduino pin definitions
+#define INPUT 0
+#define OUTPUT 1
+#define A0 14
+
+// Mock Arduino functions
+static uint16_t g_mock_analog_value = 0;
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    (void)pin;
+    (void)mode;
+}
+int analogRead(uint8_t pin)
+{
+    (void)pin;
+    return g_mock_analog_value;
+}
+
+// Now include the sensor code (include .cpp directly since we provide mocks above)
+#include "../../src/sensor.h"
+#include "../../src/adc_engine.cpp"
+#include "../../src/notch_sensor.cpp"
+#include <unity.h>
+
+using namespace Sensor;
+
+// Reverser-style lever: notches 0 | 300 | 600 | 900 (4 notches)
+static const uint16_t THRESHOLDS[3] = { 300, 600, 900 };
+
+// Helper to set mock analog value
+void setMockAnalogValue(uint16_t value)
+{
+    g_mock_analog_value = value;
+}
+
+// Helper to scan and return the reported notch (-1 if none)
+int scanNotch(NotchSensor& sensor, uint16_t value)
+{
+    setMockAnalogValue(value);
+    sensor.scan();
+    Reading r = sensor.getReading();
+    return r.has_value ? r.value : -1;
+}
+
+// Test initialization
+void test_notch_sensor_init()
+{
+    NotchSensor sensor(A0, 8, 3, THRESHOLDS);
+
+    TEST_ASSERT_EQUAL(InputType::AnalogNotch, sensor.getType());
+    TEST_ASSERT_EQUAL(A0, sensor.getPin());
+}
+
+// Test that the first scan reports where the lever is
+void test_notch_sensor_reports_initial_notch()
+{
+    NotchSensor sensor(A0, 8, 3, THRESHOLDS);
+    sensor.begin();
+
+    TEST_ASSERT_EQUAL(2, scanNotch(sensor, 650));
+
+    // Nothing more while it rests
+    TEST_ASSERT_EQUAL(-1, scanNotch(sensor, 655));
+}
+
+// Test that the initial placement ignores hysteresis
+void test_notch_sensor_initial_notch_exact()
+{
+    NotchSensor sensor(A0, 8, 3, THRESHOLDS);
+    sensor.begin();
+
+    TEST_ASSERT_EQUAL(1, scanNotch(sensor, 302));
+}
+
+// Test that only notch changes are reported while the lever moves
+void test_notch_sensor_reports_only_changes()
+{
+    NotchSensor sensor(A0, 8, 3, THRESHOLDS);
+    sensor.begin();
+    TEST_ASSERT_EQUAL(0, scanNotch(sensor, 0));
+
+    int events = 0;
+    for (uint16_t v = 0; v <= 1020; v += 4) {
+        events += (scanNotch(sensor, v) >= 0) ? 1 : 0;
+    }
+
+    // A full sweep is 3 events instead of hundreds of values
+    TEST_ASSERT_EQUAL(3, events);
+}
+
+// Test hysteresis around a threshold
+void test_notch_sensor_hysteresis()
+{
+    NotchSensor sensor(A0, 8, 3, THRESHOLDS);
+    sensor.begin();
+    TEST_ASSERT_EQUAL(0, scanNotch(sensor, 290));
+
+    // Up needs threshold + band
+    TEST_ASSERT_EQUAL(-1, scanNotch(sensor, 307));
+    TEST_ASSERT_EQUAL(1, scanNotch(sensor, 308));
+
+    // Resting on the boundary doesn't flicker
+    for (int i = 0; i < 20; i++) {
+        TEST_ASSERT_EQUAL(-1, scanNotch(sensor, (i & 1) ? 296 : 304));
+    }
+
+    // Down needs threshold - band
+    TEST_ASSERT_EQUAL(-1, scanNotch(sensor, 292));
+    TEST_ASSERT_EQUAL(0, scanNotch(sensor, 291));
+}
+
+// Test that a fast throw across several notches is one event
+void test_notch_sensor_skips_notches()
+{
+    NotchSensor sensor(A0, 8, 3, THRESHOLDS);
+    sensor.begin();
+    TEST_ASSERT_EQUAL(0, scanNotch(sensor, 0));
+
+    TEST_ASSERT_EQUAL(3, scanNotch(sensor, 1000));
+    TEST_ASSERT_EQUAL(0, scanNotch(sensor, 10));
+}
+
+// Test the pure quantiser at the table ends
+void test_notch_sensor_quantize_bounds()
+{
+    NotchSensor sensor(A0, 0, 3, THRESHOLDS);
+
+    TEST_ASSERT_EQUAL(0, sensor.quantize(0, 0));
+    TEST_ASSERT_EQUAL(0, sensor.quantize(299, 3));
+    TEST_ASSERT_EQUAL(1, sensor.quantize(300, 0));
+    TEST_ASSERT_EQUAL(3, sensor.quantize(1023, 0));
+    TEST_ASSERT_EQUAL(3, sensor.quantize(900, 3));
+}
+
+void setUp(void) { g_mock_analog_value = 0; }
+void tearDown(void) {}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_notch_sensor_init);
+    RUN_TEST(test_notch_sensor_reports_initial_notch);
+    RUN_TEST(test_notch_sensor_initial_notch_exact);
+    RUN_TEST(test_notch_sensor_reports_only_changes);
+    RUN_TEST(test_notch_sensor_hysteresis);
+    RUN_TEST(test_notch_sensor_skips_notches);
+    RUN_TEST(test_notch_sensor_quantize_bounds);
+
+    return UNITY_END();
+}
@@ -264,6 +264,218 @@ void test_configure_roundtrip()
     TEST_ASSERT_EQUAL_UINT8(original.analog.sensitivity, decoded.analog.sensitivity);
 }
 
+// Test Configure roundtrip for Analog with oversampling
+void test_configure_analog_oversample_roundtrip()
+{
+    Configure original;
+    original.input_type = INPUT_TYPE_ANALOG;
+    original.analog.pin = 14;
+    original.analog.sensitivity = 5;
+    original.analog.oversample = 2;
+
+    uint8_t buffer[64];
+    size_t size = original.encode(buffer, sizeof(buffer));
+
+    // header(8) + pin + sensitivity + oversample = 11
+    TEST_ASSERT_EQUAL(11, size);
+    TEST_ASSERT_EQUAL_UINT8(2, buffer[10]);
+
+    Configure decoded;
+    TEST_ASSERT_TRUE(decoded.decode(buffer, size));
+    TEST_ASSERT_EQUAL_UINT8(2, decoded.analog.oversample);
+
+    // Without the trailing byte, oversampling is off
+    TEST_ASSERT_TRUE(decoded.decode(buffer, size - 1));
+    TEST_ASSERT_EQUAL_UINT8(0, decoded.analog.oversample);
+}
+
+// Test Configure decode rejects oversampling beyond 64x
+void test_configure_analog_oversample_invalid()
+{
+    uint8_t buffer[] = { MESSAGE_TYPE_CONFIGURE, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, INPUT_TYPE_ANALOG, 14, 5, MAX_OVERSAMPLE_BITS + 1 };
+
+    Configure cfg;
+    TEST_ASSERT_FALSE(cfg.decode(buffer, sizeof(buffer)));
+}
+
+// Test Configure roundtrip for Analog with a filter (oversample is sent as a placeholder)
+void test_configure_analog_filter_roundtrip()
+{
+    Configure original;
+    original.input_type = INPUT_TYPE_ANALOG;
+    original.analog.pin = 14;
+    original.analog.sensitivity = 8;
+    original.analog.filter = ANALOG_FILTER_EMA2;
+    original.analog.filter_alpha = 40;
+
+    uint8_t buffer[64];
+    size_t size = original.encode(buffer, sizeof(buffer));
+
+    // header(8) + pin + sensitivity + oversample + filter + filter_alpha = 13
+    TEST_ASSERT_EQUAL(13, size);
+    TEST_ASSERT_EQUAL_UINT8(0, buffer[10]);
+    TEST_ASSERT_EQUAL_UINT8(ANALOG_FILTER_EMA2, buffer[11]);
+    TEST_ASSERT_EQUAL_UINT8(40, buffer[12]);
+
+    Configure decoded;
+    TEST_ASSERT_TRUE(decoded.decode(buffer, size));
+    TEST_ASSERT_EQUAL_UINT8(0, decoded.analog.oversample);
+    TEST_ASSERT_EQUAL_UINT8(ANALOG_FILTER_EMA2, decoded.analog.filter);
+    TEST_ASSERT_EQUAL_UINT8(40, decoded.analog.filter_alpha);
+}
+
+// Test Configure roundtrip for Analog with a One-Euro filter
+void test_configure_analog_one_euro_roundtrip()
+{
+    Configure original;
+    original.input_type = INPUT_TYPE_ANALOG;
+    original.analog.pin = 15;
+    original.analog.sensitivity = 10;
+    original.analog.oversample = 1;
+    original.analog.filter = ANALOG_FILTER_ONE_EURO;
+    original.analog.filter_alpha = 16;
+    original.analog.filter_beta = 64;
+
+    uint8_t buffer[64];
+    size_t size = original.encode(buffer, sizeof(buffer));
+
+    // header(8) + pin + sensitivity + oversample + filter + filter_alpha + filter_beta = 14
+    TEST_ASSERT_EQUAL(14, size);
+
+    Configure decoded;
+    TEST_ASSERT_TRUE(decoded.decode(buffer, size));
+    TEST_ASSERT_EQUAL_UINT8(1, decoded.analog.oversample);
+    TEST_ASSERT_EQUAL_UINT8(ANALOG_FILTER_ONE_EURO, decoded.analog.filter);
+    TEST_ASSERT_EQUAL_UINT8(16, decoded.analog.filter_alpha);
+    TEST_ASSERT_EQUAL_UINT8(64, decoded.analog.filter_beta);
+
+    // Without the trailing byte, beta is 0 (plain EMA behaviour)
+    TEST_ASSERT_TRUE(decoded.decode(buffer, size - 1));
+    TEST_ASSERT_EQUAL_UINT8(0, decoded.analog.filter_beta);
+}
+
+// Test Configure roundtrip for Analog with a median prefilter and no smoothing
+void test_configure_analog_median_roundtrip()
+{
+    Configure original;
+    original.input_type = INPUT_TYPE_ANALOG;
+    original.analog.pin = 14;
+    original.analog.sensitivity = 5;
+    original.analog.median = ANALOG_MEDIAN_5;
+
+    uint8_t buffer[64];
+    size_t size = original.encode(buffer, sizeof(buffer));
+
+    // header(8) + pin + sensitivity + 4 placeholder options + median = 15
+    TEST_ASSERT_EQUAL(15, size);
+    TEST_ASSERT_EQUAL_UINT8(ANALOG_MEDIAN_5, buffer[14]);
+
+    Configure decoded;
+    TEST_ASSERT_TRUE(decoded.decode(buffer, size));
+    TEST_ASSERT_EQUAL_UINT8(ANALOG_FILTER_NONE, decoded.analog.filter);
+    TEST_ASSERT_EQUAL_UINT8(ANALOG_MEDIAN_5, decoded.analog.median);
+
+    // Only 3 and 5 are valid windows
+    buffer[14] = 4;
+    TEST_ASSERT_FALSE(decoded.decode(buffer, size));
+}
+
+// Test Configure roundtrip for Analog with a calibrated dead zone
+void test_configure_analog_dead_zone_roundtrip()
+{
+    Configure original;
+    original.input_type = INPUT_TYPE_ANALOG;
+    original.analog.pin = 14;
+    original.analog.sensitivity = 5;
+    original.analog.dead_zone = 7;
+
+    uint8_t buffer[64];
+    size_t size = original.encode(buffer, sizeof(buffer));
+
+    // header(8) + pin + sensitivity + 5 placeholder options + dead_zone = 16
+    TEST_ASSERT_EQUAL(16, size);
+    TEST_ASSERT_EQUAL_UINT8(7, buffer[15]);
+
+    Configure decoded;
+    TEST_ASSERT_TRUE(decoded.decode(buffer, size));
+    TEST_ASSERT_EQUAL_UINT8(ANALOG_MEDIAN_OFF, decoded.analog.median);
+    TEST_ASSERT_EQUAL_UINT8(7, decoded.analog.dead_zone);
+
+    // Omitted means default
+    TEST_ASSERT_TRUE(decoded.decode(buffer, size - 1));
+    TEST_ASSERT_EQUAL_UINT8(0, decoded.analog.dead_zone);
+}
+
+// Test Configure roundtrip for Analog with a hysteresis band
+void test_configure_analog_hysteresis_roundtrip()
+{
+    Configure original;
+    original.input_type = INPUT_TYPE_ANALOG;
+    original.analog.pin = 14;
+    original.analog.sensitivity = 5;
+    original.analog.hysteresis = 3;
+
+    uint8_t buffer[64];
+    size_t size = original.encode(buffer, sizeof(buffer));
+
+    // header(8) + pin + sensitivity + 6 placeholder options + hysteresis = 17
+    TEST_ASSERT_EQUAL(17, size);
+    TEST_ASSERT_EQUAL_UINT8(0, buffer[15]);
+    TEST_ASSERT_EQUAL_UINT8(3, buffer[16]);
+
+    Configure decoded;
+    TEST_ASSERT_TRUE(decoded.decode(buffer, size));
+    TEST_ASSERT_EQUAL_UINT8(0, decoded.analog.dead_zone);
+    TEST_ASSERT_EQUAL_UINT8(3, decoded.analog.hysteresis);
+}
+
+// Test Configure roundtrip for Analog with send intervals
+void test_configure_analog_intervals_roundtrip()
+{
+    Configure original;
+    original.input_type = INPUT_TYPE_ANALOG;
+    original.analog.pin = 14;
+    original.analog.sensitivity = 5;
+    original.analog.min_interval_ms = 25;
+    original.analog.keepalive_ms = 5000;
+
+    uint8_t buffer[64];
+    size_t size = original.encode(buffer, sizeof(buffer));
+
+    // header(8) + pin + sensitivity + 7 placeholder options + 2 u16 intervals = 21
+    TEST_ASSERT_EQUAL(21, size);
+    TEST_ASSERT_EQUAL_UINT8(25, buffer[17]);
+    TEST_ASSERT_EQUAL_UINT8(0, buffer[18]);
+    TEST_ASSERT_EQUAL_UINT8(0x88, buffer[19]);
+    TEST_ASSERT_EQUAL_UINT8(0x13, buffer[20]);
+
+    Configure decoded;
+    TEST_ASSERT_TRUE(decoded.decode(buffer, size));
+    TEST_ASSERT_EQUAL_UINT16(25, decoded.analog.min_interval_ms);
+    TEST_ASSERT_EQUAL_UINT16(5000, decoded.analog.keepalive_ms);
+
+    // Only min_interval_ms present
+    TEST_ASSERT_TRUE(decoded.decode(buffer, size - 2));
+    TEST_ASSERT_EQUAL_UINT16(25, decoded.analog.min_interval_ms);
+    TEST_ASSERT_EQUAL_UINT16(0, decoded.analog.keepalive_ms);
+
+    // Half a u16 is malformed
+    TEST_ASSERT_FALSE(decoded.decode(buffer, size - 1));
+}
+
+// Test Configure decode rejects unknown filters and zero coefficients
+void test_configure_analog_filter_invalid()
+{
+    uint8_t buffer[] = { MESSAGE_TYPE_CONFIGURE, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, INPUT_TYPE_ANALOG, 14, 5, 0, ANALOG_FILTER_EMA, 0 };
+
+    Configure cfg;
+    TEST_ASSERT_FALSE(cfg.decode(buffer, sizeof(buffer)));
+
+    buffer[11] = ANALOG_FILTER_ONE_EURO + 1;
+    buffer[12] = 64;
+    TEST_ASSERT_FALSE(cfg.decode(buffer, sizeof(buffer)));
+}
+
 // Test Configure encoding for Button
 void test_configure_button_encode()
 {
@@ -328,6 +540,31 @@ void test_configure_button_roundtrip()
     TEST_ASSERT_EQUAL_UINT8(original.button.debounce, decoded.button.debounce);
 }
 
+// Test Configure roundtrip for Button with eager debounce
+void test_configure_button_flags_roundtrip()
+{
+    Configure original;
+    original.input_type = INPUT_TYPE_BUTTON;
+    original.button.pin = 4;
+    original.button.debounce = 5;
+    original.button.flags = BUTTON_FLAG_EAGER_DEBOUNCE;
+
+    uint8_t buffer[64];
+    size_t size = original.encode(buffer, sizeof(buffer));
+
+    TEST_ASSERT_EQUAL(11, size); // header(8) + pin + debounce + flags
+    TEST_ASSERT_EQUAL_UINT8(BUTTON_FLAG_EAGER_DEBOUNCE, buffer[10]);
+
+    Configure decoded;
+    TEST_ASSERT_TRUE(decoded.decode(buffer, size));
+    TEST_ASSERT_EQUAL_UINT8(5, decoded.button.debounce);
+    TEST_ASSERT_EQUAL_UINT8(BUTTON_FLAG_EAGER_DEBOUNCE, decoded.button.flags);
+
+    // Without the trailing byte, flags default to 0 (counter debounce)
+    TEST_ASSERT_TRUE(decoded.decode(buffer, size - 1));
+    TEST_ASSERT_EQUAL_UINT8(0, decoded.button.flags);
+}
+
 // Test Configure encoding for Matrix
 void test_configure_matrix_encode()
 {
@@ -430,6 +667,34 @@ void test_configure_matrix_roundtrip()
     }
 }
 
+// Test Configure roundtrip for Matrix with option flags
+void test_configure_matrix_flags_roundtrip()
+{
+    Configure original;
+    original.input_type = INPUT_TYPE_MATRIX;
+    original.matrix.num_row_pins = 2;
+    original.matrix.num_col_pins = 2;
+    for (uint8_t i = 0; i < 4; i++) {
+        original.matrix.pins[i] = i + 2;
+    }
+    original.matrix.flags = MATRIX_FLAG_NO_DIODES;
+
+    uint8_t buffer[64];
+    size_t size = original.encode(buffer, sizeof(buffer));
+
+    // header(8) + counts(2) + pins(4) + flags(1) = 15
+    TEST_ASSERT_EQUAL(15, size);
+    TEST_ASSERT_EQUAL_UINT8(MATRIX_FLAG_NO_DIODES, buffer[14]);
+
+    Configure decoded;
+    TEST_ASSERT_TRUE(decoded.decode(buffer, size));
+    TEST_ASSERT_EQUAL_UINT8(MATRIX_FLAG_NO_DIODES, decoded.matrix.flags);
+
+    // Without the trailing byte, flags default to 0 (matrix has diodes)
+    TEST_ASSERT_TRUE(decoded.decode(buffer, size - 1));
+    TEST_ASSERT_EQUAL_UINT8(0, decoded.matrix.flags);
+}
+
 // Test Configure decode with insufficient data for matrix
 void test_configure_matrix_decode_insufficient_data()
 {
@@ -470,6 +735,274 @@ void test_configure_matrix_decode_too_many_pins()
     TEST_ASSERT_FALSE(result);
 }
 
+// Test Configure roundtrip for Shift Register
+void test_configure_shift_register_roundtrip()
+{
+    Configure original;
+    original.config_id = 0x55667788;
+    original.total_parts = 1;
+    original.part_number = 0;
+    original.input_type = INPUT_TYPE_SHIFT_REGISTER;
+    original.shift_register.latch_pin = 10;
+    original.shift_register.num_registers = 32;
+
+    uint8_t buffer[64];
+    size_t size = original.encode(buffer, sizeof(buffer));
+
+    TEST_ASSERT_EQUAL(10, size); // header(8) + latch_pin(1) + num_registers(1)
+
+    Configure decoded;
+    TEST_ASSERT_TRUE(decoded.decode(buffer, size));
+    TEST_ASSERT_EQUAL_UINT8(INPUT_TYPE_SHIFT_REGISTER, decoded.input_type);
+    TEST_ASSERT_EQUAL_UINT8(10, decoded.shift_register.latch_pin);
+    TEST_ASSERT_EQUAL_UINT8(32, decoded.shift_register.num_registers);
+}
+
+// Test Configure decode rejects invalid shift register chain length
+void test_configure_shift_register_decode_invalid_length()
+{
+    uint8_t buffer[] = {
+        MESSAGE_TYPE_CONFIGURE,
+        0x01, 0x00, 0x00, 0x00,
+        0x01, 0x00,
+        INPUT_TYPE_SHIFT_REGISTER,
+        0x0A, // latch_pin
+        0x21 // num_registers = 33 (> MAX_SHIFT_REGISTERS)
+    };
+
+    Configure cfg;
+    TEST_ASSERT_FALSE(cfg.decode(buffer, sizeof(buffer)));
+
+    buffer[9] = 0; // Empty chain
+    TEST_ASSERT_FALSE(cfg.decode(buffer, sizeof(buffer)));
+}
+
+// Test Configure roundtrip for I2C Expander
+void test_configure_expander_roundtrip()
+{
+    Configure original;
+    original.input_type = INPUT_TYPE_I2C_EXPANDER;
+    original.expander.chip = EXPANDER_CHIP_MCP23017;
+    original.expander.address = 0x27;
+    original.expander.int_pin = 7;
+
+    uint8_t buffer[64];
+    size_t size = original.encode(buffer, sizeof(buffer));
+
+    TEST_ASSERT_EQUAL(11, size); // header(8) + chip(1) + address(1) + int_pin(1)
+
+    Configure decoded;
+    TEST_ASSERT_TRUE(decoded.decode(buffer, size));
+    TEST_ASSERT_EQUAL_UINT8(INPUT_TYPE_I2C_EXPANDER, decoded.input_type);
+    TEST_ASSERT_EQUAL_UINT8(EXPANDER_CHIP_MCP23017, decoded.expander.chip);
+    TEST_ASSERT_EQUAL_UINT8(0x27, decoded.expander.address);
+    TEST_ASSERT_EQUAL_UINT8(7, decoded.expander.int_pin);
+
+    // Unknown chip is rejected
+    buffer[8] = 0x05;
+    TEST_ASSERT_FALSE(decoded.decode(buffer, size));
+}
+
+// Test Configure roundtrip for Analog Mux
+void test_configure_analog_mux_roundtrip()
+{
+    Configure original;
+    original.input_type = INPUT_TYPE_ANALOG_MUX;
+    original.analog_mux.adc_pin = 14;
+    original.analog_mux.sensitivity = 7;
+    original.analog_mux.num_channels = 12;
+    original.analog_mux.settle_us = 20;
+    for (uint8_t i = 0; i < MUX_SELECT_PINS; i++) {
+        original.analog_mux.select_pins[i] = i + 4;
+    }
+
+    uint8_t buffer[64];
+    size_t size = original.encode(buffer, sizeof(buffer));
+
+    TEST_ASSERT_EQUAL(16, size); // header(8) + adc_pin + sensitivity + num_channels + settle_us + 4 select pins
+
+    Configure decoded;
+    TEST_ASSERT_TRUE(decoded.decode(buffer, size));
+    TEST_ASSERT_EQUAL_UINT8(INPUT_TYPE_ANALOG_MUX, decoded.input_type);
+    TEST_ASSERT_EQUAL_UINT8(14, decoded.analog_mux.adc_pin);
+    TEST_ASSERT_EQUAL_UINT8(7, decoded.analog_mux.sensitivity);
+    TEST_ASSERT_EQUAL_UINT8(12, decoded.analog_mux.num_channels);
+    TEST_ASSERT_EQUAL_UINT8(20, decoded.analog_mux.settle_us);
+    for (uint8_t i = 0; i < MUX_SELECT_PINS; i++) {
+        TEST_ASSERT_EQUAL_UINT8(i + 4, decoded.analog_mux.select_pins[i]);
+    }
+
+    // Too many channels is rejected
+    buffer[10] = MAX_MUX_CHANNELS + 1;
+    TEST_ASSERT_FALSE(decoded.decode(buffer, size));
+}
+
+// Test Configure roundtrip for a lever notch table
+void test_configure_analog_notch_roundtrip()
+{
+    Configure original;
+    original.input_type = INPUT_TYPE_ANALOG_NOTCH;
+    original.notch.pin = 15;
+    original.notch.hysteresis = 6;
+    original.notch.num_thresholds = 3;
+    original.notch.thresholds[0] = 200;
+    original.notch.thresholds[1] = 512;
+    original.notch.thresholds[2] = 800;
+
+    uint8_t buffer[64];
+    size_t size = original.encode(buffer, sizeof(buffer));
+
+    TEST_ASSERT_EQUAL(17, size); // header(8) + pin + hysteresis + num_thresholds + 3 u16 thresholds
+    TEST_ASSERT_EQUAL_UINT8(0x00, buffer[13]);
+    TEST_ASSERT_EQUAL_UINT8(0x02, buffer[14]);
+
+    Configure decoded;
+    TEST_ASSERT_TRUE(decoded.decode(buffer, size));
+    TEST_ASSERT_EQUAL_UINT8(INPUT_TYPE_ANALOG_NOTCH, decoded.input_type);
+    TEST_ASSERT_EQUAL_UINT8(15, decoded.notch.pin);
+    TEST_ASSERT_EQUAL_UINT8(6, decoded.notch.hysteresis);
+    TEST_ASSERT_EQUAL_UINT8(3, decoded.notch.num_thresholds);
+    TEST_ASSERT_EQUAL_UINT16(200, decoded.notch.thresholds[0]);
+    TEST_ASSERT_EQUAL_UINT16(512, decoded.notch.thresholds[1]);
+    TEST_ASSERT_EQUAL_UINT16(800, decoded.notch.thresholds[2]);
+
+    // Truncated table
+    TEST_ASSERT_FALSE(decoded.decode(buffer, size - 1));
+
+    // Thresholds must ascend
+    buffer[15] = 0x00;
+    buffer[16] = 0x01; // 256 < 512
+    TEST_ASSERT_FALSE(decoded.decode(buffer, size));
+
+    // Table size limits
+    buffer[10] = 0;
+    TEST_ASSERT_FALSE(decoded.decode(buffer, size));
+    original.notch.num_thresholds = MAX_NOTCH_THRESHOLDS + 1;
+    TEST_ASSERT_EQUAL(0, original.encode(buffer, sizeof(buffer)));
+}
+
+// Test Configure roundtrip for a resistor ladder
+void test_configure_resistor_ladder_roundtrip()
+{
+    Configure original;
+    original.input_type = INPUT_TYPE_RESISTOR_LADDER;
+    original.ladder.pin = 16;
+    original.ladder.debounce = 3;
+    original.ladder.num_buttons = 2;
+    original.ladder.thresholds[0] = 300;
+    original.ladder.thresholds[1] = 700;
+
+    uint8_t buffer[64];
+    size_t size = original.encode(buffer, sizeof(buffer));
+
+    TEST_ASSERT_EQUAL(15, size); // header(8) + pin + debounce + num_buttons + 2 u16 thresholds
+
+    Configure decoded;
+    TEST_ASSERT_TRUE(decoded.decode(buffer, size));
+    TEST_ASSERT_EQUAL_UINT8(INPUT_TYPE_RESISTOR_LADDER, decoded.input_type);
+    TEST_ASSERT_EQUAL_UINT8(16, decoded.ladder.pin);
+    TEST_ASSERT_EQUAL_UINT8(3, decoded.ladder.debounce);
+    TEST_ASSERT_EQUAL_UINT8(2, decoded.ladder.num_buttons);
+    TEST_ASSERT_EQUAL_UINT16(300, decoded.ladder.thresholds[0]);
+    TEST_ASSERT_EQUAL_UINT16(700, decoded.ladder.thresholds[1]);
+
+    TEST_ASSERT_FALSE(decoded.decode(buffer, size - 1));
+
+    // Too many buttons
+    buffer[10] = MAX_LADDER_BUTTONS + 1;
+    TEST_ASSERT_FALSE(decoded.decode(buffer, size));
+}
+
+// Test Configure roundtrip for a quadrature encoder
+void test_configure_encoder_roundtrip()
+{
+    Configure original;
+    original.input_type = INPUT_TYPE_ENCODER;
+    original.encoder.pin_a = 2;
+    original.encoder.pin_b = 3;
+    original.encoder.steps_per_detent = 4;
+    original.encoder.sensitivity = 8;
+
+    uint8_t buffer[64];
+    size_t size = original.encode(buffer, sizeof(buffer));
+
+    TEST_ASSERT_EQUAL(12, size); // header(8) + pin_a + pin_b + steps_per_detent + sensitivity
+
+    Configure decoded;
+    TEST_ASSERT_TRUE(decoded.decode(buffer, size));
+    TEST_ASSERT_EQUAL_UINT8(INPUT_TYPE_ENCODER, decoded.input_type);
+    TEST_ASSERT_EQUAL_UINT8(2, decoded.encoder.pin_a);
+    TEST_ASSERT_EQUAL_UINT8(3, decoded.encoder.pin_b);
+    TEST_ASSERT_EQUAL_UINT8(4, decoded.encoder.steps_per_detent);
+    TEST_ASSERT_EQUAL_UINT8(8, decoded.encoder.sensitivity);
+
+    TEST_ASSERT_FALSE(decoded.decode(buffer, size - 1));
+
+    // Same pin twice
+    buffer[9] = 2;
+    TEST_ASSERT_FALSE(decoded.decode(buffer, size));
+}
+
+// Test Configure roundtrip for a button group
+void test_configure_button_group_roundtrip()
+{
+    Configure original;
+    original.input_type = INPUT_TYPE_BUTTON_GROUP;
+    original.button_group.num_pins = 3;
+    original.button_group.pins[0] = 4;
+    original.button_group.pins[1] = 5;
+    original.button_group.pins[2] = 22;
+    original.button_group.debounce = 0;
+
+    uint8_t buffer[64];
+    size_t size = original.encode(buffer, sizeof(buffer));
+
+    TEST_ASSERT_EQUAL(12, size); // header(8) + num_pins + 3 pins, default debounce omitted
+
+    Configure decoded;
+    TEST_ASSERT_TRUE(decoded.decode(buffer, size));
+    TEST_ASSERT_EQUAL_UINT8(INPUT_TYPE_BUTTON_GROUP, decoded.input_type);
+    TEST_ASSERT_EQUAL_UINT8(3, decoded.button_group.num_pins);
+    TEST_ASSERT_EQUAL_UINT8(4, decoded.button_group.pins[0]);
+    TEST_ASSERT_EQUAL_UINT8(5, decoded.button_group.pins[1]);
+    TEST_ASSERT_EQUAL_UINT8(22, decoded.button_group.pins[2]);
+
+    TEST_ASSERT_FALSE(decoded.decode(buffer, size - 1));
+
+    // Empty and oversized groups are rejected
+    buffer[8] = 0;
+    TEST_ASSERT_FALSE(decoded.decode(buffer, size));
+    buffer[8] = MAX_BUTTON_GROUP_PINS + 1;
+    TEST_ASSERT_FALSE(decoded.decode(buffer, sizeof(buffer)));
+}
+
+// Test the optional button group debounce byte
+void test_configure_button_group_debounce()
+{
+    Configure original;
+    original.input_type = INPUT_TYPE_BUTTON_GROUP;
+    original.button_group.num_pins = 2;
+    original.button_group.pins[0] = 4;
+    original.button_group.pins[1] = 5;
+    original.button_group.debounce = 5;
+
+    uint8_t buffer[64];
+    size_t size = original.encode(buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL(12, size); // header(8) + num_pins + 2 pins + debounce
+
+    Configure decoded;
+    TEST_ASSERT_TRUE(decoded.decode(buffer, size));
+    TEST_ASSERT_EQUAL_UINT8(5, decoded.button_group.debounce);
+
+    // Omitted by older hosts
+    TEST_ASSERT_TRUE(decoded.decode(buffer, size - 1));
+    TEST_ASSERT_EQUAL_UINT8(0, decoded.button_group.debounce);
+
+    // Beyond the vertical counters
+    buffer[size - 1] = MAX_BUTTON_GROUP_DEBOUNCE + 1;
+    TEST_ASSERT_FALSE(decoded.decode(buffer, size));
+}
+
 // Test Configure decode with unknown input type
 void test_configure_decode_unknown_type()
 {
@@ -720,6 +1253,128 @@ void test_message_decode_set_output()
     TEST_ASSERT_EQUAL_UINT8(1, msg.set_output.value);
 }
 
+// InputValueExtended tests
+
+void test_input_value_extended_encode()
+{
+    InputValueExtended msg;
+    msg.input_id = extendedInputId(2, 19); // 256 * 3 + 19 = 787
+    msg.value = -2;
+
+    uint8_t buffer[16];
+    size_t size = msg.encode(buffer, sizeof(buffer));
+
+    TEST_ASSERT_EQUAL(5, size);
+    TEST_ASSERT_EQUAL_UINT8(MESSAGE_TYPE_INPUT_VALUE_EXTENDED, buffer[0]);
+    TEST_ASSERT_EQUAL_UINT8(0x13, buffer[1]); // input_id byte 0 (LE)
+    TEST_ASSERT_EQUAL_UINT8(0x03, buffer[2]); // input_id byte 1 (LE)
+    TEST_ASSERT_EQUAL_UINT8(0xFE, buffer[3]); // value byte 0 (LE)
+    TEST_ASSERT_EQUAL_UINT8(0xFF, buffer[4]); // value byte 1 (LE)
+}
+
+void test_input_value_extended_roundtrip()
+{
+    InputValueExtended original;
+    original.input_id = 0x1234;
+    original.value = 1;
+
+    uint8_t buffer[16];
+    size_t size = original.encode(buffer, sizeof(buffer));
+
+    InputValueExtended decoded;
+    TEST_ASSERT_TRUE(decoded.decode(buffer, size));
+    TEST_ASSERT_EQUAL_UINT16(original.input_id, decoded.input_id);
+    TEST_ASSERT_EQUAL(original.value, decoded.value);
+
+    TEST_ASSERT_FALSE(decoded.decode(buffer, size - 1));
+}
+
+void test_input_resolution_roundtrip()
+{
+    InputResolution original;
+    original.pin = 14;
+    original.bits = 12;
+
+    uint8_t buffer[16];
+    size_t size = original.encode(buffer, sizeof(buffer));
+
+    TEST_ASSERT_EQUAL(3, size);
+    TEST_ASSERT_EQUAL_UINT8(MESSAGE_TYPE_INPUT_RESOLUTION, buffer[0]);
+
+    Message msg;
+    TEST_ASSERT_TRUE(msg.decode(buffer, size));
+    TEST_ASSERT_TRUE(msg.isInputResolution());
+    TEST_ASSERT_EQUAL_UINT8(14, msg.input_resolution.pin);
+    TEST_ASSERT_EQUAL_UINT8(12, msg.input_resolution.bits);
+
+    TEST_ASSERT_FALSE(msg.decode(buffer, size - 1));
+}
+
+void test_calibrate_noise_roundtrip()
+{
+    CalibrateNoise original;
+    original.scans = 300;
+
+    uint8_t buffer[16];
+    size_t size = original.encode(buffer, sizeof(buffer));
+
+    TEST_ASSERT_EQUAL(3, size);
+    TEST_ASSERT_EQUAL_UINT8(MESSAGE_TYPE_CALIBRATE_NOISE, buffer[0]);
+    TEST_ASSERT_EQUAL_UINT8(0x2C, buffer[1]);
+    TEST_ASSERT_EQUAL_UINT8(0x01, buffer[2]);
+
+    Message msg;
+    TEST_ASSERT_TRUE(msg.decode(buffer, size));
+    TEST_ASSERT_TRUE(msg.isCalibrateNoise());
+    TEST_ASSERT_EQUAL_UINT16(300, msg.calibrate_noise.scans);
+
+    TEST_ASSERT_FALSE(msg.decode(buffer, size - 1));
+
+    // An empty window is rejected
+    buffer[1] = 0;
+    buffer[2] = 0;
+    TEST_ASSERT_FALSE(msg.decode(buffer, size));
+}
+
+void test_noise_stats_roundtrip()
+{
+    NoiseStats original;
+    original.pin = 14;
+    original.samples = 300;
+    original.min_value = 1020;
+    original.max_value = 1027;
+    original.dead_zone = 7;
+
+    uint8_t buffer[16];
+    size_t size = original.encode(buffer, sizeof(buffer));
+
+    TEST_ASSERT_EQUAL(9, size);
+    TEST_ASSERT_EQUAL_UINT8(MESSAGE_TYPE_NOISE_STATS, buffer[0]);
+
+    Message msg;
+    TEST_ASSERT_TRUE(msg.decode(buffer, size));
+    TEST_ASSERT_TRUE(msg.isNoiseStats());
+    TEST_ASSERT_EQUAL_UINT8(14, msg.noise_stats.pin);
+    TEST_ASSERT_EQUAL_UINT16(300, msg.noise_stats.samples);
+    TEST_ASSERT_EQUAL_UINT16(1020, msg.noise_stats.min_value);
+    TEST_ASSERT_EQUAL_UINT16(1027, msg.noise_stats.max_value);
+    TEST_ASSERT_EQUAL_UINT8(7, msg.noise_stats.dead_zone);
+
+    TEST_ASSERT_FALSE(msg.decode(buffer, size - 1));
+    TEST_ASSERT_EQUAL(0, original.encode(buffer, 8));
+}
+
+void test_message_decode_input_value_extended()
+{
+    uint8_t buffer[] = { MESSAGE_TYPE_INPUT_VALUE_EXTENDED, 0x00, 0x01, 0x01, 0x00 };
+
+    Message msg;
+    TEST_ASSERT_TRUE(msg.decode(buffer, sizeof(buffer)));
+    TEST_ASSERT_TRUE(msg.isInputValueExtended());
+    TEST_ASSERT_EQUAL_UINT16(256, msg.input_value_extended.input_id);
+    TEST_ASSERT_EQUAL(1, msg.input_value_extended.value);
+}
+
 // Main test runner
 void setUp(void)
 {
@@ -752,20 +1407,46 @@ int main(int argc, char** argv)
     RUN_TEST(test_configure_decode);
     RUN_TEST(test_configure_decode_insufficient_data);
     RUN_TEST(test_configure_roundtrip);
+    RUN_TEST(test_configure_analog_oversample_roundtrip);
+    RUN_TEST(test_configure_analog_oversample_invalid);
+    RUN_TEST(test_configure_analog_filter_roundtrip);
+    RUN_TEST(test_configure_analog_filter_invalid);
+    RUN_TEST(test_configure_analog_one_euro_roundtrip);
+    RUN_TEST(test_configure_analog_median_roundtrip);
+    RUN_TEST(test_configure_analog_dead_zone_roundtrip);
+    RUN_TEST(test_configure_analog_hysteresis_roundtrip);
+    RUN_TEST(test_configure_analog_intervals_roundtrip);
 
     // Configure tests (Button)
     RUN_TEST(test_configure_button_encode);
     RUN_TEST(test_configure_button_decode);
     RUN_TEST(test_configure_button_roundtrip);
+    RUN_TEST(test_configure_button_flags_roundtrip);
 
     // Configure tests (Matrix)
     RUN_TEST(test_configure_matrix_encode);
     RUN_TEST(test_configure_matrix_decode);
     RUN_TEST(test_configure_matrix_roundtrip);
+    RUN_TEST(test_configure_matrix_flags_roundtrip);
     RUN_TEST(test_configure_matrix_decode_insufficient_data);
     RUN_TEST(test_configure_matrix_decode_too_many_pins);
     RUN_TEST(test_configure_decode_unknown_type);
 
+    // Configure tests (Shift Register)
+    RUN_TEST(test_configure_shift_register_roundtrip);
+    RUN_TEST(test_configure_shift_register_decode_invalid_length);
+
+    // Configure tests (I2C Expander)
+    RUN_TEST(test_configure_expander_roundtrip);
+
+    // Configure tests (Analog Mux)
+    RUN_TEST(test_configure_analog_mux_roundtrip);
+    RUN_TEST(test_configure_analog_notch_roundtrip);
+    RUN_TEST(test_configure_resistor_ladder_roundtrip);
+    RUN_TEST(test_configure_encoder_roundtrip);
+    RUN_TEST(test_configure_button_group_roundtrip);
+    RUN_TEST(test_configure_button_group_debounce);
+
     // ConfigurationStored tests
     RUN_TEST(test_configuration_stored_encode);
     RUN_TEST(test_configuration_stored_decode);
@@ -782,6 +1463,13 @@ int main(int argc, char** argv)
     RUN_TEST(test_set_output_roundtrip);
     RUN_TEST(test_set_output_decode_insufficient_data);
 
+    // InputValueExtended tests
+    RUN_TEST(test_input_value_extended_encode);
+    RUN_TEST(test_input_value_extended_roundtrip);
+    RUN_TEST(test_input_resolution_roundtrip);
+    RUN_TEST(test_calibrate_noise_roundtrip);
+    RUN_TEST(test_noise_stats_roundtrip);
+
     // Message union tests
     RUN_TEST(test_message_decode_identity_request);
     RUN_TEST(test_message_decode_identity_response);
@@ -791,6 +1479,7 @@ int main(int argc, char** argv)
     RUN_TEST(test_message_decode_configuration_stored);
     RUN_TEST(test_message_decode_configuration_error);
     RUN_TEST(test_message_decode_set_output);
+    RUN_TEST(test_message_decode_input_value_extended);
     RUN_TEST(test_message_decode_invalid_type);
 
     // Error handling tests
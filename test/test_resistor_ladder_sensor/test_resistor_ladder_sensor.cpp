@@ -0,0 +1,175 @@
+// Mock Arduino environment for native testing
+#include <stdint.h>
+
+// Arduino pin definitions
+#define INPUT 0
+#define OUTPUT 1
+#define A0 14
+
+// Mock Arduino functions
+static uint16_t g_mock_analog_value = 1023; // Nothing pressed (pulled up)
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    (void)pin;
+    (void)mode;
+}
+int analogRead(uint8_t pin)
+{
+    (void)pin;
+    return g_mock_analog_value;
+}
+
+// Now include the sensor code (include .cpp directly since we provide mocks above)
+#include "../../src/sensor.h"
+#include "../../src/adc_engine.cpp"
+#include "../../src/resistor_ladder_sensor.cpp"
+#include <unity.h>
+
+using namespace Sensor;
+
+static constexpr uint16_t ID_BASE = 256;
+
+// 4 buttons: ~0, ~250, ~500, ~750 when pressed, 1023 released
+static const uint16_t THRESHOLDS[4] = { 125, 375, 625, 875 };
+
+// Helper to run scans at a value
+void scanAt(ResistorLadderSensor& sensor, uint16_t value, int scans)
+{
+    g_mock_analog_value = value;
+    for (int i = 0; i < scans; i++) {
+        sensor.scan();
+    }
+}
+
+// Test initialization
+void test_ladder_sensor_init()
+{
+    ResistorLadderSensor sensor(A0, 3, 4, THRESHOLDS, ID_BASE);
+
+    TEST_ASSERT_EQUAL(InputType::ResistorLadder, sensor.getType());
+    TEST_ASSERT_EQUAL(A0, sensor.getPin());
+}
+
+// Test value to button decoding
+void test_ladder_sensor_decode()
+{
+    ResistorLadderSensor sensor(A0, 3, 4, THRESHOLDS, ID_BASE);
+
+    TEST_ASSERT_EQUAL(0, sensor.decode(0));
+    TEST_ASSERT_EQUAL(1, sensor.decode(250));
+    TEST_ASSERT_EQUAL(2, sensor.decode(500));
+    TEST_ASSERT_EQUAL(3, sensor.decode(874));
+    TEST_ASSERT_EQUAL(4, sensor.decode(875)); // None
+    TEST_ASSERT_EQUAL(4, sensor.decode(1023));
+}
+
+// Test nothing is reported while released
+void test_ladder_sensor_no_reading_initially()
+{
+    ResistorLadderSensor sensor(A0, 3, 4, THRESHOLDS, ID_BASE);
+    sensor.begin();
+
+    scanAt(sensor, 1023, 10);
+    TEST_ASSERT_FALSE(sensor.getReading().has_value);
+}
+
+// Test press and release with debounce
+void test_ladder_sensor_press_release()
+{
+    ResistorLadderSensor sensor(A0, 3, 4, THRESHOLDS, ID_BASE);
+    sensor.begin();
+
+    scanAt(sensor, 500, 2);
+    TEST_ASSERT_FALSE(sensor.getReading().has_value);
+    scanAt(sensor, 500, 1);
+
+    Reading press = sensor.getReading();
+    TEST_ASSERT_TRUE(press.has_value);
+    TEST_ASSERT_EQUAL(1, press.value);
+    TEST_ASSERT_EQUAL(ID_BASE + 2, press.pin);
+    TEST_ASSERT_EQUAL(InputType::ResistorLadder, press.type);
+    TEST_ASSERT_FALSE(sensor.getReading().has_value);
+
+    // Held - no repeats
+    scanAt(sensor, 505, 20);
+    TEST_ASSERT_FALSE(sensor.getReading().has_value);
+
+    scanAt(sensor, 1023, 3);
+    Reading release = sensor.getReading();
+    TEST_ASSERT_TRUE(release.has_value);
+    TEST_ASSERT_EQUAL(0, release.value);
+    TEST_ASSERT_EQUAL(ID_BASE + 2, release.pin);
+}
+
+// Test the value passing through other bands while settling registers nothing else
+void test_ladder_sensor_debounces_in_value_domain()
+{
+    ResistorLadderSensor sensor(A0, 3, 4, THRESHOLDS, ID_BASE);
+    sensor.begin();
+
+    // Falling edge sweeps through buttons 3 and 2 before settling on 1
+    scanAt(sensor, 760, 1);
+    scanAt(sensor, 480, 2);
+    scanAt(sensor, 250, 3);
+
+    Reading press = sensor.getReading();
+    TEST_ASSERT_TRUE(press.has_value);
+    TEST_ASSERT_EQUAL(ID_BASE + 1, press.pin);
+    TEST_ASSERT_FALSE(sensor.getReading().has_value);
+
+    // A glitch back to "released" is filtered
+    scanAt(sensor, 1023, 2);
+    scanAt(sensor, 250, 5);
+    TEST_ASSERT_FALSE(sensor.getReading().has_value);
+}
+
+// Test moving straight from one button to another reports release and press
+void test_ladder_sensor_button_change()
+{
+    ResistorLadderSensor sensor(A0, 3, 4, THRESHOLDS, ID_BASE);
+    sensor.begin();
+
+    scanAt(sensor, 0, 3);
+    sensor.getReading(); // Press of button 0
+
+    scanAt(sensor, 750, 3);
+    Reading first = sensor.getReading();
+    Reading second = sensor.getReading();
+    TEST_ASSERT_TRUE(first.has_value);
+    TEST_ASSERT_TRUE(second.has_value);
+    TEST_ASSERT_EQUAL(ID_BASE + 0, first.pin);
+    TEST_ASSERT_EQUAL(0, first.value);
+    TEST_ASSERT_EQUAL(ID_BASE + 3, second.pin);
+    TEST_ASSERT_EQUAL(1, second.value);
+}
+
+// Test zero debounce (immediate response, like ButtonSensor)
+void test_ladder_sensor_zero_debounce()
+{
+    ResistorLadderSensor sensor(A0, 0, 4, THRESHOLDS, ID_BASE);
+    sensor.begin();
+
+    scanAt(sensor, 250, 1);
+    Reading press = sensor.getReading();
+    TEST_ASSERT_TRUE(press.has_value);
+    TEST_ASSERT_EQUAL(ID_BASE + 1, press.pin);
+}
+
+void setUp(void) { g_mock_analog_value = 1023; }
+void tearDown(void) {}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_ladder_sensor_init);
+    RUN_TEST(test_ladder_sensor_decode);
+    RUN_TEST(test_ladder_sensor_no_reading_initially);
+    RUN_TEST(test_ladder_sensor_press_release);
+    RUN_TEST(test_ladder_sensor_debounces_in_value_domain);
+    RUN_TEST(test_ladder_sensor_button_change);
+    RUN_TEST(test_ladder_sensor_zero_debounce);
+
+    return UNITY_END();
+}
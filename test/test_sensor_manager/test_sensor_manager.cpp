@@ -0,0 +1,684 @@
+// Mock Arduino environment for native testing
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+
+// Arduino pin definitions
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define LOW 0
+#define HIGH 1
+#define CHANGE 1
+#define NOT_AN_INTERRUPT -1
+
+#include "../EEPROM.h"
+#include "../SPI.h"
+#include "../Wire.h"
+
+// Count every heap allocation made after setup
+static int g_heap_allocations = 0;
+
+void* operator new(size_t size)
+{
+    g_heap_allocations++;
+    void* ptr = malloc(size ? size : 1);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept { free(ptr); }
+void operator delete[](void* ptr) noexcept { free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { free(ptr); }
+
+// Mock hardware: buttons released, analog inputs at mid-scale
+static int g_pin_level[64];
+static int g_analog_value = 512;
+static unsigned long g_micros = 0;
+static void (*g_isr[64])(void);
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    (void)pin;
+    (void)mode;
+}
+
+int digitalRead(uint8_t pin) { return g_pin_level[pin]; }
+void digitalWrite(uint8_t pin, uint8_t val) { (void)pin; (void)val; }
+int analogRead(uint8_t pin)
+{
+    (void)pin;
+    return g_analog_value;
+}
+void delayMicroseconds(unsigned int us) { (void)us; }
+unsigned long micros() { return g_micros += 100; }
+unsigned long millis() { return g_micros / 1000; }
+
+int digitalPinToInterrupt(uint8_t pin) { return pin < 4 ? pin : NOT_AN_INTERRUPT; }
+void attachInterrupt(uint8_t interrupt, void (*isr)(void), int mode)
+{
+    (void)mode;
+    g_isr[interrupt] = isr;
+}
+void detachInterrupt(uint8_t interrupt) { g_isr[interrupt] = nullptr; }
+void noInterrupts() { }
+void interrupts() { }
+
+SPIClass SPI;
+void SPIClass::begin() { }
+void SPIClass::beginTransaction(SPISettings settings) { (void)settings; }
+void SPIClass::endTransaction() { }
+uint8_t SPIClass::transfer(uint8_t data) { return (uint8_t)~data; }
+
+MockWireWrite mock_wire_log[MOCK_WIRE_LOG_SIZE];
+size_t mock_wire_log_count = 0;
+uint16_t mock_wire_port[128];
+bool mock_wire_present[128];
+size_t mock_wire_read_count = 0;
+TwoWire Wire;
+
+uint8_t mock_eeprom_storage[1024];
+EEPROMClass EEPROM;
+
+// Now include the sensor manager and every sensor it can create
+#include "../../src/adc_engine.cpp"
+#include "../../src/analog_sensor.cpp"
+#include "../../src/button_group_sensor.cpp"
+#include "../../src/button_sensor.cpp"
+#include "../../src/config_manager.cpp"
+#include "../../src/encoder_sensor.cpp"
+#include "../../src/i2c_expander_sensor.cpp"
+#include "../../src/matrix_sensor.cpp"
+#include "../../src/mux_analog_sensor.cpp"
+#include "../../src/notch_sensor.cpp"
+#include "../../src/resistor_ladder_sensor.cpp"
+#include "../../src/sensor_manager.cpp"
+#include "../../src/shift_register_sensor.cpp"
+#include <unity.h>
+
+// Configuration with one input of most types
+static uint8_t buildMixedConfig(ConfigManager::InputConfig* inputs)
+{
+    inputs[0].input_type = Protocol::INPUT_TYPE_ANALOG;
+    inputs[0].analog.pin = 14;
+    inputs[0].analog.sensitivity = 5;
+
+    inputs[1].input_type = Protocol::INPUT_TYPE_BUTTON;
+    inputs[1].button.pin = 2;
+    inputs[1].button.debounce = 3;
+    inputs[1].button.flags = Protocol::BUTTON_FLAG_INTERRUPT;
+
+    inputs[2].input_type = Protocol::INPUT_TYPE_MATRIX;
+    inputs[2].matrix.num_row_pins = 2;
+    inputs[2].matrix.num_col_pins = 2;
+    inputs[2].matrix.pins[0] = 20;
+    inputs[2].matrix.pins[1] = 21;
+    inputs[2].matrix.pins[2] = 22;
+    inputs[2].matrix.pins[3] = 23;
+
+    inputs[3].input_type = Protocol::INPUT_TYPE_ENCODER;
+    inputs[3].encoder.pin_a = 0;
+    inputs[3].encoder.pin_b = 1;
+    inputs[3].encoder.steps_per_detent = 4;
+    inputs[3].encoder.sensitivity = 5;
+
+    inputs[4].input_type = Protocol::INPUT_TYPE_ANALOG_MUX;
+    inputs[4].analog_mux.adc_pin = 15;
+    inputs[4].analog_mux.sensitivity = 5;
+    inputs[4].analog_mux.num_channels = 16;
+    inputs[4].analog_mux.settle_us = 5;
+    for (uint8_t i = 0; i < Protocol::MUX_SELECT_PINS; i++) {
+        inputs[4].analog_mux.select_pins[i] = (uint8_t)(30 + i);
+    }
+
+    inputs[5].input_type = Protocol::INPUT_TYPE_SHIFT_REGISTER;
+    inputs[5].shift_register.latch_pin = 10;
+    inputs[5].shift_register.num_registers = 4;
+
+    inputs[6].input_type = Protocol::INPUT_TYPE_BUTTON_GROUP;
+    inputs[6].button_group.num_pins = 3;
+    inputs[6].button_group.pins[0] = 40;
+    inputs[6].button_group.pins[1] = 41;
+    inputs[6].button_group.pins[2] = 42;
+    inputs[6].button_group.debounce = 0;
+
+    return 7;
+}
+
+// Pack inputs into an image
+static ConfigManager::ConfigImage pack(const ConfigManager::InputConfig* inputs, uint8_t count)
+{
+    ConfigManager::ConfigImage image;
+    for (uint8_t i = 0; i < count; i++) {
+        TEST_ASSERT_TRUE(image.append(inputs[i]));
+    }
+    return image;
+}
+
+// Run the main loop's sensor work for a number of ticks
+static int runTicks(int ticks)
+{
+    int readings = 0;
+    for (int t = 0; t < ticks; t++) {
+        SensorManager::scan();
+        Sensor::Reading reading;
+        while (SensorManager::getNextReading(reading)) {
+            readings++;
+        }
+    }
+    return readings;
+}
+
+// Test sensors are created without touching the heap
+void test_sensor_manager_apply_uses_no_heap()
+{
+    ConfigManager::InputConfig inputs[SensorManager::MAX_SENSORS];
+    uint8_t count = buildMixedConfig(inputs);
+
+    SensorManager::init();
+    g_heap_allocations = 0;
+
+    TEST_ASSERT_TRUE(SensorManager::applyConfiguration(pack(inputs, count)));
+    TEST_ASSERT_EQUAL_UINT8(count, SensorManager::getSensorCount());
+    TEST_ASSERT_GREATER_THAN(0, (int)SensorManager::getArenaUsage());
+    TEST_ASSERT_EQUAL(0, g_heap_allocations);
+}
+
+// Test the running loop and repeated reconfiguration never allocate
+void test_sensor_manager_no_heap_after_setup()
+{
+    ConfigManager::InputConfig inputs[SensorManager::MAX_SENSORS];
+    uint8_t count = buildMixedConfig(inputs);
+
+    // setup()
+    SensorManager::init();
+    ConfigManager::ConfigImage built = pack(inputs, count);
+    SensorManager::applyConfiguration(built);
+    g_heap_allocations = 0;
+
+    // loop(), including reconfigurations from the host (the way the message
+    // handler applies them)
+    for (int round = 0; round < 5; round++) {
+        g_pin_level[2] = (round & 1) ? HIGH : LOW;
+        if (g_isr[2]) {
+            g_isr[2]();
+        }
+        g_analog_value = 300 + 100 * round;
+        runTicks(50);
+
+        inputs[0].analog.pin = (uint8_t)(14 + (round & 1));
+        ConfigManager::ConfigImage next = pack(inputs, (uint8_t)(count - (round % 3)));
+        TEST_ASSERT_TRUE(SensorManager::updateConfiguration(next, built));
+        built = next;
+    }
+
+    TEST_ASSERT_EQUAL(0, g_heap_allocations);
+}
+
+// Test teardown runs destructors (interrupts are released for reuse)
+void test_sensor_manager_teardown_releases_interrupts()
+{
+    ConfigManager::InputConfig inputs[SensorManager::MAX_SENSORS];
+    uint8_t count = buildMixedConfig(inputs);
+
+    SensorManager::init();
+    SensorManager::applyConfiguration(pack(inputs, count));
+    TEST_ASSERT_NOT_NULL(g_isr[0]); // Encoder
+    TEST_ASSERT_NOT_NULL(g_isr[2]); // Interrupt button
+
+    SensorManager::applyConfiguration(pack(inputs, 1));
+    TEST_ASSERT_NULL(g_isr[0]);
+    TEST_ASSERT_NULL(g_isr[2]);
+    TEST_ASSERT_EQUAL_UINT8(1, SensorManager::getSensorCount());
+}
+
+// Test the arena aligns objects and refuses them once full
+void test_arena_create_until_full()
+{
+    struct Pair {
+        uint8_t tag;
+        uint32_t value;
+        Pair(uint8_t t, uint32_t v)
+            : tag(t)
+            , value(v)
+        {
+        }
+    };
+
+    Sensor::Arena<2 * Sensor::arenaBlockSize(sizeof(Pair))> arena;
+    Pair* a = arena.create<Pair>((uint8_t)1, (uint32_t)100);
+    Pair* b = arena.create<Pair>((uint8_t)2, (uint32_t)200);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_EQUAL(0, (int)((uintptr_t)b % alignof(Pair)));
+    TEST_ASSERT_EQUAL(100, (int)a->value);
+    TEST_ASSERT_EQUAL(2, b->tag);
+    TEST_ASSERT_NULL(arena.create<Pair>((uint8_t)3, (uint32_t)300));
+
+    arena.reset();
+    TEST_ASSERT_EQUAL(0, (int)arena.bytesUsed());
+    TEST_ASSERT_TRUE(arena.create<Pair>((uint8_t)4, (uint32_t)400) == a);
+}
+
+// Test freed blocks are reused (split and merged) and a free tail is given back
+void test_arena_reuses_released_blocks()
+{
+    struct Small {
+        uint8_t bytes[8];
+    };
+    struct Large {
+        uint8_t bytes[40];
+    };
+    const size_t small = Sensor::arenaBlockSize(sizeof(Small));
+
+    Sensor::Arena<4 * Sensor::arenaBlockSize(sizeof(Large))> arena;
+    Small* a = arena.create<Small>();
+    Small* b = arena.create<Small>();
+    Small* c = arena.create<Small>();
+    TEST_ASSERT_EQUAL((int)(3 * small), (int)arena.bytesUsed());
+
+    // A freed block in the middle is reused by the next object that fits
+    arena.release(b);
+    TEST_ASSERT_EQUAL((int)(3 * small), (int)arena.bytesUsed());
+    TEST_ASSERT_TRUE(arena.create<Small>() == b);
+
+    // Neighbouring freed blocks merge into one a larger object can take
+    arena.release(a);
+    arena.release(b);
+    if (Sensor::arenaBlockSize(sizeof(Large)) <= 2 * small) {
+        TEST_ASSERT_TRUE((void*)arena.create<Large>() == (void*)a);
+    } else {
+        TEST_ASSERT_TRUE((void*)arena.create<Large>() > (void*)c);
+    }
+
+    // Freeing the last block gives the space back, along with free blocks before it
+    size_t usage = arena.bytesUsed();
+    Small* d = arena.create<Small>();
+    arena.release(d);
+    TEST_ASSERT_EQUAL((int)usage, (int)arena.bytesUsed());
+}
+
+// Test MAX_SENSORS analog inputs fit off-AVR, and a rejected configuration leaves
+// the running sensors alone
+void test_sensor_manager_rejects_config_over_arena()
+{
+    ConfigManager::InputConfig inputs[SensorManager::MAX_SENSORS];
+    buildMixedConfig(inputs);
+    ConfigManager::InputConfig analog = inputs[0];
+    ConfigManager::InputConfig mux = inputs[4]; // Largest sensor
+
+    SensorManager::init();
+
+    // Default arena holds a full set of analog inputs off-AVR
+    for (uint8_t i = 0; i < SensorManager::MAX_SENSORS; i++) {
+        inputs[i] = analog;
+        inputs[i].analog.pin = i;
+    }
+    TEST_ASSERT_TRUE(SensorManager::applyConfiguration(pack(inputs, SensorManager::MAX_SENSORS)));
+    TEST_ASSERT_EQUAL_UINT8(SensorManager::MAX_SENSORS, SensorManager::getSensorCount());
+    TEST_ASSERT_TRUE(SensorManager::getArenaUsage() <= SensorManager::ARENA_SIZE);
+
+    // A full set of the largest sensor doesn't fit, and the analog inputs keep running
+    size_t usage = SensorManager::getArenaUsage();
+    for (uint8_t i = 0; i < SensorManager::MAX_SENSORS; i++) {
+        inputs[i] = mux;
+    }
+    TEST_ASSERT_FALSE(SensorManager::applyConfiguration(pack(inputs, SensorManager::MAX_SENSORS)));
+    TEST_ASSERT_EQUAL_UINT8(SensorManager::MAX_SENSORS, SensorManager::getSensorCount());
+    TEST_ASSERT_EQUAL(usage, SensorManager::getArenaUsage());
+    TEST_ASSERT_NOT_NULL(SensorManager::findAnalogSensor(0));
+}
+
+// Test an update that doesn't fit is rejected before any running sensor is destroyed
+void test_sensor_manager_update_rejects_config_over_arena()
+{
+    ConfigManager::InputConfig inputs[SensorManager::MAX_SENSORS];
+    buildMixedConfig(inputs);
+    ConfigManager::InputConfig mux = inputs[4];
+    ConfigManager::InputConfig button = inputs[1];
+    button.button.flags = 0;
+    button.button.debounce = 1;
+    button.button.pin = 5;
+    inputs[1] = button;
+    ConfigManager::ConfigImage built = pack(inputs, 2);
+
+    SensorManager::init();
+    TEST_ASSERT_TRUE(SensorManager::applyConfiguration(built));
+    size_t usage = SensorManager::getArenaUsage();
+
+    // Keep both inputs, add more muxes than the arena holds
+    for (uint8_t i = 2; i < SensorManager::MAX_SENSORS; i++) {
+        inputs[i] = mux;
+    }
+    TEST_ASSERT_FALSE(SensorManager::updateConfiguration(pack(inputs, SensorManager::MAX_SENSORS), built));
+    TEST_ASSERT_EQUAL_UINT8(2, SensorManager::getSensorCount());
+    TEST_ASSERT_EQUAL(usage, SensorManager::getArenaUsage());
+
+    // The old set keeps scanning: the button still reports a press
+    g_pin_level[5] = LOW;
+    bool pressed = false;
+    for (int tick = 0; tick < 5; tick++) {
+        SensorManager::scan();
+        Sensor::Reading reading;
+        while (SensorManager::getNextReading(reading)) {
+            pressed = pressed || (reading.type == Sensor::InputType::Button && reading.pin == 5);
+        }
+    }
+    TEST_ASSERT_TRUE(pressed);
+
+    // And it still updates incrementally against the configuration it was built from
+    inputs[0].analog.dead_zone = 40;
+    TEST_ASSERT_TRUE(SensorManager::updateConfiguration(pack(inputs, 2), built));
+    TEST_ASSERT_EQUAL(usage, SensorManager::getArenaUsage());
+}
+
+// Test the small AVR boards' arena holds an analog input on every analog pin,
+// or a button on every input
+void test_sensor_manager_small_board_budget()
+{
+    ConfigManager::InputConfig inputs[SensorManager::MAX_SENSORS];
+    buildMixedConfig(inputs);
+    ConfigManager::InputConfig analog = inputs[0];
+    analog.analog.oversample = Protocol::MAX_OVERSAMPLE_BITS;
+    analog.analog.median = Protocol::ANALOG_MEDIAN_5;
+    analog.analog.filter = Protocol::ANALOG_FILTER_ONE_EURO;
+    ConfigManager::InputConfig button = inputs[1];
+    const uint8_t small_board_inputs = 16;
+
+    SensorManager::init();
+
+    for (uint8_t i = 0; i < SensorManager::SMALL_BOARD_ANALOG_INPUTS; i++) {
+        inputs[i] = analog;
+        inputs[i].analog.pin = (uint8_t)(14 + i);
+    }
+    TEST_ASSERT_TRUE(SensorManager::applyConfiguration(pack(inputs, SensorManager::SMALL_BOARD_ANALOG_INPUTS)));
+    TEST_ASSERT_EQUAL_UINT8(SensorManager::SMALL_BOARD_ANALOG_INPUTS, SensorManager::getSensorCount());
+    TEST_ASSERT_TRUE(SensorManager::getArenaUsage() <= SensorManager::smallArenaSize(small_board_inputs));
+
+    for (uint8_t i = 0; i < small_board_inputs; i++) {
+        inputs[i] = button;
+        inputs[i].button.pin = (uint8_t)(4 + i);
+    }
+    TEST_ASSERT_TRUE(SensorManager::applyConfiguration(pack(inputs, small_board_inputs)));
+    TEST_ASSERT_EQUAL_UINT8(small_board_inputs, SensorManager::getSensorCount());
+    TEST_ASSERT_TRUE(SensorManager::getArenaUsage() <= SensorManager::smallArenaSize(small_board_inputs));
+}
+
+// Test draining visits flagged sensors round-robin, one reading each per pass
+void test_sensor_manager_drains_flagged_round_robin()
+{
+    ConfigManager::InputConfig inputs[SensorManager::MAX_SENSORS];
+    buildMixedConfig(inputs);
+    inputs[0] = inputs[2]; // 2x2 matrix (rows 20-21, cols 22-23)
+    inputs[1].button.pin = 5;
+    inputs[1].button.debounce = 1;
+    inputs[1].button.flags = 0;
+    inputs[2] = inputs[1];
+    inputs[2].button.pin = 6;
+
+    SensorManager::init();
+    TEST_ASSERT_TRUE(SensorManager::applyConfiguration(pack(inputs, 3)));
+
+    // Column 22 pulled low presses both keys in it; button 5 pressed, button 6 idle
+    g_pin_level[22] = LOW;
+    g_pin_level[5] = LOW;
+    for (int i = 0; i < 10; i++) {
+        SensorManager::scan();
+    }
+
+    // Sensors are grouped by type, so button 5 comes first, then the matrix keys
+    Sensor::Reading reading;
+    TEST_ASSERT_TRUE(SensorManager::getNextReading(reading));
+    TEST_ASSERT_EQUAL(Sensor::InputType::Button, reading.type);
+    TEST_ASSERT_EQUAL_UINT16(5, reading.pin);
+    TEST_ASSERT_TRUE(SensorManager::getNextReading(reading));
+    TEST_ASSERT_EQUAL(Sensor::InputType::Matrix, reading.type);
+    TEST_ASSERT_TRUE(SensorManager::getNextReading(reading));
+    TEST_ASSERT_EQUAL(Sensor::InputType::Matrix, reading.type);
+    TEST_ASSERT_FALSE(SensorManager::getNextReading(reading));
+
+    // A new edge after the drain is flagged by the next scan
+    g_pin_level[6] = LOW;
+    TEST_ASSERT_FALSE(SensorManager::getNextReading(reading));
+    SensorManager::scan();
+    TEST_ASSERT_TRUE(SensorManager::getNextReading(reading));
+    TEST_ASSERT_EQUAL_UINT16(6, reading.pin);
+    TEST_ASSERT_FALSE(SensorManager::getNextReading(reading));
+}
+
+// Test draining reaches a flagged sensor past empty groups of 8 slots
+void test_sensor_manager_drains_sparse_flags()
+{
+    ConfigManager::InputConfig inputs[SensorManager::MAX_SENSORS];
+    buildMixedConfig(inputs);
+    ConfigManager::InputConfig button = inputs[1];
+    button.button.debounce = 1;
+    button.button.flags = 0;
+
+    const uint8_t count = 21;
+    for (uint8_t i = 0; i < count; i++) {
+        inputs[i] = button;
+        inputs[i].button.pin = (uint8_t)(4 + i);
+    }
+
+    SensorManager::init();
+    TEST_ASSERT_TRUE(SensorManager::applyConfiguration(pack(inputs, count)));
+
+    // Slots 1 and 20: the drain must wrap through the empty group in between
+    g_pin_level[5] = LOW;
+    g_pin_level[24] = LOW;
+    SensorManager::scan();
+
+    Sensor::Reading reading;
+    TEST_ASSERT_TRUE(SensorManager::getNextReading(reading));
+    TEST_ASSERT_EQUAL_UINT16(5, reading.pin);
+    TEST_ASSERT_TRUE(SensorManager::getNextReading(reading));
+    TEST_ASSERT_EQUAL_UINT16(24, reading.pin);
+    TEST_ASSERT_FALSE(SensorManager::getNextReading(reading));
+
+    // Starting past slot 20 wraps round to slot 1
+    g_pin_level[5] = HIGH;
+    SensorManager::scan();
+    TEST_ASSERT_TRUE(SensorManager::getNextReading(reading));
+    TEST_ASSERT_EQUAL_UINT16(5, reading.pin);
+    TEST_ASSERT_EQUAL(0, reading.value);
+    TEST_ASSERT_FALSE(SensorManager::getNextReading(reading));
+}
+
+// Test quiet ticks report nothing and reconfiguration drops stale flags
+void test_sensor_manager_quiet_tick_reports_nothing()
+{
+    ConfigManager::InputConfig inputs[SensorManager::MAX_SENSORS];
+    uint8_t count = buildMixedConfig(inputs);
+
+    SensorManager::init();
+    SensorManager::applyConfiguration(pack(inputs, count));
+
+    // Settle: initial analog sends, then nothing changes
+    runTicks(100);
+    TEST_ASSERT_EQUAL(0, runTicks(10));
+
+    // Pending events that were never drained don't survive a reconfiguration
+    g_pin_level[40] = LOW;
+    for (int i = 0; i < 10; i++) {
+        SensorManager::scan();
+    }
+    SensorManager::applyConfiguration(pack(inputs + 1, 1));
+    Sensor::Reading reading;
+    TEST_ASSERT_FALSE(SensorManager::getNextReading(reading));
+}
+
+// Test reconfiguring keeps the state of sensors whose input didn't change
+void test_sensor_manager_update_keeps_unchanged_sensors()
+{
+    ConfigManager::InputConfig inputs[SensorManager::MAX_SENSORS];
+    buildMixedConfig(inputs);
+    ConfigManager::InputConfig analog = inputs[0];
+    ConfigManager::InputConfig button = inputs[1];
+    button.button.debounce = 1;
+    button.button.flags = 0;
+
+    inputs[0] = button;
+    inputs[0].button.pin = 5;
+    inputs[1] = button;
+    inputs[1].button.pin = 6;
+    ConfigManager::ConfigImage old_image = pack(inputs, 2);
+
+    SensorManager::init();
+    TEST_ASSERT_TRUE(SensorManager::applyConfiguration(old_image));
+
+    // Button 5 pressed and debounced, but not drained yet
+    g_pin_level[5] = LOW;
+    for (int i = 0; i < 10; i++) {
+        SensorManager::scan();
+    }
+
+    // Button 6 removed, an analog input added in front of button 5
+    inputs[1] = inputs[0];
+    inputs[0] = analog;
+    TEST_ASSERT_TRUE(SensorManager::updateConfiguration(pack(inputs, 2), old_image));
+    TEST_ASSERT_EQUAL_UINT8(2, SensorManager::getSensorCount());
+
+    // The pending press survived
+    Sensor::Reading reading;
+    TEST_ASSERT_TRUE(SensorManager::getNextReading(reading));
+    TEST_ASSERT_EQUAL(Sensor::InputType::Button, reading.type);
+    TEST_ASSERT_EQUAL_UINT16(5, reading.pin);
+    TEST_ASSERT_EQUAL(1, reading.value);
+}
+
+// Test only changed inputs get new sensors, and a dead zone change is applied in place
+void test_sensor_manager_update_rebuilds_changed_inputs()
+{
+    ConfigManager::InputConfig inputs[SensorManager::MAX_SENSORS];
+    buildMixedConfig(inputs);
+    inputs[1] = inputs[5]; // Shift register at index 1
+    inputs[2].input_type = Protocol::INPUT_TYPE_BUTTON;
+    inputs[2].button.pin = 5;
+    inputs[2].button.debounce = 3;
+    ConfigManager::ConfigImage old_image = pack(inputs, 3);
+
+    SensorManager::init();
+    TEST_ASSERT_TRUE(SensorManager::applyConfiguration(old_image));
+    size_t usage = SensorManager::getArenaUsage();
+
+    // New dead zone: the analog sensor is retuned, nothing is created
+    inputs[0].analog.dead_zone = 40;
+    ConfigManager::ConfigImage retuned = pack(inputs, 3);
+    TEST_ASSERT_TRUE(SensorManager::updateConfiguration(retuned, old_image));
+    TEST_ASSERT_EQUAL(usage, SensorManager::getArenaUsage());
+    TEST_ASSERT_EQUAL_UINT8(3, SensorManager::getSensorCount());
+    TEST_ASSERT_NOT_NULL(SensorManager::findAnalogSensor(14));
+
+    // New debounce: the button is rebuilt in the space of the old one
+    inputs[2].button.debounce = 5;
+    ConfigManager::ConfigImage debounced = pack(inputs, 3);
+    TEST_ASSERT_TRUE(SensorManager::updateConfiguration(debounced, retuned));
+    TEST_ASSERT_EQUAL(usage, SensorManager::getArenaUsage());
+    TEST_ASSERT_EQUAL_UINT8(3, SensorManager::getSensorCount());
+
+    // The shift register's input IDs come from its index, so moving it rebuilds
+    // it (the removed button's space is given back)
+    ConfigManager::InputConfig moved[2] = { inputs[1], inputs[0] };
+    TEST_ASSERT_TRUE(SensorManager::updateConfiguration(pack(moved, 2), debounced));
+    TEST_ASSERT_TRUE(SensorManager::getArenaUsage() < usage);
+    TEST_ASSERT_EQUAL_UINT8(2, SensorManager::getSensorCount());
+
+    // Against a configuration the sensors weren't built from it's a full rebuild
+    TEST_ASSERT_TRUE(SensorManager::updateConfiguration(pack(inputs, 1), old_image));
+    TEST_ASSERT_EQUAL_UINT8(1, SensorManager::getSensorCount());
+    usage = SensorManager::getArenaUsage();
+    SensorManager::applyConfiguration(pack(inputs, 1));
+    TEST_ASSERT_EQUAL(usage, SensorManager::getArenaUsage());
+
+    // Even when it has the same shape (the buffer was overwritten by a later configuration)
+    inputs[0].analog.pin = 15;
+    ConfigManager::ConfigImage overwritten = pack(inputs, 1);
+    TEST_ASSERT_TRUE(SensorManager::updateConfiguration(pack(inputs, 1), overwritten));
+    TEST_ASSERT_NOT_NULL(SensorManager::findAnalogSensor(15));
+    TEST_ASSERT_NULL(SensorManager::findAnalogSensor(14));
+}
+
+// Test repeated edits of one input reuse its space and keep every other sensor
+void test_sensor_manager_update_reuses_freed_space()
+{
+    ConfigManager::InputConfig inputs[SensorManager::MAX_SENSORS];
+    uint8_t count = buildMixedConfig(inputs);
+    inputs[1].button.flags = 0;
+    inputs[1].button.debounce = 1;
+    inputs[1].button.pin = 5;
+
+    SensorManager::init();
+    ConfigManager::ConfigImage built = pack(inputs, count);
+    TEST_ASSERT_TRUE(SensorManager::applyConfiguration(built));
+    size_t usage = SensorManager::getArenaUsage();
+    Sensor::AnalogSensor* analog = SensorManager::findAnalogSensor(14);
+
+    // Button 5 pressed and debounced, but not drained yet
+    g_pin_level[5] = LOW;
+    for (int i = 0; i < 5; i++) {
+        SensorManager::scan();
+    }
+
+    // Change the mux in the middle of the arena over and over
+    for (uint8_t round = 0; round < 20; round++) {
+        inputs[4].analog_mux.settle_us = (uint8_t)(10 + round);
+        ConfigManager::ConfigImage next = pack(inputs, count);
+        TEST_ASSERT_TRUE(SensorManager::updateConfiguration(next, built));
+        built = next;
+
+        TEST_ASSERT_EQUAL(usage, SensorManager::getArenaUsage());
+        TEST_ASSERT_EQUAL_UINT8(count, SensorManager::getSensorCount());
+        TEST_ASSERT_TRUE(SensorManager::findAnalogSensor(14) == analog);
+    }
+
+    // The button kept its pending press through every rebuild
+    bool pressed = false;
+    Sensor::Reading reading;
+    while (SensorManager::getNextReading(reading)) {
+        pressed = pressed || (reading.type == Sensor::InputType::Button && reading.pin == 5);
+    }
+    TEST_ASSERT_TRUE(pressed);
+}
+
+void setUp(void)
+{
+    for (int i = 0; i < 64; i++) {
+        g_pin_level[i] = HIGH;
+        g_isr[i] = nullptr;
+    }
+    g_analog_value = 512;
+    g_micros = 0;
+}
+void tearDown(void) {}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_sensor_manager_apply_uses_no_heap);
+    RUN_TEST(test_sensor_manager_no_heap_after_setup);
+    RUN_TEST(test_sensor_manager_teardown_releases_interrupts);
+    RUN_TEST(test_arena_create_until_full);
+    RUN_TEST(test_arena_reuses_released_blocks);
+    RUN_TEST(test_sensor_manager_rejects_config_over_arena);
+    RUN_TEST(test_sensor_manager_update_rejects_config_over_arena);
+    RUN_TEST(test_sensor_manager_small_board_budget);
+    RUN_TEST(test_sensor_manager_drains_flagged_round_robin);
+    RUN_TEST(test_sensor_manager_drains_sparse_flags);
+    RUN_TEST(test_sensor_manager_quiet_tick_reports_nothing);
+    RUN_TEST(test_sensor_manager_update_keeps_unchanged_sensors);
+    RUN_TEST(test_sensor_manager_update_rebuilds_changed_inputs);
+    RUN_TEST(test_sensor_manager_update_reuses_freed_space);
+
+    return UNITY_END();
+}
@@ -0,0 +1,232 @@
+// Mock Arduino environment for native testing
+#include <stdint.h>
+#include <string.h>
+
+// Arduino pin definitions
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define LOW 0
+#define HIGH 1
+
+#include "../SPI.h"
+
+// Mock shift register chain: parallel inputs of each register (bit set = pressed)
+static uint8_t g_register_inputs[32];
+static uint8_t g_shift_buffer[32]; // Contents latched into the chain
+static uint8_t g_shift_position = 0;
+static uint8_t g_latch_state = HIGH;
+static int g_transfer_count = 0;
+
+SPIClass SPI;
+
+void SPIClass::begin() { }
+void SPIClass::beginTransaction(SPISettings settings) { (void)settings; }
+void SPIClass::endTransaction() { }
+
+uint8_t SPIClass::transfer(uint8_t data)
+{
+    (void)data;
+    g_transfer_count++;
+    // Inputs are active LOW on the wire
+    return (uint8_t)~g_shift_buffer[g_shift_position++ % 32];
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    (void)pin;
+    (void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+    (void)pin;
+    // SH/LD low loads the parallel inputs and restarts shifting
+    if (val == LOW && g_latch_state == HIGH) {
+        memcpy(g_shift_buffer, g_register_inputs, sizeof(g_shift_buffer));
+        g_shift_position = 0;
+    }
+    g_latch_state = val;
+}
+
+// Now include the sensor code
+#include "../../src/sensor.h"
+#include "../../src/shift_register_sensor.cpp"
+#include <unity.h>
+
+using namespace Sensor;
+
+static constexpr uint16_t ID_BASE = 256;
+
+// Helper to reset mock state
+void resetMockState()
+{
+    memset(g_register_inputs, 0, sizeof(g_register_inputs));
+    memset(g_shift_buffer, 0, sizeof(g_shift_buffer));
+    g_shift_position = 0;
+    g_latch_state = HIGH;
+    g_transfer_count = 0;
+}
+
+// Helper to press an input by chain index
+void pressInput(uint16_t index)
+{
+    g_register_inputs[index / 8] |= (1 << (index % 8));
+}
+
+// Helper to release an input by chain index
+void releaseInput(uint16_t index)
+{
+    g_register_inputs[index / 8] &= ~(1 << (index % 8));
+}
+
+// Test vertical counter debouncer commits after DEBOUNCE_SAMPLES samples
+void test_vertical_debouncer_threshold()
+{
+    VerticalDebouncer d;
+
+    TEST_ASSERT_EQUAL_UINT8(0x00, d.update(0x05));
+    TEST_ASSERT_EQUAL_UINT8(0x00, d.update(0x05));
+    TEST_ASSERT_EQUAL_UINT8(0x05, d.update(0x05));
+    TEST_ASSERT_EQUAL_UINT8(0x05, d.getState());
+
+    // Held inputs don't toggle again
+    TEST_ASSERT_EQUAL_UINT8(0x00, d.update(0x05));
+}
+
+// Test vertical counter debouncer filters glitches per bit
+void test_vertical_debouncer_glitch()
+{
+    VerticalDebouncer d;
+
+    d.update(0x01);
+    d.update(0x01);
+    d.update(0x00); // Glitch ends before the threshold - counter restarts
+    d.update(0x01);
+    TEST_ASSERT_EQUAL_UINT8(0x00, d.update(0x01));
+    TEST_ASSERT_EQUAL_UINT8(0x01, d.update(0x01));
+}
+
+// Test initialization
+void test_shift_register_sensor_init()
+{
+    ShiftRegisterSensor sensor(10, 4, ID_BASE);
+
+    TEST_ASSERT_EQUAL(InputType::ShiftRegister, sensor.getType());
+    TEST_ASSERT_EQUAL(10, sensor.getPin());
+}
+
+// Test one SPI transfer per register per scan
+void test_shift_register_sensor_reads_whole_chain()
+{
+    ShiftRegisterSensor sensor(10, 32, ID_BASE);
+    sensor.begin();
+
+    sensor.scan();
+
+    TEST_ASSERT_EQUAL(32, g_transfer_count);
+}
+
+// Test press detection with debounce and extended input ID
+void test_shift_register_sensor_press_detection()
+{
+    ShiftRegisterSensor sensor(10, 4, ID_BASE);
+    sensor.begin();
+
+    pressInput(19); // Register 2, input D
+
+    sensor.scan();
+    sensor.scan();
+    TEST_ASSERT_FALSE(sensor.getReading().has_value);
+
+    sensor.scan();
+
+    Reading r = sensor.getReading();
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(1, r.value);
+    TEST_ASSERT_EQUAL(InputType::ShiftRegister, r.type);
+    TEST_ASSERT_EQUAL(ID_BASE + 19, r.pin);
+
+    TEST_ASSERT_FALSE(sensor.getReading().has_value);
+}
+
+// Test release detection
+void test_shift_register_sensor_release_detection()
+{
+    ShiftRegisterSensor sensor(10, 2, ID_BASE);
+    sensor.begin();
+
+    pressInput(3);
+    for (int i = 0; i < 3; i++) sensor.scan();
+    sensor.getReading(); // Consume press
+
+    releaseInput(3);
+    for (int i = 0; i < 3; i++) sensor.scan();
+
+    Reading r = sensor.getReading();
+    TEST_ASSERT_TRUE(r.has_value);
+    TEST_ASSERT_EQUAL(0, r.value);
+    TEST_ASSERT_EQUAL(ID_BASE + 3, r.pin);
+}
+
+// Test that simultaneous changes across the full chain are all reported
+void test_shift_register_sensor_no_lost_events()
+{
+    ShiftRegisterSensor sensor(10, 32, ID_BASE);
+    sensor.begin();
+
+    for (uint16_t i = 0; i < 256; i++) {
+        pressInput(i);
+    }
+    for (int i = 0; i < 3; i++) sensor.scan();
+
+    bool seen[256];
+    memset(seen, 0, sizeof(seen));
+    int count = 0;
+    while (true) {
+        Reading r = sensor.getReading();
+        if (!r.has_value) break;
+        TEST_ASSERT_EQUAL(1, r.value);
+        seen[r.pin - ID_BASE] = true;
+        count++;
+        if (count > 300) break; // Safety limit
+    }
+
+    TEST_ASSERT_EQUAL(256, count);
+    for (uint16_t i = 0; i < 256; i++) {
+        TEST_ASSERT_TRUE(seen[i]);
+    }
+}
+
+// Test held input doesn't repeat
+void test_shift_register_sensor_no_repeat_while_held()
+{
+    ShiftRegisterSensor sensor(10, 1, ID_BASE);
+    sensor.begin();
+
+    pressInput(0);
+    for (int i = 0; i < 3; i++) sensor.scan();
+    TEST_ASSERT_TRUE(sensor.getReading().has_value);
+
+    for (int i = 0; i < 20; i++) sensor.scan();
+    TEST_ASSERT_FALSE(sensor.getReading().has_value);
+}
+
+void setUp(void) { resetMockState(); }
+void tearDown(void) {}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_vertical_debouncer_threshold);
+    RUN_TEST(test_vertical_debouncer_glitch);
+    RUN_TEST(test_shift_register_sensor_init);
+    RUN_TEST(test_shift_register_sensor_reads_whole_chain);
+    RUN_TEST(test_shift_register_sensor_press_detection);
+    RUN_TEST(test_shift_register_sensor_release_detection);
+    RUN_TEST(test_shift_register_sensor_no_lost_events);
+    RUN_TEST(test_shift_register_sensor_no_repeat_while_held);
+
+    return UNITY_END();
+}